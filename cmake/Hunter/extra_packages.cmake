@@ -22,3 +22,4 @@ hunter_add_package(CLI11)
 hunter_add_package(gRPC)
 hunter_add_package(OpenSSL)
 hunter_add_package(Protobuf)
+hunter_add_package(Snappy)
@@ -172,6 +172,7 @@ void parse_silkworm_command_line(CLI::App& cli, int argc, char* argv[], Silkworm
     std::string chaindata_page_size_str{human_size(node_settings.chaindata_env_config.page_size)};
     std::string batch_size_str{human_size(node_settings.batch_size)};
     std::string etl_buffer_size_str{human_size(node_settings.etl_buffer_size)};
+    std::string execution_memory_budget_str;
     add_option_data_dir(cli, data_dir_path);
 
     cli.add_flag("--chaindata.exclusive", node_settings.chaindata_env_config.exclusive,
@@ -191,7 +192,7 @@ void parse_silkworm_command_line(CLI::App& cli, int argc, char* argv[], Silkworm
         ->capture_default_str()
         ->check(HumanSizeParserValidator("32MB", {"128TB"}));
 
-    cli.add_option("--batchsize", batch_size_str, "Batch size for stage execution")
+    cli.add_option("--batchsize", batch_size_str, "Batch size for Senders, LogIndex and HistoryIndex stages (Execution uses --execution.memory.budget)")
         ->capture_default_str()
         ->check(HumanSizeParserValidator("64MB", {"16GB"}));
     cli.add_option("--etl.buffersize", etl_buffer_size_str, "Buffer size for ETL operations")
@@ -215,6 +216,14 @@ void parse_silkworm_command_line(CLI::App& cli, int argc, char* argv[], Silkworm
         ->capture_default_str()
         ->check(CLI::Range(10u, 600u));
 
+    cli.add_option("--execution.workers", node_settings.execution_workers,
+                   "Sets the number of threads executing the transactions of a block in parallel (0 = sequential)")
+        ->capture_default_str()
+        ->check(CLI::Range(0u, 256u));
+    cli.add_option("--execution.memory.budget", execution_memory_budget_str,
+                   "Sets the memory a batch of stage execution can take (default a quarter of physical memory)")
+        ->check(HumanSizeParserValidator("64MB"));
+
     cli.add_flag("--fakepow", node_settings.fake_pow, "Disables proof-of-work verification");
 
     // Chain options
@@ -300,6 +309,9 @@ void parse_silkworm_command_line(CLI::App& cli, int argc, char* argv[], Silkworm
 
     node_settings.batch_size = parse_size(batch_size_str).value();
     node_settings.etl_buffer_size = parse_size(etl_buffer_size_str).value();
+    if (!execution_memory_budget_str.empty()) {
+        node_settings.execution_memory_budget = parse_size(execution_memory_budget_str).value();
+    }
 
     // Parse prune mode
     db::PruneDistance olderHistory, olderReceipts, olderSenders, olderTxIndex, olderCallTraces;
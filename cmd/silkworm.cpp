@@ -14,6 +14,7 @@
    limitations under the License.
 */
 
+#include <memory>
 #include <stdexcept>
 
 #include <CLI/CLI.hpp>
@@ -25,6 +26,7 @@
 #include <silkworm/node/common/settings.hpp>
 #include <silkworm/node/common/stopwatch.hpp>
 #include <silkworm/node/concurrency/signal_handler.hpp>
+#include <silkworm/node/db/access_layer.hpp>
 #include <silkworm/node/db/stages.hpp>
 #include <silkworm/node/snapshot/sync.hpp>
 #include <silkworm/node/stagedsync/execution_engine.hpp>
@@ -146,12 +148,16 @@ int main(int argc, char* argv[]) {
         BlockExchange block_exchange{sentry, db::ROAccess{chaindata_db}, node_settings.chain_config.value()};
         auto block_downloading = std::thread([&block_exchange]() { block_exchange.execution_loop(); });
 
+        // Snapshot sync - download chain from peers using snapshot files
+        std::unique_ptr<SnapshotSync> snapshot_sync;
         if (snapshot_settings.enabled) {
             db::RWTxn rw_txn{chaindata_db};
 
-            // Snapshot sync - download chain from peers using snapshot files
-            SnapshotSync snapshot_sync{snapshot_settings, node_settings.chain_config.value()};
-            snapshot_sync.download_and_index_snapshots(rw_txn);
+            snapshot_sync = std::make_unique<SnapshotSync>(snapshot_settings, node_settings.chain_config.value());
+            snapshot_sync->download_and_index_snapshots(rw_txn);
+
+            // Frozen blocks are read from snapshots from now on
+            db::DataModel::set_snapshot_repository(&snapshot_sync->repository());
         } else {
             log::Info() << "Snapshot sync disabled, no snapshot must be downloaded";
         }
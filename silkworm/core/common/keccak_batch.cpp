@@ -0,0 +1,294 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "keccak_batch.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <vector>
+
+#include <silkworm/core/common/assert.hpp>
+#include <silkworm/core/common/endian.hpp>
+
+// Multi-versioned functions get an AVX2 clone selected at load time (needs ifunc support)
+#if defined(__x86_64__) && defined(__ELF__) && defined(__GNUC__)
+#define SILKWORM_KECCAK_TARGET_CLONES __attribute__((target_clones("avx2", "default")))
+#else
+#define SILKWORM_KECCAK_TARGET_CLONES
+#endif
+
+namespace silkworm {
+
+namespace {
+
+    constexpr size_t kRate{136};  // Bytes absorbed per block by Keccak-256
+
+    constexpr std::array<uint64_t, 24> kRoundConstants{
+        0x0000000000000001,
+        0x0000000000008082,
+        0x800000000000808a,
+        0x8000000080008000,
+        0x000000000000808b,
+        0x0000000080000001,
+        0x8000000080008081,
+        0x8000000000008009,
+        0x000000000000008a,
+        0x0000000000000088,
+        0x0000000080008009,
+        0x000000008000000a,
+        0x000000008000808b,
+        0x800000000000008b,
+        0x8000000000008089,
+        0x8000000000008003,
+        0x8000000000008002,
+        0x8000000000000080,
+        0x000000000000800a,
+        0x800000008000000a,
+        0x8000000080008081,
+        0x8000000000008080,
+        0x0000000080000001,
+        0x8000000080008008,
+    };
+
+    // Rotation offsets of rho step indexed by x + 5 * y
+    constexpr std::array<unsigned, 25> kRotations{
+        0,
+        1,
+        62,
+        28,
+        27,
+        36,
+        44,
+        6,
+        55,
+        20,
+        3,
+        10,
+        43,
+        25,
+        39,
+        41,
+        45,
+        15,
+        21,
+        8,
+        18,
+        2,
+        61,
+        56,
+        14,
+    };
+
+    // Destination of pi step indexed by x + 5 * y: y + 5 * ((2 * x + 3 * y) % 5)
+    constexpr std::array<size_t, 25> kPiDestinations{
+        0,
+        10,
+        20,
+        5,
+        15,
+        16,
+        1,
+        11,
+        21,
+        6,
+        7,
+        17,
+        2,
+        12,
+        22,
+        23,
+        8,
+        18,
+        3,
+        13,
+        14,
+        24,
+        9,
+        19,
+        4,
+    };
+
+    // Each lane of the state holds the same word of kKeccakBatchLanes independent states
+#if defined(__GNUC__)
+    using Lane = uint64_t __attribute__((vector_size(kKeccakBatchLanes * sizeof(uint64_t))));
+#else
+    struct Lane {
+        uint64_t words[kKeccakBatchLanes]{};
+        uint64_t& operator[](size_t k) { return words[k]; }
+        uint64_t operator[](size_t k) const { return words[k]; }
+#define SILKWORM_LANE_OPERATOR(op)                          \
+    friend Lane operator op(const Lane& a, const Lane& b) { \
+        Lane r;                                             \
+        for (size_t k{0}; k < kKeccakBatchLanes; ++k) {     \
+            r.words[k] = a.words[k] op b.words[k];          \
+        }                                                   \
+        return r;                                           \
+    }
+        SILKWORM_LANE_OPERATOR(^)
+        SILKWORM_LANE_OPERATOR(&)
+        SILKWORM_LANE_OPERATOR(|)
+#undef SILKWORM_LANE_OPERATOR
+        Lane& operator^=(const Lane& other) { return *this = *this ^ other; }
+        friend Lane operator~(const Lane& a) {
+            Lane r;
+            for (size_t k{0}; k < kKeccakBatchLanes; ++k) {
+                r.words[k] = ~a.words[k];
+            }
+            return r;
+        }
+        friend Lane operator<<(const Lane& a, unsigned n) {
+            Lane r;
+            for (size_t k{0}; k < kKeccakBatchLanes; ++k) {
+                r.words[k] = a.words[k] << n;
+            }
+            return r;
+        }
+        friend Lane operator>>(const Lane& a, unsigned n) {
+            Lane r;
+            for (size_t k{0}; k < kKeccakBatchLanes; ++k) {
+                r.words[k] = a.words[k] >> n;
+            }
+            return r;
+        }
+    };
+#endif
+    using State = std::array<Lane, 25>;
+
+    // A macro rather than a function as passing vectors by value would depend on the enabled instruction sets
+#define SILKWORM_KECCAK_ROTL(x, n) (((x) << (n)) | ((x) >> (64 - (n))))  // n in [1, 63]
+
+    SILKWORM_KECCAK_TARGET_CLONES void keccak_f1600(State& a) {
+        for (const uint64_t round_constant : kRoundConstants) {
+            // Theta
+            Lane c[5];
+            for (size_t x{0}; x < 5; ++x) {
+                c[x] = a[x] ^ a[x + 5] ^ a[x + 10] ^ a[x + 15] ^ a[x + 20];
+            }
+            const Lane d[5]{
+                c[4] ^ SILKWORM_KECCAK_ROTL(c[1], 1),
+                c[0] ^ SILKWORM_KECCAK_ROTL(c[2], 1),
+                c[1] ^ SILKWORM_KECCAK_ROTL(c[3], 1),
+                c[2] ^ SILKWORM_KECCAK_ROTL(c[4], 1),
+                c[3] ^ SILKWORM_KECCAK_ROTL(c[0], 1),
+            };
+            for (size_t i{0}; i < 25; ++i) {
+                a[i] ^= d[i % 5];
+            }
+
+            // Rho and Pi
+            Lane b[25];
+            b[0] = a[0];
+            for (size_t i{1}; i < 25; ++i) {
+                b[kPiDestinations[i]] = SILKWORM_KECCAK_ROTL(a[i], kRotations[i]);
+            }
+
+            // Chi
+            for (size_t y{0}; y < 25; y += 5) {
+                a[y + 0] = b[y + 0] ^ (~b[y + 1] & b[y + 2]);
+                a[y + 1] = b[y + 1] ^ (~b[y + 2] & b[y + 3]);
+                a[y + 2] = b[y + 2] ^ (~b[y + 3] & b[y + 4]);
+                a[y + 3] = b[y + 3] ^ (~b[y + 4] & b[y + 0]);
+                a[y + 4] = b[y + 4] ^ (~b[y + 0] & b[y + 1]);
+            }
+
+            // Iota
+            for (size_t k{0}; k < kKeccakBatchLanes; ++k) {
+                a[0][k] ^= round_constant;
+            }
+        }
+    }
+
+#undef SILKWORM_KECCAK_ROTL
+
+    size_t blocks_count(ByteView message) { return message.size() / kRate + 1; }  // Padding takes at least 1 byte
+
+    //! \brief Hashes in lockstep messages spanning the same number of blocks (unused lanes are hashed in vain)
+    void keccak256_lanes(const std::array<ByteView, kKeccakBatchLanes>& messages, size_t used_lanes,
+                         std::array<ethash::hash256*, kKeccakBatchLanes>& digests) {
+        State state;
+        for (auto& lane : state) {
+            lane = Lane{};
+        }
+        const size_t blocks{blocks_count(messages[0])};
+        uint8_t last_block[kRate];
+        for (size_t block{0}; block < blocks; ++block) {
+            for (size_t k{0}; k < used_lanes; ++k) {
+                const uint8_t* data{messages[k].data() + block * kRate};
+                if (block + 1 == blocks) {
+                    // Keccak padding (not the SHA-3 one)
+                    const size_t size{messages[k].size() - block * kRate};
+                    std::memset(last_block, 0, kRate);
+                    if (size) {
+                        std::memcpy(last_block, data, size);
+                    }
+                    last_block[size] ^= 0x01;
+                    last_block[kRate - 1] ^= 0x80;
+                    data = last_block;
+                }
+                for (size_t i{0}; i < kRate / sizeof(uint64_t); ++i) {
+                    state[i][k] ^= endian::load_little_u64(data + i * sizeof(uint64_t));
+                }
+            }
+            keccak_f1600(state);
+        }
+        for (size_t k{0}; k < used_lanes; ++k) {
+            for (size_t i{0}; i < 4; ++i) {
+                intx::le::unsafe::store(&digests[k]->bytes[i * sizeof(uint64_t)], state[i][k]);
+            }
+        }
+    }
+
+}  // namespace
+
+void keccak256_batch(std::span<const ByteView> messages, std::span<ethash::hash256> digests) {
+    SILKWORM_ASSERT(messages.size() == digests.size());
+
+    // Group messages by number of blocks
+    std::vector<size_t> order(messages.size());
+    for (size_t i{0}; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&messages](size_t a, size_t b) {
+        return blocks_count(messages[a]) < blocks_count(messages[b]);
+    });
+
+    std::array<ByteView, kKeccakBatchLanes> lanes;
+    std::array<ethash::hash256*, kKeccakBatchLanes> lane_digests{};
+    size_t used_lanes{0};
+    auto flush_lanes{[&]() {
+        if (used_lanes == 1) {
+            *lane_digests[0] = ethash::keccak256(lanes[0].data(), lanes[0].size());
+        } else if (used_lanes > 1) {
+            keccak256_lanes(lanes, used_lanes, lane_digests);
+        }
+        used_lanes = 0;
+    }};
+
+    for (const size_t i : order) {
+        if (used_lanes && blocks_count(lanes[0]) != blocks_count(messages[i])) {
+            flush_lanes();
+        }
+        lanes[used_lanes] = messages[i];
+        lane_digests[used_lanes] = &digests[i];
+        if (++used_lanes == kKeccakBatchLanes) {
+            flush_lanes();
+        }
+    }
+    flush_lanes();
+}
+
+}  // namespace silkworm
@@ -0,0 +1,39 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <span>
+
+#include <ethash/keccak.hpp>
+
+#include <silkworm/core/common/base.hpp>
+
+namespace silkworm {
+
+//! \brief Number of messages hashed in lockstep by keccak256_batch
+inline constexpr size_t kKeccakBatchLanes{4};
+
+//! \brief Computes the Keccak-256 digests of independent messages
+//! \details Messages are hashed kKeccakBatchLanes at a time by a multi-buffer Keccak-f[1600] working on
+//! interleaved states, so that each step of the permutation maps onto SIMD instructions (AVX2 when available).
+//! Messages spanning the same number of blocks are grouped together to not waste lanes: a message left with no
+//! companions is hashed by ethash::keccak256
+//! \param [in] messages : the messages to be hashed
+//! \param [out] digests : the digest of each message (same size of messages)
+void keccak256_batch(std::span<const ByteView> messages, std::span<ethash::hash256> digests);
+
+}  // namespace silkworm
@@ -0,0 +1,78 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "keccak_batch.hpp"
+
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/core/common/cast.hpp>
+#include <silkworm/core/common/util.hpp>
+
+namespace silkworm {
+
+static Bytes sample_message(size_t length, uint8_t seed) {
+    Bytes message(length, 0);
+    for (size_t i{0}; i < length; ++i) {
+        message[i] = static_cast<uint8_t>(seed + i * 7);
+    }
+    return message;
+}
+
+static void check_batch(const std::vector<Bytes>& messages) {
+    std::vector<ByteView> views(messages.begin(), messages.end());
+    std::vector<ethash::hash256> digests(messages.size());
+    keccak256_batch(views, digests);
+    for (size_t i{0}; i < messages.size(); ++i) {
+        CHECK(to_hex(digests[i].bytes) == to_hex(keccak256(messages[i]).bytes));
+    }
+}
+
+TEST_CASE("Keccak batch - known digests") {
+    const std::vector<Bytes> messages{Bytes{}, Bytes{string_view_to_byte_view("abc")}, Bytes{}, Bytes{}};
+    std::vector<ByteView> views(messages.begin(), messages.end());
+    std::vector<ethash::hash256> digests(messages.size());
+    keccak256_batch(views, digests);
+    CHECK(to_hex(digests[0].bytes) == "c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470");
+    CHECK(to_hex(digests[1].bytes) == "4e03657aea45a94fc7d47ba826c8d667c0d1e6e33a64a036ec44f58fa12d6c45");
+    CHECK(to_hex(digests[3].bytes) == to_hex(digests[0].bytes));
+}
+
+TEST_CASE("Keccak batch - same length") {
+    // Lengths around the block boundary (136 bytes) and its multiples
+    for (const size_t length : {0, 1, 31, 32, 33, 135, 136, 137, 271, 272, 532}) {
+        for (size_t count{1}; count <= 2 * kKeccakBatchLanes + 1; ++count) {
+            std::vector<Bytes> messages;
+            for (size_t i{0}; i < count; ++i) {
+                messages.push_back(sample_message(length, static_cast<uint8_t>(i)));
+            }
+            check_batch(messages);
+        }
+    }
+}
+
+TEST_CASE("Keccak batch - mixed lengths") {
+    std::vector<Bytes> messages;
+    for (size_t i{0}; i < 50; ++i) {
+        messages.push_back(sample_message((i * 37) % 600, static_cast<uint8_t>(i)));
+    }
+    check_batch(messages);
+
+    check_batch({});
+}
+
+}  // namespace silkworm
@@ -18,8 +18,85 @@
 
 #include <memory>
 
+#ifndef __wasm__
+#define SILKWORM_DETAIL_ANALYSIS_CACHE_GUARD(shard) std::unique_lock lock{(shard).mutex};
+#else
+#define SILKWORM_DETAIL_ANALYSIS_CACHE_GUARD(shard)
+#endif
+
 namespace silkworm {
 
+BaselineAnalysisCache& BaselineAnalysisCache::shared() {
+    static BaselineAnalysisCache instance;
+    return instance;
+}
+
+std::shared_ptr<evmone::baseline::CodeAnalysis> BaselineAnalysisCache::get(const evmc::bytes32& key) noexcept {
+    Shard& shard{shard_of(key)};
+    SILKWORM_DETAIL_ANALYSIS_CACHE_GUARD(shard)
+    const auto it{shard.index.find(key)};
+    if (it == shard.index.end()) {
+        return nullptr;
+    }
+    shard.items.splice(shard.items.begin(), shard.items, it->second);
+    return it->second->analysis;
+}
+
+void BaselineAnalysisCache::put(const evmc::bytes32& key,
+                                const std::shared_ptr<evmone::baseline::CodeAnalysis>& analysis,
+                                size_t code_size) {
+    // Analysis holds a padded copy of the code plus a bitmap of its jump destinations
+    const size_t bytes{sizeof(Item) + sizeof(evmone::baseline::CodeAnalysis) + code_size + code_size / 8 + 64};
+
+    Shard& shard{shard_of(key)};
+    SILKWORM_DETAIL_ANALYSIS_CACHE_GUARD(shard)
+    if (const auto it{shard.index.find(key)}; it != shard.index.end()) {
+        // Another thread may have analyzed the same code meanwhile
+        shard.items.splice(shard.items.begin(), shard.items, it->second);
+        return;
+    }
+    // Allocate both the list node and the index entry before linking, so that a failed allocation leaves no trace
+    std::list<Item> node{{key, analysis, bytes}};
+    shard.index.emplace(key, node.begin());
+    shard.items.splice(shard.items.begin(), node);
+    shard.bytes += bytes;
+
+    // Keep at least the newest entry regardless of its size
+    while (shard.bytes > max_shard_bytes_ && shard.items.size() > 1) {
+        const Item& last{shard.items.back()};
+        shard.bytes -= last.bytes;
+        shard.index.erase(last.key);
+        shard.items.pop_back();
+    }
+}
+
+size_t BaselineAnalysisCache::size() const noexcept {
+    size_t size{0};
+    for (const auto& shard : shards_) {
+        SILKWORM_DETAIL_ANALYSIS_CACHE_GUARD(shard)
+        size += shard.items.size();
+    }
+    return size;
+}
+
+size_t BaselineAnalysisCache::bytes() const noexcept {
+    size_t bytes{0};
+    for (const auto& shard : shards_) {
+        SILKWORM_DETAIL_ANALYSIS_CACHE_GUARD(shard)
+        bytes += shard.bytes;
+    }
+    return bytes;
+}
+
+void BaselineAnalysisCache::clear() noexcept {
+    for (auto& shard : shards_) {
+        SILKWORM_DETAIL_ANALYSIS_CACHE_GUARD(shard)
+        shard.index.clear();
+        shard.items.clear();
+        shard.bytes = 0;
+    }
+}
+
 std::shared_ptr<evmone::advanced::AdvancedCodeAnalysis> AdvancedAnalysisCache::get(const evmc::bytes32& key,
                                                                                    evmc_revision revision) noexcept {
     if (revision_ == revision) {
@@ -16,7 +16,14 @@
 
 #pragma once
 
+#include <array>
+#include <list>
 #include <memory>
+#include <unordered_map>
+
+#ifndef __wasm__
+#include <mutex>
+#endif
 
 #include <evmone/advanced_analysis.hpp>
 #include <evmone/baseline.hpp>
@@ -26,8 +33,67 @@
 
 namespace silkworm {
 
-// Cache of EVM baseline analyses.
-using BaselineAnalysisCache = lru_cache<evmc::bytes32, std::shared_ptr<evmone::baseline::CodeAnalysis>>;
+/** @brief Cache of EVM baseline analyses safe to be shared among threads.
+ *
+ * Analyses are keyed by code hash and spread over shards, each one guarded by its own mutex and evicting its least
+ * recently used entries so that the memory taken by the analyses stays within its share of the budget.
+ * A process-wide instance is provided by shared() so that analyses of hot contracts outlive a single execution batch.
+ */
+class BaselineAnalysisCache {
+  public:
+    static constexpr size_t kDefaultMaxBytes{256_Mebi};
+
+    explicit BaselineAnalysisCache(size_t max_bytes = kDefaultMaxBytes) : max_shard_bytes_{max_bytes / kShards} {}
+
+    // Not copyable nor movable
+    BaselineAnalysisCache(const BaselineAnalysisCache&) = delete;
+    BaselineAnalysisCache& operator=(const BaselineAnalysisCache&) = delete;
+
+    //! \brief Returns the process-wide instance
+    static BaselineAnalysisCache& shared();
+
+    /** @brief Gets an EVM analysis from the cache.
+     * A nullptr is returned if there's nothing in the cache for this key.
+     */
+    std::shared_ptr<evmone::baseline::CodeAnalysis> get(const evmc::bytes32& key) noexcept;
+
+    /** @brief Puts an EVM analysis into the cache.
+     * Least recently used analyses are evicted if the memory budget gets exceeded.
+     * @param code_size The size of the analyzed code, which the memory taken by the analysis is estimated from
+     * @throws std::bad_alloc if the new entry cannot be allocated
+     */
+    void put(const evmc::bytes32& key, const std::shared_ptr<evmone::baseline::CodeAnalysis>& analysis,
+             size_t code_size);
+
+    [[nodiscard]] size_t size() const noexcept;
+    [[nodiscard]] size_t bytes() const noexcept;  // Estimated memory taken by the cached analyses
+
+    void clear() noexcept;
+
+  private:
+    static constexpr size_t kShards{16};
+
+    struct Item {
+        evmc::bytes32 key;
+        std::shared_ptr<evmone::baseline::CodeAnalysis> analysis;
+        size_t bytes{0};
+    };
+
+    struct Shard {
+        std::list<Item> items;  // Most recently used first
+        std::unordered_map<evmc::bytes32, std::list<Item>::iterator> index;
+        size_t bytes{0};
+#ifndef __wasm__
+        mutable std::mutex mutex;
+#endif
+    };
+
+    // Code hashes are evenly distributed hence their first byte is enough to pick a shard
+    Shard& shard_of(const evmc::bytes32& key) noexcept { return shards_[key.bytes[0] % kShards]; }
+
+    std::array<Shard, kShards> shards_;
+    size_t max_shard_bytes_;
+};
 
 /** @brief Cache of EVM advanced analyses.
  *
@@ -0,0 +1,75 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "analysis_cache.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/core/common/endian.hpp>
+#include <silkworm/core/common/util.hpp>
+
+namespace silkworm {
+
+static std::shared_ptr<evmone::baseline::CodeAnalysis> analyze(ByteView code) {
+    return std::make_shared<evmone::baseline::CodeAnalysis>(evmone::baseline::analyze(EVMC_LONDON, code));
+}
+
+static evmc::bytes32 key_of(uint64_t i) {
+    evmc::bytes32 key{};
+    endian::store_big_u64(&key.bytes[24], i);
+    key.bytes[0] = static_cast<uint8_t>(i);  // Spread keys over shards
+    return key;
+}
+
+TEST_CASE("Baseline analysis cache") {
+    const Bytes code(1'000, 0x5b);  // JUMPDESTs
+    const auto analysis{analyze(code)};
+
+    SECTION("get and put") {
+        BaselineAnalysisCache cache;
+        CHECK(cache.get(key_of(1)) == nullptr);
+        cache.put(key_of(1), analysis, code.size());
+        CHECK(cache.get(key_of(1)) == analysis);
+        CHECK(cache.size() == 1);
+        CHECK(cache.bytes() >= code.size());
+
+        // Existing analysis is kept
+        cache.put(key_of(1), analyze(code), code.size());
+        CHECK(cache.get(key_of(1)) == analysis);
+        CHECK(cache.size() == 1);
+
+        cache.clear();
+        CHECK(cache.get(key_of(1)) == nullptr);
+        CHECK(cache.size() == 0);
+        CHECK(cache.bytes() == 0);
+    }
+
+    SECTION("memory budget") {
+        static constexpr size_t kMaxBytes{64_Kibi};
+        BaselineAnalysisCache cache{kMaxBytes};
+        for (uint64_t i{0}; i < 1'000; ++i) {
+            cache.put(key_of(i), analysis, code.size());
+            CHECK(cache.bytes() <= kMaxBytes);
+        }
+        CHECK(cache.size() < 1'000);
+
+        // Least recently used entries are evicted first
+        CHECK(cache.get(key_of(999)) == analysis);
+        CHECK(cache.get(key_of(0)) == nullptr);
+    }
+}
+
+}  // namespace silkworm
@@ -291,15 +291,12 @@ evmc_result EVM::execute_with_baseline_interpreter(evmc_revision rev, const evmc
     std::shared_ptr<evmone::baseline::CodeAnalysis> analysis;
     const bool use_cache{code_hash && baseline_analysis_cache};
     if (use_cache) {
-        const auto* ptr{baseline_analysis_cache->get(*code_hash)};
-        if (ptr) {
-            analysis = *ptr;
-        }
+        analysis = baseline_analysis_cache->get(*code_hash);
     }
     if (!analysis) {
         analysis = std::make_shared<evmone::baseline::CodeAnalysis>(evmone::baseline::analyze(rev, code));
         if (use_cache) {
-            baseline_analysis_cache->put(*code_hash, analysis);
+            baseline_analysis_cache->put(*code_hash, analysis, code.size());
         }
     }
 
@@ -17,40 +17,146 @@
 #include "processor.hpp"
 
 #include <cassert>
+#include <memory>
+#include <optional>
 
 #include <silkworm/core/chain/dao.hpp>
 #include <silkworm/core/chain/intrinsic_gas.hpp>
 #include <silkworm/core/chain/protocol_param.hpp>
+#include <silkworm/core/common/assert.hpp>
+#include <silkworm/core/state/recording_state.hpp>
 #include <silkworm/core/trie/vector_root.hpp>
 
 namespace silkworm {
 
-ExecutionProcessor::ExecutionProcessor(const Block& block, consensus::IEngine& consensus_engine, State& state,
-                                       const ChainConfig& config)
-    : state_{state}, consensus_engine_{consensus_engine}, evm_{block, state_, config} {
-    evm_.beneficiary = consensus_engine.get_beneficiary(block.header);
-}
+namespace {
 
-ValidationResult ExecutionProcessor::validate_transaction(const Transaction& txn) const noexcept {
-    if (!txn.from.has_value()) {
-        return ValidationResult::kMissingSender;
+    // Outcome of the execution of a transaction
+    struct TransactionOutcome {
+        uint64_t gas_used{0};
+        bool success{false};
+        std::optional<intx::uint256> deferred_reward;  // Valued when the reward of the beneficiary is still to be granted
+    };
+
+    ValidationResult validate_sender(const Transaction& txn, const IntraBlockState& state) noexcept {
+        if (!txn.from.has_value()) {
+            return ValidationResult::kMissingSender;
+        }
+
+        if (state.get_code_hash(*txn.from) != kEmptyHash) {
+            return ValidationResult::kSenderNoEOA;  // EIP-3607
+        }
+
+        const uint64_t nonce{state.get_nonce(*txn.from)};
+        if (nonce != txn.nonce) {
+            return ValidationResult::kWrongNonce;
+        }
+
+        // https://github.com/ethereum/EIPs/pull/3594
+        const intx::uint512 max_gas_cost{intx::umul(intx::uint256{txn.gas_limit}, txn.max_fee_per_gas)};
+        // See YP, Eq (57) in Section 6.2 "Execution"
+        const intx::uint512 v0{max_gas_cost + txn.value};
+        if (state.get_balance(*txn.from) < v0) {
+            return ValidationResult::kInsufficientFunds;
+        }
+
+        return ValidationResult::kOk;
     }
 
-    if (state_.get_code_hash(*txn.from) != kEmptyHash) {
-        return ValidationResult::kSenderNoEOA;  // EIP-3607
+    uint64_t refund_gas(const Transaction& txn, IntraBlockState& state, const EVM& evm, uint64_t gas_left,
+                        uint64_t gas_refund) noexcept {
+        const evmc_revision rev{evm.revision()};
+
+        const uint64_t max_refund_quotient{rev >= EVMC_LONDON ? param::kMaxRefundQuotientLondon
+                                                              : param::kMaxRefundQuotientFrontier};
+        const uint64_t max_refund{(txn.gas_limit - gas_left) / max_refund_quotient};
+        uint64_t refund = std::min(gas_refund, max_refund);
+        gas_left += refund;
+
+        const intx::uint256 base_fee_per_gas{evm.block().header.base_fee_per_gas.value_or(0)};
+        const intx::uint256 effective_gas_price{txn.effective_gas_price(base_fee_per_gas)};
+        state.add_to_balance(*txn.from, gas_left * effective_gas_price);
+
+        return gas_left;
     }
 
-    const uint64_t nonce{state_.get_nonce(*txn.from)};
-    if (nonce != txn.nonce) {
-        return ValidationResult::kWrongNonce;
+    // Precondition: transaction must be valid against state
+    TransactionOutcome run_transaction(const Transaction& txn, IntraBlockState& state, EVM& evm,
+                                       bool defer_reward) noexcept {
+        state.clear_journal_and_substate();
+
+        assert(txn.from.has_value());
+        state.access_account(*txn.from);
+
+        if (txn.to.has_value()) {
+            state.access_account(*txn.to);
+            // EVM itself increments the nonce for contract creation
+            state.set_nonce(*txn.from, txn.nonce + 1);
+        }
+
+        for (const AccessListEntry& ae : txn.access_list) {
+            state.access_account(ae.account);
+            for (const evmc::bytes32& key : ae.storage_keys) {
+                state.access_storage(ae.account, key);
+            }
+        }
+
+        const evmc_revision rev{evm.revision()};
+        if (rev >= EVMC_SHANGHAI) {
+            // EIP-3651: Warm COINBASE
+            state.access_account(evm.beneficiary);
+        }
+
+        const intx::uint256 base_fee_per_gas{evm.block().header.base_fee_per_gas.value_or(0)};
+        const intx::uint256 effective_gas_price{txn.effective_gas_price(base_fee_per_gas)};
+        state.subtract_from_balance(*txn.from, txn.gas_limit * effective_gas_price);
+
+        const intx::uint128 g0{intrinsic_gas(txn, rev)};
+        assert(g0 <= UINT64_MAX);  // true due to the precondition (transaction must be valid)
+
+        const CallResult vm_res{evm.execute(txn, txn.gas_limit - static_cast<uint64_t>(g0))};
+
+        TransactionOutcome outcome;
+        outcome.gas_used = txn.gas_limit - refund_gas(txn, state, evm, vm_res.gas_left, vm_res.gas_refund);
+        outcome.success = vm_res.status == EVMC_SUCCESS;
+
+        // award the fee recipient
+        const intx::uint256 priority_fee_per_gas{txn.priority_fee_per_gas(base_fee_per_gas)};
+        if (defer_reward) {
+            outcome.deferred_reward = priority_fee_per_gas * outcome.gas_used;
+        } else {
+            state.add_to_balance(evm.beneficiary, priority_fee_per_gas * outcome.gas_used);
+        }
+
+        state.destruct_suicides();
+        if (rev >= EVMC_SPURIOUS_DRAGON) {
+            state.destruct_touched_dead();
+        }
+
+        state.finalize_transaction();
+
+        return outcome;
     }
 
-    // https://github.com/ethereum/EIPs/pull/3594
-    const intx::uint512 max_gas_cost{intx::umul(intx::uint256{txn.gas_limit}, txn.max_fee_per_gas)};
-    // See YP, Eq (57) in Section 6.2 "Execution"
-    const intx::uint512 v0{max_gas_cost + txn.value};
-    if (state_.get_balance(*txn.from) < v0) {
-        return ValidationResult::kInsufficientFunds;
+}  // namespace
+
+// A transaction executed on a state of its own
+struct ExecutionProcessor::ExecutedTransaction {
+    std::unique_ptr<RecordingState> db;
+    std::unique_ptr<IntraBlockState> state;
+    bool valid{false};  // Whether the transaction was valid against the state it has been executed on
+    TransactionOutcome outcome;
+};
+
+ExecutionProcessor::ExecutionProcessor(const Block& block, consensus::IEngine& consensus_engine, State& state,
+                                       const ChainConfig& config)
+    : state_{state}, consensus_engine_{consensus_engine}, evm_{block, state_, config} {
+    evm_.beneficiary = consensus_engine.get_beneficiary(block.header);
+}
+
+ValidationResult ExecutionProcessor::validate_transaction(const Transaction& txn) const noexcept {
+    if (const ValidationResult err{validate_sender(txn, state_)}; err != ValidationResult::kOk) {
+        return err;
     }
 
     if (available_gas() < txn.gas_limit) {
@@ -69,79 +175,112 @@ void ExecutionProcessor::execute_transaction(const Transaction& txn, Receipt& re
     // Optimization: since receipt.logs might have some capacity, let's reuse it.
     std::swap(receipt.logs, state_.logs());
 
-    state_.clear_journal_and_substate();
+    const TransactionOutcome outcome{run_transaction(txn, state_, evm_, /*defer_reward=*/false)};
 
-    assert(txn.from.has_value());
-    state_.access_account(*txn.from);
+    cumulative_gas_used_ += outcome.gas_used;
 
-    if (txn.to.has_value()) {
-        state_.access_account(*txn.to);
-        // EVM itself increments the nonce for contract creation
-        state_.set_nonce(*txn.from, txn.nonce + 1);
-    }
+    receipt.type = txn.type;
+    receipt.success = outcome.success;
+    receipt.cumulative_gas_used = cumulative_gas_used_;
+    receipt.bloom = logs_bloom(state_.logs());
+    std::swap(receipt.logs, state_.logs());
+}
 
-    for (const AccessListEntry& ae : txn.access_list) {
-        state_.access_account(ae.account);
-        for (const evmc::bytes32& key : ae.storage_keys) {
-            state_.access_storage(ae.account, key);
-        }
-    }
+uint64_t ExecutionProcessor::available_gas() const noexcept {
+    return evm_.block().header.gas_limit - cumulative_gas_used_;
+}
 
-    const evmc_revision rev{evm_.revision()};
-    if (rev >= EVMC_SHANGHAI) {
-        // EIP-3651: Warm COINBASE
-        state_.access_account(evm_.beneficiary);
+bool ExecutionProcessor::execute_transaction_on(const Transaction& txn, ExecutedTransaction& executed,
+                                                bool defer_reward) const noexcept {
+    if (validate_sender(txn, *executed.state) != ValidationResult::kOk) {
+        return false;
     }
 
-    const intx::uint256 base_fee_per_gas{evm_.block().header.base_fee_per_gas.value_or(0)};
-    const intx::uint256 effective_gas_price{txn.effective_gas_price(base_fee_per_gas)};
-    state_.subtract_from_balance(*txn.from, txn.gas_limit * effective_gas_price);
-
-    const intx::uint128 g0{intrinsic_gas(txn, rev)};
-    assert(g0 <= UINT64_MAX);  // true due to the precondition (transaction must be valid)
-
-    const CallResult vm_res{evm_.execute(txn, txn.gas_limit - static_cast<uint64_t>(g0))};
-
-    const uint64_t gas_used{txn.gas_limit - refund_gas(txn, vm_res.gas_left, vm_res.gas_refund)};
+    EVM evm{evm_.block(), *executed.state, evm_.config()};
+    evm.beneficiary = evm_.beneficiary;
+    evm.baseline_analysis_cache = evm_.baseline_analysis_cache;  // Safe to be shared among threads
+    executed.outcome = run_transaction(txn, *executed.state, evm, defer_reward);
+    return true;
+}
 
-    // award the fee recipient
-    const intx::uint256 priority_fee_per_gas{txn.priority_fee_per_gas(base_fee_per_gas)};
-    state_.add_to_balance(evm_.beneficiary, priority_fee_per_gas * gas_used);
+bool ExecutionProcessor::can_execute_in_parallel() const noexcept {
+    return task_runner_ && evm_.block().transactions.size() > 1 && evm_.tracers().empty() &&
+           !evm_.advanced_analysis_cache && !evm_.exo_evm;
+}
 
-    state_.destruct_suicides();
-    if (rev >= EVMC_SPURIOUS_DRAGON) {
-        state_.destruct_touched_dead();
+ValidationResult ExecutionProcessor::execute_transactions_in_parallel(std::vector<Receipt>& receipts) noexcept {
+    const std::vector<Transaction>& transactions{evm_.block().transactions};
+    std::vector<ExecutedTransaction> executed(transactions.size());
+
+    // Speculative execution against the state at the beginning of the block
+    std::vector<std::function<void()>> tasks;
+    tasks.reserve(transactions.size());
+    for (size_t i{0}; i < transactions.size(); ++i) {
+        tasks.emplace_back([this, &transactions, &executed, i]() {
+            ExecutedTransaction& txn_exec{executed[i]};
+            txn_exec.db = std::make_unique<RecordingState>(
+                state_.db(), [this](const std::function<void()>& read) { task_runner_->read_db(read); });
+            txn_exec.state = std::make_unique<IntraBlockState>(*txn_exec.db);
+            txn_exec.valid = execute_transaction_on(transactions[i], txn_exec, /*defer_reward=*/true);
+        });
+    }
+    if (!task_runner_->run(tasks)) {
+        // Results of speculative executions can't be trusted: all transactions are executed again below
+        for (ExecutedTransaction& txn_exec : executed) {
+            txn_exec.valid = false;
+        }
     }
 
-    state_.finalize_transaction();
+    // Changes made so far within the block (e.g. by the DAO fork) are unknown to speculative executions
+    StateAccessSet changes;
+    state_.collect_changes(changes);
 
-    cumulative_gas_used_ += gas_used;
+    const evmc_revision rev{evm_.revision()};
+    auto receipt_it{receipts.begin()};
+    for (size_t i{0}; i < transactions.size(); ++i, ++receipt_it) {
+        const Transaction& txn{transactions[i]};
+        if (const ValidationResult err{validate_transaction(txn)}; err != ValidationResult::kOk) {
+            return err;
+        }
 
-    receipt.type = txn.type;
-    receipt.success = vm_res.status == EVMC_SUCCESS;
-    receipt.cumulative_gas_used = cumulative_gas_used_;
-    receipt.bloom = logs_bloom(state_.logs());
-    std::swap(receipt.logs, state_.logs());
-}
+        // Deferring the reward of the beneficiary is correct only if the transaction didn't access it
+        ExecutedTransaction& txn_exec{executed[i]};
+        if (!txn_exec.valid || txn_exec.db->reads().intersects(changes) ||
+            txn_exec.db->reads().accounts.contains(evm_.beneficiary)) {
+            // Depends on changes made by preceding transactions: execute it again against the current state
+            txn_exec.db = std::make_unique<RecordingState>(state_);
+            txn_exec.state = std::make_unique<IntraBlockState>(*txn_exec.db);
+            txn_exec.valid = execute_transaction_on(txn, txn_exec, /*defer_reward=*/false);
+            SILKWORM_ASSERT(txn_exec.valid);
+        }
 
-uint64_t ExecutionProcessor::available_gas() const noexcept {
-    return evm_.block().header.gas_limit - cumulative_gas_used_;
-}
+        state_.clear_journal_and_substate();
+        state_.merge_transaction(*txn_exec.state);
+        txn_exec.state->collect_changes(changes);
 
-uint64_t ExecutionProcessor::refund_gas(const Transaction& txn, uint64_t gas_left, uint64_t gas_refund) noexcept {
-    const evmc_revision rev{evm_.revision()};
+        const TransactionOutcome& outcome{txn_exec.outcome};
+        if (outcome.deferred_reward) {
+            state_.add_to_balance(evm_.beneficiary, *outcome.deferred_reward);
+            if (rev >= EVMC_SPURIOUS_DRAGON) {
+                state_.destruct_touched_dead();
+            }
+        }
+        changes.accounts.insert(evm_.beneficiary);
 
-    const uint64_t max_refund_quotient{rev >= EVMC_LONDON ? param::kMaxRefundQuotientLondon
-                                                          : param::kMaxRefundQuotientFrontier};
-    const uint64_t max_refund{(txn.gas_limit - gas_left) / max_refund_quotient};
-    uint64_t refund = std::min(gas_refund, max_refund);
-    gas_left += refund;
+        cumulative_gas_used_ += outcome.gas_used;
 
-    const intx::uint256 base_fee_per_gas{evm_.block().header.base_fee_per_gas.value_or(0)};
-    const intx::uint256 effective_gas_price{txn.effective_gas_price(base_fee_per_gas)};
-    state_.add_to_balance(*txn.from, gas_left * effective_gas_price);
+        Receipt& receipt{*receipt_it};
+        receipt.type = txn.type;
+        receipt.success = outcome.success;
+        receipt.cumulative_gas_used = cumulative_gas_used_;
+        receipt.bloom = logs_bloom(txn_exec.state->logs());
+        receipt.logs = std::move(txn_exec.state->logs());
 
-    return gas_left;
+        txn_exec.state.reset();
+        txn_exec.db.reset();
+    }
+
+    return ValidationResult::kOk;
 }
 
 ValidationResult ExecutionProcessor::execute_block_no_post_validation(std::vector<Receipt>& receipts) noexcept {
@@ -154,14 +293,20 @@ ValidationResult ExecutionProcessor::execute_block_no_post_validation(std::vecto
     cumulative_gas_used_ = 0;
 
     receipts.resize(block.transactions.size());
-    auto receipt_it{receipts.begin()};
-    for (const auto& txn : block.transactions) {
-        const ValidationResult err{validate_transaction(txn)};
-        if (err != ValidationResult::kOk) {
+    if (can_execute_in_parallel()) {
+        if (const ValidationResult err{execute_transactions_in_parallel(receipts)}; err != ValidationResult::kOk) {
             return err;
         }
-        execute_transaction(txn, *receipt_it);
-        ++receipt_it;
+    } else {
+        auto receipt_it{receipts.begin()};
+        for (const auto& txn : block.transactions) {
+            const ValidationResult err{validate_transaction(txn)};
+            if (err != ValidationResult::kOk) {
+                return err;
+            }
+            execute_transaction(txn, *receipt_it);
+            ++receipt_it;
+        }
     }
 
     const evmc_revision rev{evm_.revision()};
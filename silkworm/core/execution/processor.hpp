@@ -17,6 +17,7 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <vector>
 
 #include <silkworm/core/consensus/engine.hpp>
@@ -54,19 +55,55 @@ class ExecutionProcessor {
     EVM& evm() noexcept { return evm_; }
     const EVM& evm() const noexcept { return evm_; }
 
+    //! \brief Runs the speculative executions of the transactions of a block on other threads (e.g. on a thread pool)
+    class TaskRunner {
+      public:
+        virtual ~TaskRunner() = default;
+
+        //! \brief Runs the tasks concurrently on other threads and returns once all of them have ended
+        //! \details Meanwhile, the calling thread runs the reads of the state db issued by tasks through read_db, because
+        //! the state db may be bound to it (e.g. through a db transaction).
+        //! \return false if any task or read failed (e.g. threw), in which case results of all tasks are discarded
+        virtual bool run(const std::vector<std::function<void()>>& tasks) noexcept = 0;
+
+        //! \brief Runs read on the thread which called run and returns once done
+        //! \remarks If read fails, the current run fails and read has no effect
+        virtual void read_db(const std::function<void()>& read) noexcept = 0;
+    };
+
+    //! \brief Enables optimistic parallel execution of the transactions of the block
+    //! \details Transactions are executed concurrently on separate states recording what they read. Their changes are
+    //! then applied in block order: a transaction which read any account or storage location changed by preceding ones
+    //! is executed again against the up-to-date state, so that results are the same of sequential execution. If the
+    //! runner fails, all transactions are executed again that way.
+    //! \remarks Transactions are executed sequentially anyway when tracers, advanced analysis or an exogenous VM are
+    //! in use.
+    void enable_parallel_execution(TaskRunner* task_runner) noexcept { task_runner_ = task_runner; }
+
   private:
+    struct ExecutedTransaction;
+
     /// Execute the block, but do not write to the DB yet.
     /// Does not perform any post-execution validation (for example, receipt root is not checked).
     /// Precondition: validate_block_header & pre_validate_block_body must return kOk.
     [[nodiscard]] ValidationResult execute_block_no_post_validation(std::vector<Receipt>& receipts) noexcept;
 
     uint64_t available_gas() const noexcept;
-    uint64_t refund_gas(const Transaction& txn, uint64_t gas_left, uint64_t refund_gas) noexcept;
+
+    [[nodiscard]] bool can_execute_in_parallel() const noexcept;
+
+    /// Execute the transactions of the block in parallel, see enable_parallel_execution.
+    [[nodiscard]] ValidationResult execute_transactions_in_parallel(std::vector<Receipt>& receipts) noexcept;
+
+    /// Execute a transaction on the state of executed through a dedicated EVM.
+    /// Returns false if the transaction is not valid against such state.
+    bool execute_transaction_on(const Transaction& txn, ExecutedTransaction& executed, bool defer_reward) const noexcept;
 
     uint64_t cumulative_gas_used_{0};
     IntraBlockState state_;
     consensus::IEngine& consensus_engine_;
     EVM evm_;
+    TaskRunner* task_runner_{nullptr};
 };
 
 }  // namespace silkworm
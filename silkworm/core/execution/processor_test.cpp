@@ -16,6 +16,9 @@
 
 #include "processor.hpp"
 
+#include <mutex>
+#include <thread>
+
 #include <catch2/catch.hpp>
 #include <evmc/evmc.hpp>
 
@@ -23,6 +26,7 @@
 #include <silkworm/core/common/test_util.hpp>
 #include <silkworm/core/consensus/ethash/engine.hpp>
 #include <silkworm/core/state/in_memory_state.hpp>
+#include <silkworm/core/trie/vector_root.hpp>
 
 #include "address.hpp"
 
@@ -436,4 +440,223 @@ TEST_CASE("Empty suicide beneficiary") {
     CHECK(!state.read_account(suicide_beneficiary).has_value());
 }
 
+// Runs tasks on threads of their own, serializing their reads of the state db
+class ThreadTaskRunner : public ExecutionProcessor::TaskRunner {
+  public:
+    bool run(const std::vector<std::function<void()>>& tasks) noexcept override {
+        std::vector<std::thread> workers;
+        for (const auto& task : tasks) {
+            workers.emplace_back(task);
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        tasks_run += workers.size();
+        return true;
+    }
+
+    void read_db(const std::function<void()>& read) noexcept override {
+        std::unique_lock lock{mutex_};
+        read();
+    }
+
+    size_t tasks_run{0};
+
+  private:
+    std::mutex mutex_;
+};
+
+TEST_CASE("Parallel execution of transactions") {
+    Block block{};
+    block.header.number = 1'000'000;
+    block.header.gas_limit = 3'141'592;
+    block.header.gas_used = 5 * fee::kGTransaction;
+    block.header.beneficiary = 0x52bc44d5378309ee2abf1539bf71de1b7d7be3b5_address;
+
+    const evmc::address a{0x0a00000000000000000000000000000000000000_address};
+    const evmc::address b{0x0b00000000000000000000000000000000000000_address};
+    const evmc::address c{0x0c00000000000000000000000000000000000000_address};
+    const evmc::address d{0x0d00000000000000000000000000000000000000_address};
+
+    const auto transfer{[&](const evmc::address& from, const evmc::address& to, uint64_t nonce) {
+        Transaction txn{};
+        txn.type = Transaction::Type::kLegacy;
+        txn.nonce = nonce;
+        txn.max_priority_fee_per_gas = 20 * kGiga;
+        txn.max_fee_per_gas = 20 * kGiga;
+        txn.gas_limit = fee::kGTransaction;
+        txn.to = to;
+        txn.value = kEther;
+        txn.from = from;
+        return txn;
+    }};
+    block.transactions = {
+        transfer(a, d, 0),                         // independent
+        transfer(b, d, 0),                         // same recipient
+        transfer(a, b, 1),                         // same sender
+        transfer(b, c, 1),                         // sender changed by preceding ones
+        transfer(c, block.header.beneficiary, 0),  // to the beneficiary
+    };
+
+    const auto execute{[&](InMemoryState& state, bool parallel) {
+        for (const auto& address : {a, b, c}) {
+            state.update_account(address, /*initial=*/std::nullopt, Account{.balance = 10 * kEther});
+        }
+
+        auto engine{consensus::engine_factory(kMainnetConfig)};
+        ExecutionProcessor processor{block, *engine, state, kMainnetConfig};
+        ThreadTaskRunner task_runner;
+        if (parallel) {
+            processor.enable_parallel_execution(&task_runner);
+        }
+
+        std::vector<Receipt> receipts;
+        const ValidationResult result{processor.execute_and_write_block(receipts)};
+        CHECK(task_runner.tasks_run == (parallel ? block.transactions.size() : 0));
+        REQUIRE(result == ValidationResult::kOk);
+        return receipts;
+    }};
+
+    InMemoryState sequential_state;
+    const std::vector<Receipt> sequential_receipts{execute(sequential_state, /*parallel=*/false)};
+    InMemoryState parallel_state;
+    const std::vector<Receipt> parallel_receipts{execute(parallel_state, /*parallel=*/true)};
+
+    REQUIRE(parallel_receipts.size() == sequential_receipts.size());
+    for (size_t i{0}; i < parallel_receipts.size(); ++i) {
+        CHECK(parallel_receipts[i].success == sequential_receipts[i].success);
+        CHECK(parallel_receipts[i].cumulative_gas_used == sequential_receipts[i].cumulative_gas_used);
+    }
+    for (const auto& address : {a, b, c, d, block.header.beneficiary}) {
+        CHECK(parallel_state.read_account(address) == sequential_state.read_account(address));
+    }
+    CHECK(parallel_state.read_account(d)->balance == 2 * kEther);
+    CHECK(parallel_state.read_account(c)->nonce == 1);
+}
+
+TEST_CASE("Parallel execution of conflicting transactions") {
+    Block block{};
+    block.header.number = 1;
+    block.header.gas_limit = 10'000'000;
+    block.header.beneficiary = 0x52bc44d5378309ee2abf1539bf71de1b7d7be3b5_address;
+
+    const evmc::address a{0x0a00000000000000000000000000000000000000_address};
+    const evmc::address b{0x0b00000000000000000000000000000000000000_address};
+    const evmc::address c{0x0c00000000000000000000000000000000000000_address};
+    const evmc::address e{0x0e00000000000000000000000000000000000000_address};
+    const evmc::address heir{0x0f00000000000000000000000000000000000000_address};
+
+    // Increments its 0th storage
+    const evmc::address counter{0xc000000000000000000000000000000000000000_address};
+    const Bytes counter_code{*from_hex("600054600101600055")};
+    /*
+    0      PUSH1  => 00
+    2      SLOAD
+    3      PUSH1  => 01
+    5      ADD
+    6      PUSH1  => 00
+    8      SSTORE
+    */
+
+    // Self-destructs in favour of heir
+    const evmc::address suicidal{0xd000000000000000000000000000000000000000_address};
+    const Bytes suicidal_code{*from_hex("730f00000000000000000000000000000000000000ff")};
+    /*
+    0      PUSH20 => 0f00000000000000000000000000000000000000
+    21     SELFDESTRUCT
+    */
+
+    // Initially sets its 0th storage to 0x2a, then updates it to the input provided when called (see "No refund on
+    // error")
+    const Bytes creation_code{*from_hex("602a60005560098060106000396000f36000358060005531")};
+    const evmc::address created{create_address(c, 0)};
+
+    const auto transaction{[](const evmc::address& from, std::optional<evmc::address> to, uint64_t nonce,
+                              Bytes data = {}) {
+        Transaction txn{};
+        txn.type = Transaction::Type::kLegacy;
+        txn.nonce = nonce;
+        txn.max_priority_fee_per_gas = 20 * kGiga;
+        txn.max_fee_per_gas = 20 * kGiga;
+        txn.gas_limit = 200'000;
+        txn.to = to;
+        txn.data = std::move(data);
+        txn.from = from;
+        return txn;
+    }};
+    block.transactions = {
+        transaction(a, counter, 0),                                     // writes storage
+        transaction(b, counter, 0),                                     // writes the same storage
+        transaction(c, std::nullopt, 0, creation_code),                 // creates a contract
+        transaction(a, created, 1, *from_hex("07") + Bytes(31, '\0')),  // calls the contract just created
+        transaction(b, suicidal, 1),                                    // self-destructs
+        transaction(e, suicidal, 0),                                    // calls the self-destructed contract
+        transaction(e, heir, 1),                                        // sends to the heir of self-destruct
+        transaction(c, block.header.beneficiary, 1),                    // sends to the beneficiary
+    };
+
+    const auto execute{[&](InMemoryState& state, bool parallel, std::vector<Receipt>& receipts) {
+        IntraBlockState genesis{state};
+        for (const auto& address : {a, b, c, e}) {
+            genesis.add_to_balance(address, 10 * kEther);
+        }
+        genesis.create_contract(counter);
+        genesis.set_code(counter, counter_code);
+        genesis.set_storage(counter, {}, to_bytes32(*from_hex("05")));
+        genesis.create_contract(suicidal);
+        genesis.set_code(suicidal, suicidal_code);
+        genesis.add_to_balance(suicidal, kEther);
+        genesis.write_to_db(0);
+
+        auto engine{consensus::engine_factory(test::kLondonConfig)};
+        ExecutionProcessor processor{block, *engine, state, test::kLondonConfig};
+        ThreadTaskRunner task_runner;
+        if (parallel) {
+            processor.enable_parallel_execution(&task_runner);
+        }
+        const ValidationResult result{processor.execute_and_write_block(receipts)};
+        CHECK(task_runner.tasks_run == (parallel ? block.transactions.size() : 0));
+        return result;
+    }};
+
+    // Complete the header with the outcome of sequential execution
+    {
+        InMemoryState state;
+        std::vector<Receipt> receipts;
+        REQUIRE(execute(state, /*parallel=*/false, receipts) == ValidationResult::kWrongBlockGas);
+        block.header.gas_used = receipts.back().cumulative_gas_used;
+        static constexpr auto kEncoder = [](Bytes& to, const Receipt& r) { rlp::encode(to, r); };
+        block.header.receipts_root = trie::root_hash(receipts, kEncoder);
+    }
+
+    InMemoryState sequential_state;
+    std::vector<Receipt> sequential_receipts;
+    REQUIRE(execute(sequential_state, /*parallel=*/false, sequential_receipts) == ValidationResult::kOk);
+    InMemoryState parallel_state;
+    std::vector<Receipt> parallel_receipts;
+    REQUIRE(execute(parallel_state, /*parallel=*/true, parallel_receipts) == ValidationResult::kOk);
+
+    REQUIRE(parallel_receipts.size() == sequential_receipts.size());
+    for (size_t i{0}; i < parallel_receipts.size(); ++i) {
+        CHECK(parallel_receipts[i].success == sequential_receipts[i].success);
+        CHECK(parallel_receipts[i].cumulative_gas_used == sequential_receipts[i].cumulative_gas_used);
+        CHECK(parallel_receipts[i].bloom == sequential_receipts[i].bloom);
+    }
+    for (const auto& address : {a, b, c, e, heir, counter, suicidal, created, block.header.beneficiary}) {
+        CHECK(parallel_state.read_account(address) == sequential_state.read_account(address));
+    }
+    for (const auto& address : {counter, created}) {
+        const auto account{parallel_state.read_account(address)};
+        REQUIRE(account);
+        CHECK(parallel_state.read_storage(address, account->incarnation, {}) ==
+              sequential_state.read_storage(address, account->incarnation, {}));
+    }
+
+    CHECK(parallel_state.read_storage(counter, kDefaultIncarnation, {}) == to_bytes32(*from_hex("07")));
+    CHECK(parallel_state.read_storage(created, kDefaultIncarnation, {}) ==
+          to_bytes32(*from_hex("0700000000000000000000000000000000000000000000000000000000000000")));
+    CHECK(!parallel_state.read_account(suicidal));
+    CHECK(parallel_state.read_account(heir)->balance == kEther);
+}
+
 }  // namespace silkworm
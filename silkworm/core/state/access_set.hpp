@@ -0,0 +1,56 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <silkworm/core/common/base.hpp>
+#include <silkworm/core/common/hash_maps.hpp>
+
+namespace silkworm {
+
+//! \brief Accounts and storage locations accessed (either read or changed) by the execution of transactions
+struct StateAccessSet {
+    FlatHashSet<evmc::address> accounts;
+    FlatHashMap<evmc::address, FlatHashSet<evmc::bytes32>> storage;
+
+    //! \brief Whether any account or storage location in other is also in this set
+    [[nodiscard]] bool intersects(const StateAccessSet& other) const noexcept {
+        for (const auto& address : other.accounts) {
+            if (accounts.contains(address)) {
+                return true;
+            }
+        }
+        for (const auto& [address, keys] : other.storage) {
+            const auto it{storage.find(address)};
+            if (it == storage.end()) {
+                continue;
+            }
+            for (const auto& key : keys) {
+                if (it->second.contains(key)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    void clear() noexcept {
+        accounts.clear();
+        storage.clear();
+    }
+};
+
+}  // namespace silkworm
@@ -373,4 +373,50 @@ void IntraBlockState::clear_journal_and_substate() {
 
 void IntraBlockState::add_log(const Log& log) noexcept { logs_.push_back(log); }
 
+void IntraBlockState::collect_changes(StateAccessSet& changes) const {
+    for (const auto& [address, obj] : objects_) {
+        if (obj.current != obj.initial) {
+            changes.accounts.insert(address);
+        }
+    }
+    for (const auto& [address, storage] : storage_) {
+        for (const auto& [key, val] : storage.committed) {
+            if (val.original != val.initial) {
+                changes.storage[address].insert(key);
+            }
+        }
+    }
+}
+
+void IntraBlockState::merge_transaction(const IntraBlockState& txn_state) {
+    for (const auto& [address, obj] : txn_state.objects_) {
+        // Same as create_contract & destruct: storage of previous incarnation is dropped
+        const bool storage_wiped{!obj.current || !obj.initial || obj.current->incarnation != obj.initial->incarnation};
+        if (storage_wiped) {
+            storage_.erase(address);
+        }
+        if (auto it{objects_.find(address)}; it != objects_.end()) {
+            it->second.current = obj.current;
+        } else {
+            // Not read by this instance yet: initial state is the same read by txn_state
+            objects_.emplace(address, obj);
+        }
+    }
+
+    for (const auto& [address, storage] : txn_state.storage_) {
+        state::Storage& target{storage_[address]};
+        for (const auto& [key, val] : storage.committed) {
+            if (auto it{target.committed.find(key)}; it != target.committed.end()) {
+                it->second.original = val.original;
+            } else {
+                target.committed.emplace(key, val);
+            }
+        }
+    }
+
+    for (const auto& [code_hash, code] : txn_state.new_code_) {
+        new_code_.try_emplace(code_hash, code);
+    }
+}
+
 }  // namespace silkworm
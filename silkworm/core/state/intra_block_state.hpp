@@ -23,6 +23,7 @@
 
 #include <silkworm/core/common/base.hpp>
 #include <silkworm/core/common/hash_maps.hpp>
+#include <silkworm/core/state/access_set.hpp>
 #include <silkworm/core/state/delta.hpp>
 #include <silkworm/core/state/object.hpp>
 #include <silkworm/core/state/state.hpp>
@@ -110,7 +111,15 @@ class IntraBlockState {
 
     const FlatHashSet<evmc::address>& touched() const noexcept { return touched_; }
 
+    // Adds the accounts and storage locations whose current value differs from the initial one
+    void collect_changes(StateAccessSet& changes) const;
+
+    // Applies the changes made by a finalized transaction executed on txn_state, an instance whose db
+    // provided the same state as this instance (i.e. with no changes made to this instance in-between)
+    void merge_transaction(const IntraBlockState& txn_state);
+
   private:
+    friend class RecordingState;
     friend class state::CreateDelta;
     friend class state::UpdateDelta;
     friend class state::UpdateBalanceDelta;
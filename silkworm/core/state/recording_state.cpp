@@ -0,0 +1,137 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "recording_state.hpp"
+
+#include <silkworm/core/common/assert.hpp>
+
+namespace silkworm {
+
+template <class T, class F>
+T RecordingState::read_db(F&& read) const noexcept {
+    if (!run_read_) {
+        return read();
+    }
+    T result{};
+    run_read_([&]() { result = read(); });
+    return result;
+}
+
+std::optional<Account> RecordingState::read_account(const evmc::address& address) const noexcept {
+    reads_.accounts.insert(address);
+    if (block_state_) {
+        const state::Object* obj{block_state_->get_object(address)};
+        return obj ? obj->current : std::nullopt;
+    }
+    return read_db<std::optional<Account>>([&]() { return db_.read_account(address); });
+}
+
+ByteView RecordingState::read_code(const evmc::bytes32& code_hash) const noexcept {
+    // Code is immutable hence not recorded
+    if (block_state_) {
+        if (auto it{block_state_->new_code_.find(code_hash)}; it != block_state_->new_code_.end()) {
+            return it->second;
+        }
+    }
+    return read_db<ByteView>([&]() { return db_.read_code(code_hash); });
+}
+
+evmc::bytes32 RecordingState::read_storage(const evmc::address& address, uint64_t incarnation,
+                                           const evmc::bytes32& location) const noexcept {
+    reads_.storage[address].insert(location);
+    if (block_state_) {
+        // Asked for the incarnation read by read_account i.e. the current one
+        return block_state_->get_current_storage(address, location);
+    }
+    return read_db<evmc::bytes32>([&]() { return db_.read_storage(address, incarnation, location); });
+}
+
+uint64_t RecordingState::previous_incarnation(const evmc::address& address) const noexcept {
+    reads_.accounts.insert(address);
+    if (block_state_) {
+        // Same as IntraBlockState::create_contract for an account which has been destructed within the block
+        const state::Object* obj{block_state_->get_object(address)};
+        if (obj && !obj->current && obj->initial && obj->initial->incarnation) {
+            return obj->initial->incarnation;
+        }
+    }
+    return read_db<uint64_t>([&]() { return db_.previous_incarnation(address); });
+}
+
+std::optional<BlockHeader> RecordingState::read_header(uint64_t block_number,
+                                                       const evmc::bytes32& block_hash) const noexcept {
+    return read_db<std::optional<BlockHeader>>([&]() { return db_.read_header(block_number, block_hash); });
+}
+
+bool RecordingState::read_body(uint64_t block_number, const evmc::bytes32& block_hash, BlockBody& out) const noexcept {
+    return read_db<bool>([&]() { return db_.read_body(block_number, block_hash, out); });
+}
+
+std::optional<intx::uint256> RecordingState::total_difficulty(uint64_t block_number,
+                                                              const evmc::bytes32& block_hash) const noexcept {
+    return read_db<std::optional<intx::uint256>>([&]() { return db_.total_difficulty(block_number, block_hash); });
+}
+
+evmc::bytes32 RecordingState::state_root_hash() const {
+    return read_db<evmc::bytes32>([&]() { return db_.state_root_hash(); });
+}
+
+uint64_t RecordingState::current_canonical_block() const {
+    return read_db<uint64_t>([&]() { return db_.current_canonical_block(); });
+}
+
+std::optional<evmc::bytes32> RecordingState::canonical_hash(uint64_t block_number) const {
+    return read_db<std::optional<evmc::bytes32>>([&]() { return db_.canonical_hash(block_number); });
+}
+
+void RecordingState::insert_block(const Block&, const evmc::bytes32&) {
+    SILKWORM_ASSERT(false);  // Read-only
+}
+
+void RecordingState::canonize_block(uint64_t, const evmc::bytes32&) {
+    SILKWORM_ASSERT(false);  // Read-only
+}
+
+void RecordingState::decanonize_block(uint64_t) {
+    SILKWORM_ASSERT(false);  // Read-only
+}
+
+void RecordingState::insert_receipts(uint64_t, const std::vector<Receipt>&) {
+    SILKWORM_ASSERT(false);  // Read-only
+}
+
+void RecordingState::begin_block(uint64_t) {
+    SILKWORM_ASSERT(false);  // Read-only
+}
+
+void RecordingState::update_account(const evmc::address&, std::optional<Account>, std::optional<Account>) {
+    SILKWORM_ASSERT(false);  // Read-only
+}
+
+void RecordingState::update_account_code(const evmc::address&, uint64_t, const evmc::bytes32&, ByteView) {
+    SILKWORM_ASSERT(false);  // Read-only
+}
+
+void RecordingState::update_storage(const evmc::address&, uint64_t, const evmc::bytes32&, const evmc::bytes32&,
+                                    const evmc::bytes32&) {
+    SILKWORM_ASSERT(false);  // Read-only
+}
+
+void RecordingState::unwind_state_changes(uint64_t) {
+    SILKWORM_ASSERT(false);  // Read-only
+}
+
+}  // namespace silkworm
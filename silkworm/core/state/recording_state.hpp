@@ -0,0 +1,104 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <functional>
+
+#include <silkworm/core/state/access_set.hpp>
+#include <silkworm/core/state/intra_block_state.hpp>
+#include <silkworm/core/state/state.hpp>
+
+namespace silkworm {
+
+/// RecordingState is a read-only State recording the accounts and storage locations read through it.
+/// It allows to execute a transaction on a separate IntraBlockState and to tell afterwards whether the transaction
+/// depends on changes made by others. Reads are served either by the db or by the current state of a block being
+/// executed (i.e. including the changes of the transactions executed so far). Writes are not supported.
+class RecordingState : public State {
+  public:
+    //! \brief Runs a read on behalf of the caller (e.g. on the thread owning a db transaction) returning once done
+    using ReadRunner = std::function<void(const std::function<void()>&)>;
+
+    //! \brief Reads from the state db
+    //! \param [in] run_read : the runner of the reads of db, if it's not safe to access it from the calling thread
+    explicit RecordingState(State& db, ReadRunner run_read = {}) noexcept
+        : db_{db}, run_read_{std::move(run_read)} {}
+
+    //! \brief Reads the current state of a block being executed
+    explicit RecordingState(const IntraBlockState& block_state) noexcept
+        : db_{block_state.db_}, block_state_{&block_state} {}
+
+    //! \brief The accounts and storage locations read so far
+    [[nodiscard]] const StateAccessSet& reads() const noexcept { return reads_; }
+
+    std::optional<Account> read_account(const evmc::address& address) const noexcept override;
+
+    ByteView read_code(const evmc::bytes32& code_hash) const noexcept override;
+
+    evmc::bytes32 read_storage(const evmc::address& address, uint64_t incarnation,
+                               const evmc::bytes32& location) const noexcept override;
+
+    uint64_t previous_incarnation(const evmc::address& address) const noexcept override;
+
+    std::optional<BlockHeader> read_header(uint64_t block_number,
+                                           const evmc::bytes32& block_hash) const noexcept override;
+
+    [[nodiscard]] bool read_body(uint64_t block_number, const evmc::bytes32& block_hash,
+                                 BlockBody& out) const noexcept override;
+
+    std::optional<intx::uint256> total_difficulty(uint64_t block_number,
+                                                  const evmc::bytes32& block_hash) const noexcept override;
+
+    evmc::bytes32 state_root_hash() const override;
+
+    uint64_t current_canonical_block() const override;
+
+    std::optional<evmc::bytes32> canonical_hash(uint64_t block_number) const override;
+
+    void insert_block(const Block& block, const evmc::bytes32& hash) override;
+
+    void canonize_block(uint64_t block_number, const evmc::bytes32& block_hash) override;
+
+    void decanonize_block(uint64_t block_number) override;
+
+    void insert_receipts(uint64_t block_number, const std::vector<Receipt>& receipts) override;
+
+    void begin_block(uint64_t block_number) override;
+
+    void update_account(const evmc::address& address, std::optional<Account> initial,
+                        std::optional<Account> current) override;
+
+    void update_account_code(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& code_hash,
+                             ByteView code) override;
+
+    void update_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location,
+                        const evmc::bytes32& initial, const evmc::bytes32& current) override;
+
+    void unwind_state_changes(uint64_t block_number) override;
+
+  private:
+    //! \brief Runs read through run_read_, if any
+    template <class T, class F>
+    T read_db(F&& read) const noexcept;
+
+    State& db_;
+    const IntraBlockState* block_state_{nullptr};  // Valued when reading the state of a block being executed
+    ReadRunner run_read_;
+    mutable StateAccessSet reads_;
+};
+
+}  // namespace silkworm
@@ -16,6 +16,7 @@
 
 #include "hash_builder.hpp"
 
+#include <algorithm>
 #include <bit>
 #include <cstring>
 #include <span>
@@ -24,6 +25,7 @@
 
 #include <silkworm/core/common/assert.hpp>
 #include <silkworm/core/common/cast.hpp>
+#include <silkworm/core/common/keccak_batch.hpp>
 #include <silkworm/core/common/util.hpp>
 #include <silkworm/core/rlp/encode.hpp>
 
@@ -78,12 +80,31 @@ static Bytes wrap_hash(std::span<const uint8_t, kHashLength> hash) {
     return wrapped;
 }
 
-static Bytes node_ref(ByteView rlp) {
-    if (rlp.length() < kHashLength) {
-        return Bytes{rlp};
+void HashBuilder::push_node(ByteView rlp) {
+    if (rlp.length() >= kHashLength) {
+        unhashed_.push_back(stack_.size());
     }
-    const ethash::hash256 hash{keccak256(rlp)};
-    return wrap_hash(hash.bytes);
+    stack_.emplace_back(rlp);
+}
+
+void HashBuilder::hash_pending_nodes(size_t from) {
+    const auto first{std::lower_bound(unhashed_.begin(), unhashed_.end(), from)};
+    if (first == unhashed_.end()) {
+        return;
+    }
+
+    // Pending nodes are siblings (or descendants of siblings) not hashed yet hence independent of each other
+    batch_rlps_.clear();
+    for (auto it{first}; it != unhashed_.end(); ++it) {
+        batch_rlps_.emplace_back(stack_[*it]);
+    }
+    batch_hashes_.resize(batch_rlps_.size());
+    keccak256_batch(batch_rlps_, batch_hashes_);
+
+    for (size_t i{0}; i < batch_hashes_.size(); ++i) {
+        stack_[first[static_cast<std::ptrdiff_t>(i)]] = wrap_hash(batch_hashes_[i].bytes);
+    }
+    unhashed_.erase(first, unhashed_.end());
 }
 
 void HashBuilder::add_leaf(Bytes key, ByteView value) {
@@ -113,15 +134,56 @@ void HashBuilder::finalize() {
         gen_struct_step(key_, {});
         key_.clear();
         value_ = Bytes{};
+    } else if (!groups_.empty()) {
+        // Sub-tries have been added: close the root branch node
+        SILKWORM_ASSERT(groups_.size() == 1 && std::popcount(groups_[0]) > 1);
+        close_prefix_group({}, 0);
+        groups_.clear();
+        tree_masks_.clear();
+        hash_masks_.clear();
     }
 }
 
+void HashBuilder::finalize_subtrie() {
+    if (key_.empty()) {
+        return;
+    }
+    // A succeeding key under another first nibble makes the last step behave exactly as in the whole trie
+    // i.e. all prefix groups below the root get closed while the root one is left open
+    const Bytes succeeding(1, static_cast<uint8_t>(key_[0] + 1));
+    gen_struct_step(key_, succeeding);
+    key_.clear();
+    value_ = Bytes{};
+    hash_pending_nodes(0);  // Hashing is carried out by the thread building this sub-trie
+}
+
+void HashBuilder::add_subtrie(HashBuilder& subtrie) {
+    SILKWORM_ASSERT(key_.empty() && subtrie.key_.empty());
+    if (subtrie.stack_.empty()) {
+        return;  // Nothing added to sub-trie
+    }
+    SILKWORM_ASSERT(subtrie.stack_.size() == 1 && subtrie.groups_.size() == 1 && std::popcount(subtrie.groups_[0]) == 1);
+
+    if (groups_.empty()) {
+        groups_.resize(1);
+        tree_masks_.resize(1);
+        hash_masks_.resize(1);
+    }
+    SILKWORM_ASSERT(groups_[0] < subtrie.groups_[0]);  // Increasing order of nibbles
+    groups_[0] |= subtrie.groups_[0];
+    tree_masks_[0] |= subtrie.tree_masks_[0];
+    hash_masks_[0] |= subtrie.hash_masks_[0];
+    stack_.push_back(std::move(subtrie.stack_.back()));
+    subtrie.reset();
+}
+
 evmc::bytes32 HashBuilder::root_hash() { return root_hash(/*auto_finalize=*/true); }
 
 evmc::bytes32 HashBuilder::root_hash(bool auto_finalize) {
     if (auto_finalize) {
         finalize();
     }
+    hash_pending_nodes(0);
 
     if (stack_.empty()) {
         return kEmptyRoot;
@@ -168,7 +230,7 @@ void HashBuilder::gen_struct_step(ByteView current, const ByteView succeeding) {
         const ByteView short_node_key{current.substr(from)};
         if (!build_extensions) {
             if (const Bytes * leaf_value{std::get_if<Bytes>(&value_)}) {
-                stack_.push_back(node_ref(leaf_node_rlp(short_node_key, *leaf_value)));
+                push_node(leaf_node_rlp(short_node_key, *leaf_value));
             } else {
                 stack_.push_back(wrap_hash(std::get<evmc::bytes32>(value_).bytes));
                 if (node_collector) {
@@ -197,7 +259,10 @@ void HashBuilder::gen_struct_step(ByteView current, const ByteView succeeding) {
                 }
             }
 
-            stack_.back() = node_ref(extension_node_rlp(short_node_key, stack_.back()));
+            hash_pending_nodes(stack_.size() - 1);
+            const ByteView extension_rlp{extension_node_rlp(short_node_key, stack_.back())};
+            stack_.pop_back();
+            push_node(extension_rlp);
 
             hash_masks_.resize(from);
             tree_masks_.resize(from);
@@ -210,33 +275,7 @@ void HashBuilder::gen_struct_step(ByteView current, const ByteView succeeding) {
 
         // Close the immediately encompassing prefix group, if needed
         if (!succeeding.empty() || preceding_exists) {  // branch node
-            std::vector<Bytes> child_hashes{branch_ref(groups_[len], hash_masks_[len])};
-
-            // See node/silkworm/trie/intermediate_hashes.hpp
-            if (node_collector) {
-                if (len > 0) {
-                    hash_masks_[len - 1] |= 1u << current[len - 1];
-                }
-
-                const bool store_in_db_trie{tree_masks_[len] || hash_masks_[len]};
-                if (store_in_db_trie) {
-                    if (len > 0) {
-                        tree_masks_[len - 1] |= 1u << current[len - 1];  // register myself in parent bitmap
-                    }
-
-                    std::vector<evmc::bytes32> hashes(child_hashes.size());
-                    for (size_t i{0}; i < child_hashes.size(); ++i) {
-                        SILKWORM_ASSERT(child_hashes[i].size() == kHashLength + 1);
-                        std::memcpy(hashes[i].bytes, &child_hashes[i][1], kHashLength);
-                    }
-                    Node node{groups_[len], tree_masks_[len], hash_masks_[len], hashes};
-                    if (len == 0) {
-                        node.set_root_hash(root_hash(/*auto_finalize=*/false));
-                    }
-
-                    node_collector(current.substr(0, len), node);
-                }
-            }
+            close_prefix_group(current, len);
         }
 
         groups_.resize(len);
@@ -255,6 +294,36 @@ void HashBuilder::gen_struct_step(ByteView current, const ByteView succeeding) {
     }
 }
 
+void HashBuilder::close_prefix_group(ByteView current, size_t len) {
+    std::vector<Bytes> child_hashes{branch_ref(groups_[len], hash_masks_[len])};
+
+    // See node/silkworm/trie/intermediate_hashes.hpp
+    if (node_collector) {
+        if (len > 0) {
+            hash_masks_[len - 1] |= 1u << current[len - 1];
+        }
+
+        const bool store_in_db_trie{tree_masks_[len] || hash_masks_[len]};
+        if (store_in_db_trie) {
+            if (len > 0) {
+                tree_masks_[len - 1] |= 1u << current[len - 1];  // register myself in parent bitmap
+            }
+
+            std::vector<evmc::bytes32> hashes(child_hashes.size());
+            for (size_t i{0}; i < child_hashes.size(); ++i) {
+                SILKWORM_ASSERT(child_hashes[i].size() == kHashLength + 1);
+                std::memcpy(hashes[i].bytes, &child_hashes[i][1], kHashLength);
+            }
+            Node node{groups_[len], tree_masks_[len], hash_masks_[len], hashes};
+            if (len == 0) {
+                node.set_root_hash(root_hash(/*auto_finalize=*/false));
+            }
+
+            node_collector(current.substr(0, len), node);
+        }
+    }
+}
+
 // Takes children from the stack and replaces them with branch node ref.
 std::vector<Bytes> HashBuilder::branch_ref(uint16_t state_mask, uint16_t hash_mask) {
     SILKWORM_ASSERT(is_subset(hash_mask, state_mask));
@@ -262,6 +331,7 @@ std::vector<Bytes> HashBuilder::branch_ref(uint16_t state_mask, uint16_t hash_ma
     child_hashes.reserve(static_cast<size_t>(std::popcount(hash_mask)));
 
     const size_t first_child_idx{stack_.size() - static_cast<size_t>(std::popcount(state_mask))};
+    hash_pending_nodes(first_child_idx);
 
     // Length of 1 for the nil value added below
     rlp::Header h{.list = true, .payload_length = 1};
@@ -291,8 +361,8 @@ std::vector<Bytes> HashBuilder::branch_ref(uint16_t state_mask, uint16_t hash_ma
     // branch nodes with values are not supported
     rlp_buffer_.push_back(rlp::kEmptyStringCode);
 
-    stack_.resize(first_child_idx + 1);
-    stack_.back() = node_ref(rlp_buffer_);
+    stack_.resize(first_child_idx);
+    push_node(rlp_buffer_);
 
     return child_hashes;
 }
@@ -305,6 +375,7 @@ void HashBuilder::reset() {
     tree_masks_.clear();
     hash_masks_.clear();
     stack_.clear();
+    unhashed_.clear();
     rlp_buffer_.clear();
 }
 
@@ -21,6 +21,8 @@
 #include <variant>
 #include <vector>
 
+#include <ethash/hash_types.hpp>
+
 #include <silkworm/core/common/base.hpp>
 #include <silkworm/core/trie/node.hpp>
 
@@ -63,6 +65,16 @@ class HashBuilder {
     //! \brief Resets the builder as newly created
     void reset();
 
+    //! \brief Completes the sub-trie of entries sharing the same first nibble as a child of the root branch node
+    //! \details Sub-tries of different first nibbles can be built in parallel by different builders and then
+    //! added in increasing nibble order to the builder of the whole trie by add_subtrie()
+    void finalize_subtrie();
+
+    //! \brief Adds as child of the root branch node a sub-trie completed by finalize_subtrie()
+    //! \remarks No entries may be added to this builder. At least two non-empty sub-tries must be added before
+    //! root_hash() is called, otherwise the root node is not a branch node. Sub-trie builder is reset
+    void add_subtrie(HashBuilder& subtrie);
+
   private:
     evmc::bytes32 root_hash(bool auto_finalize);
 
@@ -71,12 +83,21 @@ class HashBuilder {
     // See Erigon GenStructStep
     void gen_struct_step(ByteView current, ByteView succeeding);
 
+    // Replaces the children in prefix group at len with their branch node (collecting it if needed)
+    void close_prefix_group(ByteView current, size_t len);
+
     std::vector<Bytes> branch_ref(uint16_t state_mask, uint16_t hash_mask);
 
     ByteView leaf_node_rlp(ByteView path, ByteView value);
 
     ByteView extension_node_rlp(ByteView path, ByteView child_ref);
 
+    // Pushes a node onto the stack: RLPs not shorter than a hash are kept as such until hashed by hash_pending_nodes
+    void push_node(ByteView rlp);
+
+    // Replaces the RLPs in the stack from index on with their hashes, computing them in batch
+    void hash_pending_nodes(size_t from);
+
     Bytes key_;                                 // unpacked – one nibble per byte
     std::variant<Bytes, evmc::bytes32> value_;  // leaf value or node hash
     bool is_in_db_trie_{false};
@@ -84,7 +105,11 @@ class HashBuilder {
     std::vector<uint16_t> groups_;
     std::vector<uint16_t> tree_masks_;
     std::vector<uint16_t> hash_masks_;
-    std::vector<Bytes> stack_;  // node references: hashes or embedded RLPs
+    std::vector<Bytes> stack_;      // node references: hashes or embedded RLPs (or RLPs yet to be hashed)
+    std::vector<size_t> unhashed_;  // increasing indices in stack_ of RLPs yet to be hashed
+
+    std::vector<ByteView> batch_rlps_;           // RLPs being hashed in batch
+    std::vector<ethash::hash256> batch_hashes_;  // Hashes computed in batch
 
     Bytes rlp_buffer_;
 };
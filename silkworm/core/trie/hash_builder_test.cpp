@@ -14,6 +14,8 @@
    limitations under the License.
 */
 
+#include <algorithm>
+#include <array>
 #include <iterator>
 
 #include <catch2/catch.hpp>
@@ -191,6 +193,55 @@ TEST_CASE("HashBuilder3") {
 }
 */
 
+TEST_CASE("Sub-tries") {
+    std::vector<Bytes> keys;
+    for (uint16_t i{0}; i < 3'000; ++i) {
+        const Bytes preimage{static_cast<uint8_t>(i >> 8), static_cast<uint8_t>(i)};
+        const ethash::hash256 hash{keccak256(preimage)};
+        keys.push_back(unpack_nibbles(ByteView{hash.bytes, kHashLength}));
+    }
+    std::sort(keys.begin(), keys.end());
+
+    // Vary sub-tries: none under nibble 5 and a single leaf under nibble 0
+    std::erase_if(keys, [](const Bytes& key) { return key[0] == 5; });
+    const auto first_not_zero{std::find_if(keys.begin(), keys.end(), [](const Bytes& key) { return key[0] != 0; })};
+    keys.erase(std::next(keys.begin()), first_not_zero);
+
+    using CollectedNodes = std::vector<std::pair<Bytes, Node>>;
+    auto collect_into{[](CollectedNodes& nodes) {
+        return [&nodes](ByteView nibbled_key, const Node& node) { nodes.emplace_back(nibbled_key, node); };
+    }};
+
+    CollectedNodes expected_nodes;
+    HashBuilder hb;
+    hb.node_collector = collect_into(expected_nodes);
+    for (const auto& key : keys) {
+        hb.add_leaf(key, key.substr(kHashLength));
+    }
+    const auto expected_root{hb.root_hash()};
+
+    std::array<CollectedNodes, 16> subtrie_nodes;
+    std::array<HashBuilder, 16> subtries;
+    for (const auto& key : keys) {
+        auto& subtrie{subtries[key[0]]};
+        if (!subtrie.node_collector) {
+            subtrie.node_collector = collect_into(subtrie_nodes[key[0]]);
+        }
+        subtrie.add_leaf(key, key.substr(kHashLength));
+    }
+
+    CollectedNodes nodes;
+    HashBuilder root_hb;
+    root_hb.node_collector = collect_into(nodes);
+    for (size_t nibble{0}; nibble < 16; ++nibble) {
+        subtries[nibble].finalize_subtrie();
+        root_hb.add_subtrie(subtries[nibble]);
+        nodes.insert(nodes.end(), subtrie_nodes[nibble].begin(), subtrie_nodes[nibble].end());
+    }
+    CHECK(to_hex(root_hb.root_hash()) == to_hex(expected_root));
+    CHECK(nodes == expected_nodes);
+}
+
 TEST_CASE("Known root hash") {
     static constexpr auto root_hash{0x9fa752911d55c3a1246133fe280785afbdba41f357e9cae1131d5f5b0a078b9c_bytes32};
     HashBuilder hb;
@@ -17,18 +17,56 @@
 #include "prefix_set.hpp"
 
 #include <algorithm>
+#include <cstring>
+
+#include <silkworm/core/common/endian.hpp>
 
 namespace silkworm::trie {
 
-void PrefixSet::insert(ByteView key, bool marker) { insert(Bytes(key), marker); }
+// Heads are compared in blocks of this size with no branches, which compilers turn into SIMD compares
+static constexpr size_t kHeadsBlockSize{8};
+
+// Number of blocks of heads scanned before resorting to a binary search
+static constexpr size_t kMaxHeadsBlocks{4};
+
+//! \brief Leading 8 bytes of key as a big endian number (zero padded): if the heads of two keys differ, the keys
+//! compare the same way as their heads
+static uint64_t head_of(ByteView key) {
+    uint8_t bytes[8]{};
+    if (!key.empty()) {
+        std::memcpy(bytes, key.data(), std::min<size_t>(key.length(), sizeof(bytes)));
+    }
+    return endian::load_big_u64(bytes);
+}
+
+void PrefixSet::insert(ByteView key, bool marker) {
+    const Entry entry{.offset = arena_.size(), .length = static_cast<uint32_t>(key.length()), .marker = marker};
+    arena_.append(key);
+    if (sorted_size_ == entries_.size() && (entries_.empty() || less(entries_.back(), entry))) {
+        append_sorted(entry);
+    } else {
+        entries_.push_back(entry);
+    }
+}
+
+void PrefixSet::insert(Bytes&& key, bool marker) { insert(ByteView{key}, marker); }
 
-void PrefixSet::insert(Bytes&& key, bool marker) {
-    keys_.emplace_back(key, marker);
-    sorted_ = false;
+bool PrefixSet::less(const Entry& lhs, const Entry& rhs) const {
+    const int cmp{key(lhs).compare(key(rhs))};
+    return cmp < 0 || (cmp == 0 && lhs.marker < rhs.marker);
+}
+
+void PrefixSet::append_sorted(const Entry& entry) {
+    if (entry.marker) {
+        marked_.push_back(entries_.size());
+    }
+    heads_.push_back(head_of(key(entry)));
+    entries_.push_back(entry);
+    ++sorted_size_;
 }
 
 bool PrefixSet::contains(ByteView prefix) {
-    if (keys_.empty()) {
+    if (entries_.empty()) {
         return false;
     }
 
@@ -38,51 +76,125 @@ bool PrefixSet::contains(ByteView prefix) {
     // We optimize for the case when contains() queries are issued with increasing prefixes,
     // e.g. contains("00"), contains("04"), contains("0b"), contains("0b05"), contains("0c"), contains("0f"), ...
     // instead of some random order.
-    while (index_ > 0 && keys_[index_].first > prefix) {
+    while (index_ > 0 && key(entries_[index_]) > prefix) {
         --index_;
     }
+    skip_lower(prefix);
 
-    for (size_t max_index{keys_.size() - 1};; ++index_) {
-        const auto& [key, _]{keys_[index_]};
-        if (key.starts_with(prefix)) {
+    for (size_t max_index{entries_.size() - 1};; ++index_) {
+        const ByteView item_key{key(entries_[index_])};
+        if (item_key.starts_with(prefix)) {
             return true;
         }
-        if (key > prefix || index_ == max_index) {
+        if (item_key > prefix || index_ == max_index) {
             return false;
         }
     }
 }
 
+void PrefixSet::skip_lower(ByteView prefix) {
+    // A key whose head is lower than the one of prefix is lower than prefix hence can't begin with it
+    const uint64_t target{head_of(prefix)};
+    const size_t size{heads_.size()};
+    for (size_t blocks{0}; index_ + kHeadsBlockSize <= size; ++blocks) {
+        if (blocks == kMaxHeadsBlocks) {
+            // Far away: keep on with a binary search
+            index_ = static_cast<size_t>(std::lower_bound(heads_.begin() + static_cast<std::ptrdiff_t>(index_),
+                                                          heads_.end(), target) -
+                                         heads_.begin());
+            break;
+        }
+        size_t lower{0};
+        for (size_t i{0}; i < kHeadsBlockSize; ++i) {
+            lower += heads_[index_ + i] < target ? 1u : 0u;
+        }
+        index_ += lower;
+        if (lower < kHeadsBlockSize) {
+            break;
+        }
+    }
+    while (index_ < size && heads_[index_] < target) {
+        ++index_;
+    }
+
+    // Leave index_ on the last key when all of them precede prefix
+    index_ = std::min(index_, size - 1);
+}
+
 std::pair<bool, ByteView> PrefixSet::contains_and_next_marked(ByteView prefix, size_t invariant_prefix_len) {
     bool is_contained{contains(prefix)};
     ByteView next_created{};
 
     invariant_prefix_len = std::min(invariant_prefix_len, prefix.size());
 
-    // Lookup next marked created key
-    for (size_t i{index_}, e{keys_.size()}; i < e; ++i) {
-        auto& item{keys_[i]};
-
-        // Check we're in the same invariant part of the prefix
-        if (invariant_prefix_len && std::memcmp(&prefix[0], &item.first[0], invariant_prefix_len) != 0) {
-            break;
-        }
-
-        if (item.second) {
-            next_created = ByteView(item.first);
-            break;
+    // Lookup next marked created key: keys sharing the invariant part of the prefix are contiguous hence
+    // only the first marked one from current position needs to be checked
+    const auto it{std::lower_bound(marked_.begin(), marked_.end(), index_)};
+    if (it != marked_.end()) {
+        const ByteView item_key{key(entries_[*it])};
+        if (!invariant_prefix_len ||
+            item_key.substr(0, invariant_prefix_len) == prefix.substr(0, invariant_prefix_len)) {
+            next_created = item_key;
         }
     }
 
     return {is_contained, next_created};
 }
 
+PrefixSet PrefixSet::subset(ByteView prefix) {
+    PrefixSet subset;
+    if (entries_.empty()) {
+        return subset;
+    }
+
+    ensure_sorted();
+    auto it{std::lower_bound(entries_.begin(), entries_.end(), prefix,
+                             [this](const Entry& item, ByteView k) { return key(item) < k; })};
+    for (; it != entries_.end() && key(*it).starts_with(prefix); ++it) {
+        const ByteView item_key{key(*it)};
+        const Entry entry{.offset = subset.arena_.size(), .length = it->length, .marker = it->marker};
+        subset.arena_.append(item_key);
+        subset.append_sorted(entry);
+    }
+    return subset;
+}
+
 void PrefixSet::ensure_sorted() {
-    if (!sorted_) {
-        std::sort(keys_.begin(), keys_.end());
-        keys_.erase(std::unique(keys_.begin(), keys_.end()), keys_.end());
-        sorted_ = true;
+    if (sorted_size_ == entries_.size()) {
+        return;
+    }
+
+    // Sort the tail of recent insertions and merge it into the sorted run
+    const auto tail{entries_.begin() + static_cast<std::ptrdiff_t>(sorted_size_)};
+    const auto less_fn{[this](const Entry& lhs, const Entry& rhs) { return less(lhs, rhs); }};
+    std::sort(tail, entries_.end(), less_fn);
+    std::inplace_merge(entries_.begin(), tail, entries_.end(), less_fn);
+    entries_.erase(std::unique(entries_.begin(), entries_.end(),
+                               [this](const Entry& lhs, const Entry& rhs) {
+                                   return lhs.marker == rhs.marker && key(lhs) == key(rhs);
+                               }),
+                   entries_.end());
+
+    // Lay keys out again in sorted order: duplicates are dropped and lookups scan memory sequentially
+    Bytes arena;
+    arena.reserve(arena_.size());
+    heads_.clear();
+    marked_.clear();
+    std::vector<Entry> entries;
+    entries.reserve(entries_.size());
+    entries.swap(entries_);
+    for (const auto& entry : entries) {
+        const ByteView item_key{key(entry)};
+        if (entry.marker) {
+            marked_.push_back(entries_.size());
+        }
+        heads_.push_back(head_of(item_key));
+        entries_.push_back({.offset = arena.size(), .length = entry.length, .marker = entry.marker});
+        arena.append(item_key);
     }
+    arena_.swap(arena);
+    sorted_size_ = entries_.size();
+    index_ = 0;
 }
 
 }  // namespace silkworm::trie
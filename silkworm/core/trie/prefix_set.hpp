@@ -25,6 +25,9 @@ namespace silkworm::trie {
 //! \brief A set of "nibbled" byte strings with the following property:
 /// If x ∈ S and x starts with y, then y ∈ S.
 /// Corresponds to RetainList in Erigon.
+/// Keys are laid out contiguously in an arena (in sorted order once sorted) and referenced by compact entries.
+/// Entries form a sorted and unique run followed by a tail of unsorted insertions which is sorted and merged
+/// into the run when the set is queried, so that insertions in increasing order never need sorting.
 class PrefixSet {
   public:
     //! \brief Constructs an empty set.
@@ -49,21 +52,46 @@ class PrefixSet {
     //! of identical bytes
     std::pair<bool, ByteView> contains_and_next_marked(ByteView prefix, size_t invariant_prefix_len = 0);
 
-    [[nodiscard]] size_t size() const { return keys_.size(); }
-    [[nodiscard]] bool empty() const { return keys_.empty(); }
+    //! \brief Returns a new set holding the keys beginning with prefix (e.g. the storage locations of a contract)
+    //! \remarks Not marked const for the same reason as contains()
+    PrefixSet subset(ByteView prefix);
+
+    [[nodiscard]] size_t size() const { return entries_.size(); }
+    [[nodiscard]] bool empty() const { return entries_.empty(); }
 
     void clear() noexcept {
-        keys_.clear();
+        arena_.clear();
+        entries_.clear();
+        heads_.clear();
+        marked_.clear();
+        sorted_size_ = 0;
         index_ = 0;
-        sorted_ = false;
     }
 
   private:
+    struct Entry {
+        size_t offset{0};    // Position of the key in arena_
+        uint32_t length{0};  // Length of the key
+        bool marker{false};  // Whether the key has been newly created
+    };
+
+    [[nodiscard]] ByteView key(const Entry& entry) const { return {arena_.data() + entry.offset, entry.length}; }
+    [[nodiscard]] bool less(const Entry& lhs, const Entry& rhs) const;
+
+    //! \brief Appends an entry to the sorted run (it must not precede the last one)
+    void append_sorted(const Entry& entry);
+
     void ensure_sorted();
 
-    std::vector<std::pair<Bytes, bool>> keys_;  // Collection of nibbled keys with marker of newly created
-    size_t index_{0};                           // Index of last compared key
-    bool sorted_{false};                        // Whether nibbled_keys_ has been unique-ed and sorted
+    //! \brief Moves index_ forward past the keys which surely precede prefix, comparing their heads only
+    void skip_lower(ByteView prefix);
+
+    Bytes arena_;                  // Keys laid out one after another
+    std::vector<Entry> entries_;   // Sorted and unique entries in [0, sorted_size_) followed by unsorted ones
+    std::vector<uint64_t> heads_;  // Leading 8 bytes (big endian, zero padded) of the keys in the sorted run
+    std::vector<size_t> marked_;   // Indices of marked entries in the sorted run
+    size_t sorted_size_{0};        // Number of entries in the sorted run
+    size_t index_{0};              // Index of last compared key
 };
 
 }  // namespace silkworm::trie
@@ -16,6 +16,8 @@
 
 #include "prefix_set.hpp"
 
+#include <set>
+
 #include <catch2/catch.hpp>
 
 #include <silkworm/core/common/cast.hpp>
@@ -108,4 +110,86 @@ TEST_CASE("Prefix set - storage prefix") {
     }
 }
 
+TEST_CASE("Prefix set - subset") {
+    Bytes prefix1{*from_hex("0x00000c28401f2ddfc4ffb8231a088e59b082343dcf32292deb61832480c3f4f50000000000000001")};
+    Bytes prefix2{*from_hex("0x00000c28401f2ddfc4ffb8231a088e59b082343dcf32292deb61832480c3f4f50000000000000002")};
+    PrefixSet ps;
+    CHECK(ps.subset(prefix1).empty());
+
+    for (const auto& prefix : {prefix2, prefix1}) {
+        for (const auto& [key, marker] : {std::pair{"ab", false}, std::pair{"abd", true}, std::pair{"fg", false}}) {
+            Bytes prefixed{prefix};
+            prefixed.append(string_view_to_byte_view(key));
+            ps.insert(prefixed, marker);
+        }
+    }
+
+    PrefixSet subset{ps.subset(prefix1)};
+    REQUIRE(subset.size() == 3);
+
+    Bytes key1{prefix1};
+    key1.append(string_view_to_byte_view("ab"));
+    auto [contains, next_created]{subset.contains_and_next_marked(key1, prefix1.length())};
+    CHECK(contains);
+    CHECK(next_created == ByteView{Bytes{prefix1}.append(string_view_to_byte_view("abd"))});
+    CHECK(subset.contains(prefix1));
+    CHECK(!subset.contains(prefix2));
+
+    CHECK(ps.subset(prefix2).size() == 3);
+    CHECK(ps.subset(Bytes{prefix1}.append(string_view_to_byte_view("f"))).size() == 1);
+    CHECK(ps.subset(*from_hex("0x01")).empty());
+}
+
+TEST_CASE("Prefix set - sorted runs") {
+    // Nibbled keys of varying lengths inserted partly in order and partly shuffled
+    std::vector<Bytes> keys;
+    for (uint8_t i{0}; i < 16; ++i) {
+        for (uint8_t j{0}; j < 16; ++j) {
+            for (uint8_t k{0}; k < 16; k += 3) {
+                keys.push_back(Bytes{i, j, k, static_cast<uint8_t>((i + j) % 16), 0x0a, 0x0b, 0x0c, 0x0d, 0x0e});
+            }
+        }
+    }
+
+    PrefixSet ps;
+    std::set<Bytes> expected;
+    for (size_t i{0}; i < keys.size(); i += 2) {
+        ps.insert(keys[i]);  // increasing order
+        expected.insert(keys[i]);
+    }
+    CHECK(ps.contains(keys[0]));
+    CHECK(!ps.contains(keys[1]));
+
+    for (size_t i{keys.size() - 1}; i < keys.size(); i -= 2) {
+        ps.insert(keys[i], /*marker=*/i % 7 == 0);  // decreasing order
+        ps.insert(keys[i], /*marker=*/i % 7 == 0);  // duplicate
+        expected.insert(keys[i]);
+    }
+
+    // Increasing and sparse lookups
+    for (uint8_t i{0}; i < 16; ++i) {
+        for (uint8_t j{0}; j < 16; j += 5) {
+            const Bytes prefix{i, j};
+            const auto it{expected.lower_bound(prefix)};
+            CHECK(ps.contains(prefix) == (it != expected.end() && it->starts_with(prefix)));
+            const Bytes missing{i, j, 0x01};
+            CHECK(!ps.contains(missing));
+        }
+    }
+    CHECK(ps.size() == expected.size());
+
+    for (size_t i{0}; i < keys.size(); i += 41) {
+        auto [contains, next_created]{ps.contains_and_next_marked(keys[i])};
+        CHECK(contains);
+        size_t next{i};
+        while (next < keys.size() && !(next % 2 && next % 7 == 0)) {
+            ++next;
+        }
+        CHECK(next_created == (next < keys.size() ? ByteView{keys[next]} : ByteView{}));
+    }
+
+    CHECK(!ps.contains(Bytes{0x10}));
+    CHECK(ps.contains(Bytes{}));
+}
+
 }  // namespace silkworm::trie
@@ -419,6 +419,131 @@ namespace rlp {
         return {};
     }
 
+    // Skips the next count items of an RLP list
+    static DecodingResult skip_items(ByteView& from, size_t count) noexcept {
+        for (size_t i{0}; i < count; ++i) {
+            const auto h{decode_header(from)};
+            if (!h) {
+                return tl::unexpected{h.error()};
+            }
+            if (from.length() < h->payload_length) {
+                return tl::unexpected{DecodingError::kInputTooShort};
+            }
+            from.remove_prefix(h->payload_length);
+        }
+        return {};
+    }
+
+    DecodingResult decode_transaction_signature(ByteView from, TransactionSignature& to, Bytes& signing_payload,
+                                                Eip2718Wrapping allowed) noexcept {
+        if (from.empty()) {
+            return tl::unexpected{DecodingError::kInputTooShort};
+        }
+
+        if (0 < from[0] && from[0] < kEmptyStringCode) {  // Raw serialization of a typed transaction
+            if (allowed == Eip2718Wrapping::kString) {
+                return tl::unexpected{DecodingError::kUnexpectedEip2718Serialization};
+            }
+            to.type = static_cast<Transaction::Type>(from[0]);
+            from.remove_prefix(1);
+        } else {
+            const auto h{decode_header(from)};
+            if (!h) {
+                return tl::unexpected{h.error()};
+            }
+            if (h->list) {  // Legacy transaction
+                to.type = Transaction::Type::kLegacy;
+                if (from.length() != h->payload_length) {
+                    return tl::unexpected{DecodingError::kListLengthMismatch};
+                }
+            } else {  // String-wrapped typed transaction
+                if (allowed == Eip2718Wrapping::kNone) {
+                    return tl::unexpected{DecodingError::kUnexpectedEip2718Serialization};
+                }
+                if (h->payload_length == 0) {
+                    return tl::unexpected{DecodingError::kInputTooShort};
+                }
+                to.type = static_cast<Transaction::Type>(from[0]);
+                from.remove_prefix(1);
+            }
+        }
+
+        if (to.type != Transaction::Type::kLegacy) {
+            if (to.type != Transaction::Type::kEip2930 && to.type != Transaction::Type::kEip1559) {
+                return tl::unexpected{DecodingError::kUnsupportedTransactionType};
+            }
+            const auto h{decode_header(from)};
+            if (!h) {
+                return tl::unexpected{h.error()};
+            }
+            if (!h->list) {
+                return tl::unexpected{DecodingError::kUnexpectedString};
+            }
+            if (from.length() != h->payload_length) {
+                return tl::unexpected{DecodingError::kListLengthMismatch};
+            }
+        }
+
+        // Locate the unsigned fields and decode the signature after them
+        const ByteView fields{from};
+        if (to.type != Transaction::Type::kLegacy) {
+            intx::uint256 chain_id;
+            if (DecodingResult res{decode(from, chain_id)}; !res) {
+                return res;
+            }
+            to.chain_id = chain_id;
+        }
+        const size_t num_fields{to.type == Transaction::Type::kLegacy ? 6u : (to.type == Transaction::Type::kEip2930 ? 7u : 8u)};
+        if (DecodingResult res{skip_items(from, num_fields)}; !res) {
+            return res;
+        }
+        const ByteView unsigned_fields{fields.substr(0, fields.length() - from.length())};
+
+        if (to.type == Transaction::Type::kLegacy) {
+            intx::uint256 v;
+            if (DecodingResult res{decode(from, v)}; !res) {
+                return res;
+            }
+            const std::optional<YParityAndChainId> parity_and_id{v_to_y_parity_and_chain_id(v)};
+            if (!parity_and_id) {
+                return tl::unexpected{DecodingError::kInvalidVInSignature};
+            }
+            to.odd_y_parity = parity_and_id->odd;
+            to.chain_id = parity_and_id->chain_id;
+        } else if (DecodingResult res{decode(from, to.odd_y_parity)}; !res) {
+            return res;
+        }
+        if (DecodingResult res{decode(from, to.r)}; !res) {
+            return res;
+        }
+        if (DecodingResult res{decode(from, to.s)}; !res) {
+            return res;
+        }
+        if (!from.empty()) {
+            return tl::unexpected{DecodingError::kListLengthMismatch};
+        }
+
+        // Same as encode with for_signing=true
+        if (to.type == Transaction::Type::kLegacy) {
+            Header h{true, unsigned_fields.length()};
+            if (to.chain_id) {
+                h.payload_length += length(*to.chain_id) + 2;
+            }
+            encode_header(signing_payload, h);
+            signing_payload.append(unsigned_fields);
+            if (to.chain_id) {
+                encode(signing_payload, *to.chain_id);
+                encode(signing_payload, 0u);
+                encode(signing_payload, 0u);
+            }
+        } else {
+            signing_payload.push_back(static_cast<uint8_t>(to.type));
+            encode_header(signing_payload, {true, unsigned_fields.length()});
+            signing_payload.append(unsigned_fields);
+        }
+        return {};
+    }
+
 }  // namespace rlp
 
 void Transaction::recover_sender() {
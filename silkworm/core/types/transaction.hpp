@@ -79,6 +79,14 @@ struct Transaction {
 
 bool operator==(const Transaction& a, const Transaction& b);
 
+//! \brief The signature of a serialized transaction, i.e. what's needed to validate it and recover the sender
+struct TransactionSignature {
+    Transaction::Type type{Transaction::Type::kLegacy};
+    bool odd_y_parity{false};                             // EIP-155
+    std::optional<intx::uint256> chain_id{std::nullopt};  // EIP-155
+    intx::uint256 r{0}, s{0};
+};
+
 namespace rlp {
     size_t length(const AccessListEntry&);
     size_t length(const Transaction&);
@@ -114,6 +122,12 @@ namespace rlp {
     }
 
     DecodingResult decode_transaction_header_and_type(ByteView& from, Header& header, Transaction::Type& type) noexcept;
+
+    //! \brief Decodes the signature of a serialized transaction and appends to signing_payload the serialization the
+    //! signature has been computed over (see encode with for_signing=true).
+    //! \remarks The unsigned fields are copied as they are, instead of being decoded and encoded again
+    DecodingResult decode_transaction_signature(ByteView from, TransactionSignature& to, Bytes& signing_payload,
+                                                Eip2718Wrapping accepted_typed_txn_wrapping) noexcept;
 }  // namespace rlp
 
 }  // namespace silkworm
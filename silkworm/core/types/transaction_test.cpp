@@ -194,4 +194,71 @@ TEST_CASE("Recover sender 2") {
     CHECK(txn.from == 0xa1e4380a3b1f749673e270229993ee55f35663b4_address);
 }
 
+TEST_CASE("Transaction signature decoding") {
+    Transaction txn{
+        Transaction::Type::kLegacy,                                                                              // type
+        1,                                                                                                       // nonce
+        50'000 * kGiga,                                                                                          // max_priority_fee_per_gas
+        50'000 * kGiga,                                                                                          // max_fee_per_gas
+        21'750,                                                                                                  // gas_limit
+        0xc9d4035f4a9226d50f79b73aafb5d874a1b6537e_address,                                                      // to
+        31337,                                                                                                   // value
+        *from_hex("0x74796d3474406469676978"),                                                                   // data
+        true,                                                                                                    // odd_y_parity
+        std::nullopt,                                                                                            // chain_id
+        intx::from_string<intx::uint256>("0x1c48defe76d367bb92b4fc0628aca42a4d8037062865635d955673e57eddfbfa"),  // r
+        intx::from_string<intx::uint256>("0x65f766849f97b15f01d0877636fbed0fa4e39f8834896c0354f56ac44dcb50a6"),  // s
+    };
+
+    const auto check_signature{[&](rlp::Eip2718Wrapping wrapping) {
+        Bytes encoded;
+        rlp::encode(encoded, txn, /*for_signing=*/false, wrapping != rlp::Eip2718Wrapping::kNone);
+        Bytes expected_payload;
+        rlp::encode(expected_payload, txn, /*for_signing=*/true, /*wrap_eip2718_into_string=*/false);
+
+        // Payloads are appended
+        Bytes signing_payload{*from_hex("0xcafe")};
+        TransactionSignature signature;
+        REQUIRE(rlp::decode_transaction_signature(encoded, signature, signing_payload, wrapping));
+        CHECK(signing_payload == *from_hex("0xcafe") + expected_payload);
+        CHECK(signature.type == txn.type);
+        CHECK(signature.odd_y_parity == txn.odd_y_parity);
+        CHECK(signature.chain_id == txn.chain_id);
+        CHECK(signature.r == txn.r);
+        CHECK(signature.s == txn.s);
+
+        // Truncated serialization
+        encoded.pop_back();
+        CHECK_FALSE(rlp::decode_transaction_signature(encoded, signature, signing_payload, wrapping));
+    }};
+
+    SECTION("legacy") {
+        check_signature(rlp::Eip2718Wrapping::kString);
+    }
+
+    SECTION("legacy with chain id") {
+        txn.chain_id = 1;
+        check_signature(rlp::Eip2718Wrapping::kString);
+    }
+
+    SECTION("EIP-2930") {
+        txn.type = Transaction::Type::kEip2930;
+        txn.chain_id = 5;
+        txn.odd_y_parity = false;
+        txn.access_list = access_list;
+        check_signature(rlp::Eip2718Wrapping::kString);
+        check_signature(rlp::Eip2718Wrapping::kNone);
+    }
+
+    SECTION("EIP-1559") {
+        txn.type = Transaction::Type::kEip1559;
+        txn.chain_id = 5;
+        txn.max_priority_fee_per_gas = 10 * kGiga;
+        txn.to = std::nullopt;
+        txn.access_list = access_list;
+        check_signature(rlp::Eip2718Wrapping::kString);
+        check_signature(rlp::Eip2718Wrapping::kBoth);
+    }
+}
+
 }  // namespace silkworm
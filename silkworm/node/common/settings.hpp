@@ -40,7 +40,7 @@ struct NodeSettings {
     db::EnvConfig chaindata_env_config{};                  // Chaindata db config
     uint64_t network_id{kMainnetConfig.chain_id};          // Network/Chain id
     std::optional<ChainConfig> chain_config;               // Chain config
-    size_t batch_size{512_Mebi};                           // Batch size to use in stages
+    size_t batch_size{512_Mebi};                           // Batch size for Senders and Index stages (not Execution)
     size_t etl_buffer_size{256_Mebi};                      // Buffer size for ETL operations
     std::string private_api_addr{"127.0.0.1:9090"};        // Default API listener
     std::string sentry_api_addr{};                         // Default bind address of sentry api
@@ -50,6 +50,8 @@ struct NodeSettings {
     std::unique_ptr<db::PruneMode> prune_mode;             // Prune mode
     uint32_t sync_loop_throttle_seconds{0};                // Minimum interval amongst sync cycle
     uint32_t sync_loop_log_interval_seconds{30};           // Interval for sync loop to emit logs
+    uint32_t execution_workers{0};                         // Threads executing the txs of a block (0 = sequential)
+    size_t execution_memory_budget{0};                     // Memory taken by Execution batches (0 = 1/4 of RAM)
 };
 
 }  // namespace silkworm
@@ -24,6 +24,7 @@
 #include <silkworm/node/common/decoding_exception.hpp>
 #include <silkworm/node/db/bitmap.hpp>
 #include <silkworm/node/db/tables.hpp>
+#include <silkworm/node/snapshot/repository.hpp>
 
 namespace silkworm::db {
 
@@ -817,4 +818,98 @@ uint64_t reset_map_sequence(RWTxn& txn, const char* map_name, uint64_t new_seque
     return current_sequence;
 }
 
+void DataModel::set_snapshot_repository(SnapshotRepository* repository) {
+    repository_ = repository;
+}
+
+std::optional<BlockHeader> DataModel::read_header(BlockNum block_number, const evmc::bytes32& block_hash) const {
+    if (is_frozen(block_number)) {
+        auto header{read_header_from_snapshot(block_number)};
+        if (header && header->hash() == block_hash) {
+            return header;
+        }
+    }
+    return db::read_header(txn_, block_number, block_hash);
+}
+
+std::optional<BlockHeader> DataModel::read_header(const evmc::bytes32& block_hash) const {
+    // Table kHeaderNumbers is filled in also for frozen blocks, so use it if possible
+    const auto block_number{read_block_number(txn_, block_hash)};
+    if (block_number) {
+        return read_header(*block_number, block_hash);
+    }
+    return repository_ ? repository_->find_header_by_hash(block_hash) : std::nullopt;
+}
+
+std::optional<BlockHeader> DataModel::read_canonical_header(BlockNum block_number) const {
+    if (is_frozen(block_number)) {
+        return read_header_from_snapshot(block_number);
+    }
+    return db::read_canonical_header(txn_, block_number);
+}
+
+bool DataModel::read_body(BlockNum block_number, const evmc::bytes32& block_hash, bool read_senders,
+                          BlockBody& body) const {
+    if (is_frozen(block_number)) {
+        return read_body_from_snapshot(block_number, read_senders, body);
+    }
+    return db::read_body(txn_, block_number, block_hash.bytes, read_senders, body);
+}
+
+bool DataModel::read_block(BlockNum block_number, const evmc::bytes32& block_hash, bool read_senders,
+                           Block& block) const {
+    if (is_frozen(block_number)) {
+        auto header{read_header_from_snapshot(block_number)};
+        if (!header || header->hash() != block_hash) {
+            return false;
+        }
+        block.header = std::move(*header);
+        return read_body_from_snapshot(block_number, read_senders, block);
+    }
+    return db::read_block(txn_, std::span<const uint8_t, kHashLength>{block_hash.bytes}, block_number, read_senders,
+                          block);
+}
+
+bool DataModel::read_block(BlockNum block_number, bool read_senders, Block& block) const {
+    if (is_frozen(block_number)) {
+        auto header{read_header_from_snapshot(block_number)};
+        if (!header) {
+            return false;
+        }
+        block.header = std::move(*header);
+        return read_body_from_snapshot(block_number, read_senders, block);
+    }
+    return db::read_block_by_number(txn_, block_number, read_senders, block);
+}
+
+bool DataModel::is_frozen(BlockNum block_number) {
+    return repository_ && block_number < repository_->max_block_available();
+}
+
+std::optional<BlockHeader> DataModel::read_header_from_snapshot(BlockNum block_number) {
+    const auto* header_snapshot{repository_->find_header_segment(block_number)};
+    if (!header_snapshot) {
+        return std::nullopt;
+    }
+    return header_snapshot->header_by_number(block_number);
+}
+
+bool DataModel::read_body_from_snapshot(BlockNum block_number, bool read_senders, BlockBody& body) {
+    const auto* body_snapshot{repository_->find_body_segment(block_number)};
+    if (!body_snapshot) {
+        return false;
+    }
+    auto stored_body{body_snapshot->body_by_number(block_number)};
+    if (!stored_body) {
+        return false;
+    }
+    const auto* tx_snapshot{repository_->find_tx_segment(block_number)};
+    if (!tx_snapshot) {
+        return false;
+    }
+    std::swap(body.ommers, stored_body->ommers);
+    body.transactions = tx_snapshot->txn_range(stored_body->base_txn_id, stored_body->txn_count, read_senders);
+    return true;
+}
+
 }  // namespace silkworm::db
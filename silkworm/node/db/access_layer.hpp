@@ -30,6 +30,10 @@
 #include <silkworm/node/db/mdbx.hpp>
 #include <silkworm/node/db/util.hpp>
 
+namespace silkworm {
+class SnapshotRepository;
+}  // namespace silkworm
+
 namespace silkworm::db {
 
 //! \brief Pulls database schema version
@@ -212,4 +216,47 @@ uint64_t read_map_sequence(ROTxn& txn, const char* map_name);
 //! committed
 uint64_t reset_map_sequence(RWTxn& txn, const char* map_name, uint64_t new_sequence);
 
+//! \brief Read access to chain blocks whether they are frozen in snapshots or stored in db
+//! \details Blocks having number lower than SnapshotRepository::max_block_available() are read from snapshot segments
+//! using their indexes, all the others are read from db
+class DataModel {
+  public:
+    //! \brief Sets the snapshot repository used by all instances (nullptr means no snapshots)
+    //! \remarks Must be called before any instance is used, snapshot reads are thread-safe afterwards
+    static void set_snapshot_repository(SnapshotRepository* repository);
+
+    explicit DataModel(ROTxn& txn) : txn_{txn} {}
+
+    //! \brief Reads a header with the specified block number and hash
+    [[nodiscard]] std::optional<BlockHeader> read_header(BlockNum block_number, const evmc::bytes32& block_hash) const;
+
+    //! \brief Reads a header with the specified hash
+    [[nodiscard]] std::optional<BlockHeader> read_header(const evmc::bytes32& block_hash) const;
+
+    //! \brief Reads the canonical header with the specified block number
+    [[nodiscard]] std::optional<BlockHeader> read_canonical_header(BlockNum block_number) const;
+
+    //! \brief Reads a block body with the specified block number and hash
+    //! \remarks Snapshots contain canonical blocks only, so the hash is not checked for frozen blocks
+    [[nodiscard]] bool read_body(BlockNum block_number, const evmc::bytes32& block_hash, bool read_senders,
+                                 BlockBody& body) const;
+
+    //! \brief Reads a block with the specified block number and hash
+    [[nodiscard]] bool read_block(BlockNum block_number, const evmc::bytes32& block_hash, bool read_senders,
+                                  Block& block) const;
+
+    //! \brief Reads the canonical block with the specified block number
+    [[nodiscard]] bool read_block(BlockNum block_number, bool read_senders, Block& block) const;
+
+  private:
+    [[nodiscard]] static bool is_frozen(BlockNum block_number);
+
+    static std::optional<BlockHeader> read_header_from_snapshot(BlockNum block_number);
+    static bool read_body_from_snapshot(BlockNum block_number, bool read_senders, BlockBody& body);
+
+    static inline SnapshotRepository* repository_{nullptr};
+
+    ROTxn& txn_;
+};
+
 }  // namespace silkworm::db
@@ -527,6 +527,34 @@ namespace db {
             REQUIRE(h == header.hash());
         }
 
+        SECTION("DataModel without snapshots") {
+            DataModel data_model{txn};
+            Block block;
+            CHECK(!data_model.read_block(block_num, /*read_senders=*/false, block));
+
+            BlockBody body{sample_block_body()};
+            CHECK_NOTHROW(write_body(txn, body, hash.bytes, header.number));
+
+            const auto block_hash{header.hash()};
+            CHECK(data_model.read_header(block_num, block_hash) == header);
+            CHECK(data_model.read_header(block_hash) == header);
+            CHECK(data_model.read_canonical_header(block_num) == header);
+
+            BlockBody body_from_db;
+            REQUIRE(data_model.read_body(block_num, block_hash, /*read_senders=*/false, body_from_db));
+            CHECK(body_from_db.ommers == body.ommers);
+            CHECK(body_from_db.transactions == body.transactions);
+
+            REQUIRE(data_model.read_block(block_num, /*read_senders=*/false, block));
+            CHECK(block.header == header);
+            CHECK(block.transactions == body.transactions);
+
+            Block block_by_hash;
+            REQUIRE(data_model.read_block(block_num, block_hash, /*read_senders=*/false, block_by_hash));
+            CHECK(block_by_hash.header == header);
+            CHECK(block_by_hash.transactions == body.transactions);
+        }
+
         SECTION("process_blocks_at_height") {
             BlockNum height = header.number;
 
@@ -16,6 +16,8 @@
 
 #include "bitmap.hpp"
 
+#include <bit>
+#include <cstring>
 #include <stdexcept>
 
 #include <silkworm/core/common/cast.hpp>
@@ -24,6 +26,31 @@
 
 namespace silkworm::db::bitmap {
 
+// Splits a bitmap into shards not exceeding size_limit visiting its values once and in order
+template <class F>
+static void split_in_shards(const roaring::Roaring64Map& bitmap, uint64_t size_limit, F on_shard) {
+    roaring::Roaring64Map shard;
+    for (const uint64_t value : bitmap) {
+        shard.add(value);
+        if (shard.getSizeInBytes() <= size_limit) {
+            continue;
+        }
+        shard.runOptimize();
+        if (shard.getSizeInBytes() <= size_limit) {
+            continue;
+        }
+        shard.remove(value);
+        shard.runOptimize();
+        on_shard(shard, /*last=*/false);
+        shard = roaring::Roaring64Map();
+        shard.add(value);
+    }
+    if (!shard.isEmpty()) {
+        shard.runOptimize();
+        on_shard(shard, /*last=*/true);
+    }
+}
+
 void IndexLoader::merge_bitmaps(RWTxn& txn, size_t key_size, etl::Collector* bitmaps_collector) {
     const Bytes last_shard_suffix{db::block_key(UINT64_MAX)};
     const size_t optimal_shard_size{
@@ -42,24 +69,35 @@ void IndexLoader::merge_bitmaps(RWTxn& txn, size_t key_size, etl::Collector* bit
                 .append(last_shard_suffix)};                    /* and append const suffix for last key */
 
         if (auto index_data{index_cursor.find(db::to_slice(shard_key), /*throw_notfound=*/false)}; index_data.done) {
-            // Merge previous and current bitmap
-            new_bitmap |= db::bitmap::parse(index_data.value);
-            index_cursor.erase();  // Delete currently found record as it'll be rewritten
+            const ByteView last_shard{db::from_slice(index_data.value)};
+            const auto last_shard_max{maximum(last_shard)};
+            if (last_shard_max && *last_shard_max < new_bitmap.minimum() && 2 * last_shard.size() >= optimal_shard_size) {
+                // Appending to a shard at least half full: seal it under its upper bound as it is, without decoding
+                Bytes sealed_shard{last_shard};
+                index_cursor.erase();
+                endian::store_big_u64(&shard_key[shard_key.size() - sizeof(BlockNum)], *last_shard_max);
+                mdbx::slice k{db::to_slice(shard_key)};
+                mdbx::slice v{db::to_slice(sealed_shard)};
+                mdbx::error::success_or_throw(index_cursor.put(k, &v, put_flags));
+            } else {
+                // Merge previous and current bitmap
+                new_bitmap |= db::bitmap::parse(index_data.value);
+                index_cursor.erase();  // Delete currently found record as it'll be rewritten
+            }
         }
 
         // Consume bitmap splitting in shards
-        while (!new_bitmap.isEmpty()) {
-            auto shard{db::bitmap::cut_left(new_bitmap, optimal_shard_size)};
-            const BlockNum suffix{new_bitmap.isEmpty() /* consumed to last chunk */ ? UINT64_MAX
-                                                                                    : shard.maximum()};
+        split_in_shards(new_bitmap, optimal_shard_size, [&](roaring::Roaring64Map& shard, bool last) {
+            const BlockNum suffix{last ? UINT64_MAX : shard.maximum()};
             endian::store_big_u64(&shard_key[shard_key.size() - sizeof(BlockNum)], suffix);
             Bytes shard_bytes{db::bitmap::to_bytes(shard)};
             mdbx::slice k{db::to_slice(shard_key)};
             mdbx::slice v{db::to_slice(shard_bytes)};
             mdbx::error::success_or_throw(index_cursor.put(k, &v, put_flags));
-        }
+        });
     }};
 
+    bitmaps_collector->set_merge_partitions(etl::kLargeLoadMergePartitions);
     bitmaps_collector->load(target,
                             load_func,
                             target.empty() ? MDBX_put_flags_t::MDBX_APPEND : MDBX_put_flags_t::MDBX_UPSERT);
@@ -253,4 +291,127 @@ roaring::Roaring64Map parse(const mdbx::slice& data) {
 roaring::Roaring64Map parse(const ByteView data) {
     return roaring::Roaring64Map::readSafe(byte_ptr_cast(&data[0]), data.size());
 }
+
+namespace {
+    // See https://github.com/RoaringBitmap/RoaringFormatSpec
+    constexpr uint32_t kSerialCookieNoRunContainer{12346};
+    constexpr uint16_t kSerialCookie{12347};
+    constexpr size_t kNoOffsetThreshold{4};
+    constexpr size_t kMaxArrayContainerCardinality{4096};
+    constexpr size_t kBitmapContainerSize{8192};
+
+    template <class T>
+    bool read_le(ByteView& data, T& value) {
+        if (data.size() < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, data.data(), sizeof(T));  // Roaring64Map serialization is in host byte order
+        data.remove_prefix(sizeof(T));
+        return true;
+    }
+
+    // Walks a 32-bit bitmap in portable format returning its maximum, if not empty, and skipping it in data
+    bool skip_roaring32(ByteView& data, std::optional<uint32_t>& max) {
+        max.reset();
+        const ByteView serialized{data};
+        uint32_t cookie{0};
+        if (!read_le(data, cookie)) {
+            return false;
+        }
+        uint32_t num_containers{0};
+        ByteView run_flags;
+        if ((cookie & 0xFFFF) == kSerialCookie) {
+            num_containers = (cookie >> 16) + 1;
+            const size_t run_flags_size{(num_containers + 7) / 8};
+            if (data.size() < run_flags_size) {
+                return false;
+            }
+            run_flags = data.substr(0, run_flags_size);
+            data.remove_prefix(run_flags_size);
+        } else if (cookie != kSerialCookieNoRunContainer || !read_le(data, num_containers)) {
+            return false;
+        }
+        if (data.size() < num_containers * 2 * sizeof(uint16_t)) {
+            return false;
+        }
+        const ByteView descriptive_header{data.substr(0, num_containers * 2 * sizeof(uint16_t))};
+        data.remove_prefix(descriptive_header.size());
+        if (run_flags.empty() || num_containers >= kNoOffsetThreshold) {
+            if (data.size() < num_containers * sizeof(uint32_t)) {
+                return false;
+            }
+            data.remove_prefix(num_containers * sizeof(uint32_t));
+        }
+
+        // Containers are walked in sequence as run ones have variable size
+        for (uint32_t i{0}; i < num_containers; ++i) {
+            uint16_t key{0}, cardinality_minus_one{0};
+            std::memcpy(&key, &descriptive_header[i * 2 * sizeof(uint16_t)], sizeof(uint16_t));
+            std::memcpy(&cardinality_minus_one, &descriptive_header[i * 2 * sizeof(uint16_t) + sizeof(uint16_t)],
+                        sizeof(uint16_t));
+            const bool is_last{i + 1 == num_containers};
+            uint32_t low{0};
+            if (!run_flags.empty() && (run_flags[i / 8] & (1u << (i % 8)))) {
+                uint16_t num_runs{0};
+                if (!read_le(data, num_runs) || data.size() < num_runs * 2u * sizeof(uint16_t) || !num_runs) {
+                    return false;
+                }
+                uint16_t start{0}, length_minus_one{0};
+                std::memcpy(&start, &data[(num_runs - 1u) * 2 * sizeof(uint16_t)], sizeof(uint16_t));
+                std::memcpy(&length_minus_one, &data[(num_runs - 1u) * 2 * sizeof(uint16_t) + sizeof(uint16_t)],
+                            sizeof(uint16_t));
+                low = static_cast<uint32_t>(start) + length_minus_one;
+                data.remove_prefix(num_runs * 2u * sizeof(uint16_t));
+            } else if (cardinality_minus_one < kMaxArrayContainerCardinality) {
+                const size_t container_size{(cardinality_minus_one + 1u) * sizeof(uint16_t)};
+                if (data.size() < container_size) {
+                    return false;
+                }
+                uint16_t last_value{0};
+                std::memcpy(&last_value, &data[container_size - sizeof(uint16_t)], sizeof(uint16_t));
+                low = last_value;
+                data.remove_prefix(container_size);
+            } else {
+                if (data.size() < kBitmapContainerSize) {
+                    return false;
+                }
+                if (is_last) {
+                    // Scan words backwards for the highest bit set
+                    for (size_t w{kBitmapContainerSize / sizeof(uint64_t)}; w > 0; --w) {
+                        uint64_t word{0};
+                        std::memcpy(&word, &data[(w - 1) * sizeof(uint64_t)], sizeof(uint64_t));
+                        if (word) {
+                            low = static_cast<uint32_t>((w - 1) * 64 + 63 - static_cast<size_t>(std::countl_zero(word)));
+                            break;
+                        }
+                    }
+                }
+                data.remove_prefix(kBitmapContainerSize);
+            }
+            if (is_last) {
+                max = (static_cast<uint32_t>(key) << 16) | low;
+            }
+        }
+        return serialized.size() > data.size();
+    }
+}  // namespace
+
+std::optional<uint64_t> maximum(ByteView data) {
+    uint64_t num_maps{0};
+    if (!read_le(data, num_maps)) {
+        return std::nullopt;
+    }
+    std::optional<uint64_t> max;
+    for (uint64_t i{0}; i < num_maps; ++i) {
+        uint32_t high{0};
+        std::optional<uint32_t> map_max;
+        if (!read_le(data, high) || !skip_roaring32(data, map_max)) {
+            return std::nullopt;
+        }
+        if (map_max) {
+            max = (static_cast<uint64_t>(high) << 32) | *map_max;
+        }
+    }
+    return data.empty() ? max : std::nullopt;
+}
 }  // namespace silkworm::db::bitmap
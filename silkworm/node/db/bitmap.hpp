@@ -16,7 +16,12 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <optional>
+#include <utility>
+#include <vector>
 
 #include <absl/container/btree_map.h>
 
@@ -29,11 +34,20 @@
 #include <boost/functional/hash.hpp>
 
 #include <silkworm/core/common/base.hpp>
+#include <silkworm/core/common/endian.hpp>
 #include <silkworm/node/db/mdbx.hpp>
 #include <silkworm/node/etl/collector.hpp>
 
 namespace silkworm::db::bitmap {
 
+//! \brief Bitmaps of block numbers by fixed size key (e.g. an address or an address and a storage location)
+template <size_t N>
+using KeyedBitmaps = absl::btree_map<std::array<uint8_t, N>, roaring::Roaring64Map>;
+
+//! \brief Pairs of key and block number bitmaps are built from
+template <size_t N>
+using KeyedBlockNums = std::vector<std::pair<std::array<uint8_t, N>, BlockNum>>;
+
 class IndexLoader {
   public:
     explicit IndexLoader(const db::MapConfig& index_config) : index_config_{index_config} {}
@@ -73,6 +87,10 @@ class IndexLoader {
     static void flush_bitmaps_to_etl(absl::btree_map<Bytes, roaring::Roaring64Map>& bitmaps,
                                      etl::Collector* collector, uint16_t flush_count);
 
+    //! \brief Same as above for bitmaps keyed by fixed size keys
+    template <size_t N>
+    static void flush_bitmaps_to_etl(KeyedBitmaps<N>& bitmaps, etl::Collector* collector, uint16_t flush_count);
+
   private:
     const db::MapConfig& index_config_;  // The bucket config holding the index of maps
     mutable std::mutex log_mtx_;         // To get progress status
@@ -96,6 +114,61 @@ Bytes to_bytes(roaring::Roaring64Map& bitmap);
 //! \brief Returns Roaring64Map from MDBX's slice;
 roaring::Roaring64Map parse(const mdbx::slice& data);
 
+//! \brief Returns the maximum value of a serialized Roaring64Map without deserializing it
+//! \return std::nullopt if the bitmap is empty or the serialization is not recognized
+std::optional<uint64_t> maximum(ByteView data);
+
+//! \brief Builds the bitmaps of block numbers of each key
+//! \param entries [in] : The pairs of key and block number (gets sorted)
+//! \remarks Sorting first allows to add block numbers in bulk and to append keys to the map
+template <size_t N>
+KeyedBitmaps<N> build(KeyedBlockNums<N>& entries) {
+    std::sort(entries.begin(), entries.end());
+    KeyedBitmaps<N> bitmaps;
+    std::vector<uint64_t> block_nums;
+    for (auto it{entries.begin()}; it != entries.end();) {
+        block_nums.clear();
+        auto run_it{it};
+        for (; run_it != entries.end() && run_it->first == it->first; ++run_it) {
+            block_nums.push_back(run_it->second);
+        }
+        auto& bitmap{bitmaps.emplace_hint(bitmaps.end(), it->first, roaring::Roaring64Map())->second};
+        bitmap.addMany(block_nums.size(), block_nums.data());
+        it = run_it;
+    }
+    return bitmaps;
+}
+
+//! \brief Merges source bitmaps into target ones
+//! \return The estimated amount of memory added to target
+template <size_t N>
+size_t merge(KeyedBitmaps<N>& target, KeyedBitmaps<N>&& source) {
+    size_t added{0};
+    for (auto& [key, bitmap] : source) {
+        added += static_cast<size_t>(bitmap.cardinality()) * sizeof(uint32_t);  // All blocks <= UINT32_MAX
+        auto [it, inserted]{target.try_emplace(key)};
+        if (inserted) {
+            it->second = std::move(bitmap);
+            added += N + sizeof(uint64_t);  // see Roaring64Map()::getSizeInBytes()
+        } else {
+            it->second |= bitmap;
+        }
+    }
+    source.clear();
+    return added;
+}
+
+template <size_t N>
+void IndexLoader::flush_bitmaps_to_etl(KeyedBitmaps<N>& bitmaps, etl::Collector* collector, uint16_t flush_count) {
+    Bytes etl_key(N + sizeof(uint16_t), '\0');
+    endian::store_big_u16(&etl_key[N], flush_count);
+    for (auto& [key, bitmap] : bitmaps) {
+        std::memcpy(etl_key.data(), key.data(), N);
+        collector->collect({etl_key, to_bytes(bitmap)});
+    }
+    bitmaps.clear();
+}
+
 //! \brief Returns Roaring64Map from Bytes/Byteview;
 roaring::Roaring64Map parse(const ByteView data);
 
@@ -212,4 +212,133 @@ TEST_CASE("Bitmap Index Loader") {
     REQUIRE(bm_loader.get_current_key().empty());
 }
 
+static std::vector<uint64_t> to_vector(const roaring::Roaring64Map& bitmap) {
+    std::vector<uint64_t> values(bitmap.cardinality());
+    bitmap.toUint64Array(values.data());
+    return values;
+}
+
+TEST_CASE("Keyed bitmaps") {
+    using Key = std::array<uint8_t, kAddressLength>;
+    Key key1{}, key2{}, key3{};
+    key1[kAddressLength - 1] = 1;
+    key2[kAddressLength - 1] = 2;
+    key3[kAddressLength - 1] = 3;
+
+    // Shards of (key, block number) pairs collected out of order
+    KeyedBlockNums<kAddressLength> shard1{{key2, 12}, {key1, 10}, {key2, 11}, {key1, 10}};
+    KeyedBlockNums<kAddressLength> shard2{{key3, 21}, {key2, 20}};
+
+    auto bitmaps{build(shard1)};
+    REQUIRE(bitmaps.size() == 2);
+    CHECK(bitmaps.begin()->first == key1);
+    CHECK(to_vector(bitmaps[key1]) == std::vector<uint64_t>{10});
+    CHECK(to_vector(bitmaps[key2]) == std::vector<uint64_t>{11, 12});
+
+    const size_t added{merge(bitmaps, build(shard2))};
+    CHECK(added == 2 * sizeof(uint32_t) + kAddressLength + sizeof(uint64_t));
+    REQUIRE(bitmaps.size() == 3);
+    CHECK(to_vector(bitmaps[key2]) == std::vector<uint64_t>{11, 12, 20});
+    CHECK(to_vector(bitmaps[key3]) == std::vector<uint64_t>{21});
+
+    test::Context context;
+    etl::Collector collector(context.node_settings().data_directory->etl().path());
+    IndexLoader::flush_bitmaps_to_etl(bitmaps, &collector, /*flush_count=*/1);
+    CHECK(bitmaps.empty());
+    CHECK(collector.size() == 3);
+}
+
+TEST_CASE("Maximum of serialized bitmaps") {
+    roaring::Roaring64Map bitmap;
+    CHECK_FALSE(maximum(to_bytes(bitmap)).has_value());
+
+    SECTION("array containers") {
+        bitmap.add(10u);
+        bitmap.add(70'000u);
+    }
+
+    SECTION("run container") {
+        bitmap = roaring::Roaring64Map{roaring::api::roaring_bitmap_from_range(1, 100'001, 1)};
+        bitmap.runOptimize();
+    }
+
+    SECTION("bitmap container") {
+        for (uint64_t i{0}; i < 20'000; i += 2) {
+            bitmap.add(i);
+        }
+        bitmap.runOptimize();
+    }
+
+    SECTION("mixed containers") {
+        bitmap = roaring::Roaring64Map{roaring::api::roaring_bitmap_from_range(1, 10'001, 1)};
+        for (uint64_t i{70'000}; i < 90'000; i += 3) {
+            bitmap.add(i);
+        }
+        bitmap.add(200'000u);
+        bitmap.runOptimize();
+    }
+
+    SECTION("high bits") {
+        bitmap.add(10u);
+        bitmap.add((uint64_t{5} << 32) + 7);
+    }
+
+    const Bytes serialized{to_bytes(bitmap)};
+    REQUIRE(maximum(serialized) == bitmap.maximum());
+    CHECK_FALSE(maximum(ByteView{serialized}.substr(0, serialized.size() - 1)).has_value());
+}
+
+TEST_CASE("Bitmap Index Loader appends to last shard") {
+    test::Context context;
+    db::RWTxn& txn{context.rw_txn()};
+
+    const auto address{0x00000000000000000001_address};
+    const Bytes key(address.bytes, kAddressLength);
+    roaring::Roaring64Map expected;
+
+    db::bitmap::IndexLoader bm_loader(db::table::kLogAddressIndex);
+    const auto load{[&](uint64_t from, uint64_t to, uint64_t step) {
+        roaring::Roaring64Map bitmap;
+        for (uint64_t i{from}; i < to; i += step) {
+            bitmap.add(i);
+        }
+        expected |= bitmap;
+        absl::btree_map<Bytes, roaring::Roaring64Map> bitmaps{{key, bitmap}};
+        etl::Collector collector(context.node_settings().data_directory->etl().path());
+        IndexLoader::flush_bitmaps_to_etl(bitmaps, &collector, /*flush_count=*/0);
+        bm_loader.merge_bitmaps(txn, kAddressLength, &collector);
+    }};
+
+    const auto check_shards{[&]() {
+        const size_t optimal_shard_size{
+            db::max_value_size_for_leaf_page(*txn, kAddressLength + sizeof(uint64_t))};
+        roaring::Roaring64Map loaded;
+        uint64_t previous_max{0};
+        PooledCursor log_addresses(txn, table::kLogAddressIndex);
+        auto data{log_addresses.lower_bound(db::to_slice(key), /*throw_notfound=*/false)};
+        for (; data.done; data = log_addresses.to_next(/*throw_notfound=*/false)) {
+            const ByteView shard_key{db::from_slice(data.key)};
+            REQUIRE(shard_key.substr(0, kAddressLength) == key);
+            CHECK(data.value.length() <= optimal_shard_size);
+            const auto shard{parse(data.value)};
+            CHECK(shard.minimum() > previous_max);
+            previous_max = shard.maximum();
+            const uint64_t suffix{endian::load_big_u64(&shard_key[kAddressLength])};
+            CHECK((suffix == UINT64_MAX || suffix == shard.maximum()));
+            loaded |= shard;
+        }
+        CHECK(loaded == expected);
+    }};
+
+    // Several full shards and a last one
+    load(1, 30'000, 3);
+    check_shards();
+
+    // Appended values
+    load(30'000, 30'010, 1);
+    check_shards();
+    load(40'000, 45'000, 2);
+    check_shards();
+}
+
 }  // namespace silkworm::db::bitmap
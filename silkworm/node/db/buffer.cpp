@@ -17,9 +17,10 @@
 #include "buffer.hpp"
 
 #include <algorithm>
+#include <future>
 #include <stdexcept>
-
-#include <absl/container/btree_set.h>
+#include <utility>
+#include <vector>
 
 #include <silkworm/core/common/endian.hpp>
 #include <silkworm/node/common/log.hpp>
@@ -31,6 +32,21 @@
 
 namespace silkworm::db {
 
+namespace {
+
+    // Approximate memory taken by an entry of a flat hash map (slot and control byte at max load factor)
+    template <class Map>
+    constexpr size_t kFlatMapEntrySize{(sizeof(typename Map::value_type) + 1) * 8 / 7};
+
+    // Approximate memory taken by an entry of a b-tree map (nodes being 3/4 full on average)
+    template <class Map>
+    constexpr size_t kBTreeMapEntrySize{sizeof(typename Map::value_type) * 4 / 3};
+
+    // Memory taken on heap by a byte string beyond its small string buffer
+    size_t heap_size(const Bytes& bytes) { return bytes.capacity() > Bytes{}.capacity() ? bytes.capacity() : 0; }
+
+}  // namespace
+
 void Buffer::begin_block(uint64_t block_number) {
     block_number_ = block_number;
     changed_storage_.clear();
@@ -54,9 +70,11 @@ void Buffer::update_account(const evmc::address& address, std::optional<Account>
             encoded_initial = initial->encode_for_storage(omit_code_hash);
         }
 
-        size_t payload_size{block_account_changes_.contains(block_number_) ? 0 : sizeof(BlockNum)};
+        size_t payload_size{block_account_changes_.contains(block_number_)
+                                ? 0
+                                : kBTreeMapEntrySize<decltype(block_account_changes_)>};
         if (block_account_changes_[block_number_].insert_or_assign(address, encoded_initial).second) {
-            payload_size += kAddressLength + encoded_initial.length();
+            payload_size += kBTreeMapEntrySize<AccountChanges> + heap_size(encoded_initial);
         }
         batch_history_size_ += payload_size;
     }
@@ -64,19 +82,13 @@ void Buffer::update_account(const evmc::address& address, std::optional<Account>
     if (equal) {
         return;
     }
-    auto it{accounts_.find(address)};
-    if (it != accounts_.end()) {
-        batch_state_size_ -= it->second.has_value() ? sizeof(Account) : 0;
-        batch_state_size_ += (current ? sizeof(Account) : 0);
-        it->second = current;
-    } else {
-        batch_state_size_ += kAddressLength + (current ? sizeof(Account) : 0);
-        accounts_[address] = current;
+    if (accounts_.insert_or_assign(address, current).second) {
+        batch_state_size_ += kFlatMapEntrySize<decltype(accounts_)>;
     }
 
     if (account_deleted && initial->incarnation) {
         if (incarnations_.insert_or_assign(address, initial->incarnation).second) {
-            batch_state_size_ += kAddressLength + kIncarnationLength;
+            batch_state_size_ += kBTreeMapEntrySize<decltype(incarnations_)>;
         }
     }
 }
@@ -86,14 +98,31 @@ void Buffer::update_account_code(const evmc::address& address, uint64_t incarnat
     // Don't overwrite already existing code so that views of it
     // that were previously returned by read_code() are still valid.
     if (hash_to_code_.try_emplace(code_hash, code).second) {
-        batch_state_size_ += kHashLength + code.length();
+        batch_state_size_ += kBTreeMapEntrySize<decltype(hash_to_code_)> + code.length();
     }
 
     if (storage_prefix_to_code_hash_.insert_or_assign(storage_prefix(address, incarnation), code_hash).second) {
-        batch_state_size_ += kPlainStoragePrefixLength + kHashLength;
+        batch_state_size_ += kBTreeMapEntrySize<decltype(storage_prefix_to_code_hash_)> + kPlainStoragePrefixLength;
     }
 }
 
+size_t Buffer::cache_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location,
+                             const evmc::bytes32& value) const {
+    size_t added_size{0};
+    auto [it1, new_address]{storage_.try_emplace(address)};
+    if (new_address) {
+        added_size += kFlatMapEntrySize<decltype(storage_)>;
+    }
+    auto [it2, new_incarnation]{it1->second.try_emplace(incarnation)};
+    if (new_incarnation) {
+        added_size += kBTreeMapEntrySize<decltype(storage_)::mapped_type>;
+    }
+    if (it2->second.insert_or_assign(location, value).second) {
+        added_size += kFlatMapEntrySize<decltype(storage_)::mapped_type::mapped_type>;
+    }
+    return added_size;
+}
+
 void Buffer::update_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location,
                             const evmc::bytes32& initial, const evmc::bytes32& current) {
     if (current == initial) {
@@ -105,13 +134,13 @@ void Buffer::update_storage(const evmc::address& address, uint64_t incarnation,
         if (block_storage_changes_[block_number_][address][incarnation]
                 .insert_or_assign(location, initial_val)
                 .second) {
-            batch_history_size_ += kPlainStoragePrefixLength + kHashLength + initial_val.size();
+            // Entry of the innermost map only: outer ones are shared by many locations
+            batch_history_size_ += kBTreeMapEntrySize<StorageChanges::mapped_type::mapped_type> +
+                                   (initial_val.size() > Bytes{}.capacity() ? initial_val.size() : 0);
         }
     }
 
-    if (storage_[address][incarnation].insert_or_assign(location, current).second) {
-        batch_state_size_ += kPlainStoragePrefixLength + kHashLength + kHashLength;
-    }
+    batch_state_size_ += cache_storage(address, incarnation, location, current);
 }
 
 void Buffer::write_history_to_db() {
@@ -223,6 +252,157 @@ void Buffer::write_history_to_db() {
               {"size", human_size(total_written_size), "in", StopWatch::format(sw.since_start(finish_time))});
 }
 
+namespace {
+
+    //! \brief Changed storage of a contract incarnation sorted by location
+    struct StorageRun {
+        Bytes prefix;  // Address + incarnation
+        std::vector<std::pair<evmc::bytes32, evmc::bytes32>> slots;
+    };
+
+    //! \brief Changes of an address in PlainState order: account first then storage by incarnation
+    struct AddressRun {
+        evmc::address address;
+        bool account_changed{false};
+        Bytes account;  // Encoded for storage (empty if deleted)
+        std::vector<StorageRun> storage;
+    };
+
+    //! \brief Moves the changes of accounts and storage out of the maps into runs sorted by PlainState key
+    template <class Accounts, class Storage>
+    std::vector<AddressRun> sorted_state_runs(Accounts& accounts, Storage& storage) {
+        std::vector<AddressRun> runs;
+        runs.reserve(accounts.size() + storage.size());
+        for (const auto& [address, account] : accounts) {
+            runs.push_back({.address = address,
+                            .account_changed = true,
+                            .account = account ? account->encode_for_storage() : Bytes{}});
+        }
+        accounts.clear();
+        for (const auto& [address, _] : storage) {
+            runs.push_back({.address = address});
+        }
+        std::sort(runs.begin(), runs.end(), [](const AddressRun& lhs, const AddressRun& rhs) {
+            return lhs.address == rhs.address ? lhs.account_changed > rhs.account_changed
+                                              : lhs.address < rhs.address;
+        });
+        // An address with changes of both account and storage has the account run first: merge them
+        runs.erase(std::unique(runs.begin(), runs.end(),
+                               [](const AddressRun& lhs, const AddressRun& rhs) { return lhs.address == rhs.address; }),
+                   runs.end());
+
+        for (auto& run : runs) {
+            auto it{storage.find(run.address)};
+            if (it == storage.end()) {
+                continue;
+            }
+            for (const auto& [incarnation, contract_storage] : it->second) {
+                StorageRun& storage_run{run.storage.emplace_back()};
+                storage_run.prefix = storage_prefix(run.address, incarnation);
+                storage_run.slots.assign(contract_storage.begin(), contract_storage.end());
+                std::sort(storage_run.slots.begin(), storage_run.slots.end(),
+                          [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+            }
+            storage.erase(it);
+        }
+        return runs;
+    }
+
+    //! \brief Writes changes into PlainState in key order, positioning the cursor the least possible.
+    //! \remarks Keys greater than the last one in table when writing begins are appended with no lookup
+    //! (MDBX_APPEND and MDBX_APPENDDUP). Otherwise values unchanged in table are not written again to avoid dirtying
+    //! pages and a lookup of the storage of a contract is skipped once there are no greater locations in table
+    class PlainStateWriter {
+      public:
+        explicit PlainStateWriter(mdbx::cursor& cursor) : cursor_{cursor} {
+            if (const auto last{cursor_.to_last(/*throw_notfound=*/false)}; last) {
+                last_key_.assign(from_slice(last.key));
+            } else {
+                appending_ = true;
+            }
+        }
+
+        //! \return The size of written data
+        size_t write(const AddressRun& run) {
+            size_t written_size{0};
+            if (run.account_changed) {
+                written_size += write_account(run.address, run.account);
+            }
+            for (const auto& storage_run : run.storage) {
+                written_size += write_storage(storage_run);
+            }
+            return written_size;
+        }
+
+      private:
+        bool appending(ByteView key) {
+            appending_ = appending_ || key > ByteView{last_key_};
+            return appending_;
+        }
+
+        size_t write_account(const evmc::address& address, ByteView encoded) {
+            const auto key{to_slice(address)};
+            if (appending(address)) {
+                if (!encoded.empty()) {
+                    mdbx::slice value{to_slice(encoded)};
+                    mdbx::error::success_or_throw(cursor_.put(key, &value, MDBX_APPEND));
+                }
+            } else {
+                if (const auto data{cursor_.find(key, /*throw_notfound=*/false)}; data) {
+                    if (!encoded.empty() && from_slice(data.value) == encoded) {
+                        return 0;  // Unchanged
+                    }
+                    cursor_.erase(/*whole_multivalue=*/true);  // PlainState is multivalue
+                }
+                if (!encoded.empty()) {
+                    cursor_.upsert(key, to_slice(encoded));
+                }
+            }
+            return encoded.empty() ? 0 : kAddressLength + encoded.length();
+        }
+
+        size_t write_storage(const StorageRun& run) {
+            const auto key{to_slice(run.prefix)};
+            const bool append{appending(run.prefix)};
+            bool past_last_location{append};  // Whether no greater location exists in table
+            size_t written_size{0};
+            Bytes value;
+            for (const auto& [location, current] : run.slots) {
+                const ByteView new_value{zeroless_view(current)};
+                if (!past_last_location) {
+                    const auto location_slice{to_slice(location)};
+                    const auto data{cursor_.lower_bound_multivalue(key, location_slice, /*throw_notfound=*/false)};
+                    if (!data) {
+                        past_last_location = true;
+                    } else if (data.value.starts_with(location_slice)) {
+                        if (from_slice(data.value).substr(kHashLength) == new_value) {
+                            continue;  // Unchanged
+                        }
+                        cursor_.erase();
+                    }
+                }
+                if (new_value.empty()) {
+                    continue;
+                }
+                value.assign(location.bytes, kHashLength).append(new_value);
+                if (append) {
+                    mdbx::slice value_slice{to_slice(value)};
+                    mdbx::error::success_or_throw(cursor_.put(key, &value_slice, MDBX_APPENDDUP));
+                } else {
+                    cursor_.upsert(key, to_slice(value));
+                }
+                written_size += run.prefix.length() + value.length();
+            }
+            return written_size;
+        }
+
+        mdbx::cursor& cursor_;
+        Bytes last_key_;         // Last key in table when writing began
+        bool appending_{false};  // Whether keys being written are past last_key_
+    };
+
+}  // namespace
+
 void Buffer::write_state_to_db() {
     /*
      * ENSURE PlainState updates are Last !!!
@@ -237,6 +417,9 @@ void Buffer::write_state_to_db() {
     StopWatch sw;
     sw.start();
 
+    // Accounts and storage are sorted on a separate thread while smaller tables are written
+    auto state_runs{std::async(std::launch::async, [this]() { return sorted_state_runs(accounts_, storage_); })};
+
     if (!incarnations_.empty()) {
         auto incarnation_table{db::open_cursor(txn_, table::kIncarnationMap)};
         Bytes data(kIncarnationLength, '\0');
@@ -284,43 +467,17 @@ void Buffer::write_state_to_db() {
         written_size = 0;
     }
 
-    // Extract sorted index of unique addresses before inserting into the DB
-    absl::btree_set<evmc::address> addresses;
-    for (auto& x : accounts_) {
-        addresses.insert(x.first);
-    }
-    for (auto& x : storage_) {
-        addresses.insert(x.first);
-    }
-
+    std::vector<AddressRun> runs{state_runs.get()};
     if (should_trace) {
         auto [_, duration]{sw.lap()};
-        log::Trace("Sorted addresses", {"in", StopWatch::format(duration)});
+        log::Trace("Sorted accounts and storage", {"in", StopWatch::format(duration)});
     }
 
     auto state_table{db::open_cursor(txn_, table::kPlainState)};
-    for (const auto& address : addresses) {
-        if (auto it{accounts_.find(address)}; it != accounts_.end()) {
-            auto key{to_slice(address)};
-            state_table.erase(key, /*whole_multivalue=*/true);  // PlainState is multivalue
-            if (it->second.has_value()) {
-                Bytes encoded{it->second->encode_for_storage()};
-                state_table.upsert(key, to_slice(encoded));
-                written_size += kAddressLength + encoded.length();
-            }
-            accounts_.erase(it);
-        }
-
-        if (auto it{storage_.find(address)}; it != storage_.end()) {
-            for (const auto& [incarnation, contract_storage] : it->second) {
-                Bytes prefix{storage_prefix(address, incarnation)};
-                for (const auto& [location, value] : contract_storage) {
-                    upsert_storage_value(state_table, prefix, location, value);
-                    written_size += prefix.length() + kLocationLength + kHashLength;
-                }
-            }
-            storage_.erase(it);
-        }
+    PlainStateWriter writer{state_table};
+    for (auto& run : runs) {
+        written_size += writer.write(run);
+        run = {};  // Release memory as soon as possible
     }
     total_written_size += written_size;
     if (should_trace) {
@@ -354,15 +511,18 @@ void Buffer::insert_receipts(uint64_t block_number, const std::vector<Receipt>&
         Bytes key{log_key(block_number, i)};
         Bytes value{cbor_encode(receipts[i].logs)};
 
-        if (logs_.insert_or_assign(key, value).second) {
-            batch_history_size_ += key.size() + value.size();
+        const size_t entry_size{kBTreeMapEntrySize<decltype(logs_)> + heap_size(key) + heap_size(value)};
+        if (logs_.insert_or_assign(std::move(key), std::move(value)).second) {
+            batch_history_size_ += entry_size;
         }
     }
 
     Bytes key{block_key(block_number)};
     Bytes value{cbor_encode(receipts)};
-    receipts_[key] = value;
-    batch_history_size_ += key.size() + value.size();
+    const size_t entry_size{kBTreeMapEntrySize<decltype(receipts_)> + heap_size(key) + heap_size(value)};
+    if (receipts_.insert_or_assign(std::move(key), std::move(value)).second) {
+        batch_history_size_ += entry_size;
+    }
 }
 
 evmc::bytes32 Buffer::state_root_hash() const {
@@ -414,7 +574,7 @@ std::optional<BlockHeader> Buffer::read_header(uint64_t block_number, const evmc
     if (auto it{headers_.find(key)}; it != headers_.end()) {
         return it->second;
     }
-    return db::read_header(txn_, key);
+    return data_model_.read_header(block_number, block_hash);
 }
 
 bool Buffer::read_body(uint64_t block_number, const evmc::bytes32& block_hash, BlockBody& body) const noexcept {
@@ -423,7 +583,7 @@ bool Buffer::read_body(uint64_t block_number, const evmc::bytes32& block_hash, B
         body = it->second;
         return true;
     }
-    return db::read_body(txn_, key, /*read_senders=*/false, body);
+    return data_model_.read_body(block_number, block_hash, /*read_senders=*/false, body);
 }
 
 std::optional<Account> Buffer::read_account(const evmc::address& address) const noexcept {
@@ -432,7 +592,7 @@ std::optional<Account> Buffer::read_account(const evmc::address& address) const
     }
     auto db_account{db::read_account(txn_, address, historical_block_)};
     accounts_[address] = db_account;
-    batch_state_size_ += kAddressLength + db_account.value_or(Account()).encoding_length_for_storage();
+    batch_state_size_ += kFlatMapEntrySize<decltype(accounts_)>;
     return db_account;
 }
 
@@ -450,19 +610,15 @@ ByteView Buffer::read_code(const evmc::bytes32& code_hash) const noexcept {
 
 evmc::bytes32 Buffer::read_storage(const evmc::address& address, uint64_t incarnation,
                                    const evmc::bytes32& location) const noexcept {
-    size_t payload_length{kAddressLength + kIncarnationLength + kLocationLength + kHashLength};
     if (auto it1{storage_.find(address)}; it1 != storage_.end()) {
-        payload_length -= kAddressLength;
         if (auto it2{it1->second.find(incarnation)}; it2 != it1->second.end()) {
-            payload_length -= kIncarnationLength;
             if (auto it3{it2->second.find(location)}; it3 != it2->second.end()) {
                 return it3->second;
             }
         }
     }
     auto db_storage{db::read_storage(txn_, address, incarnation, location, historical_block_)};
-    storage_[address][incarnation][location] = db_storage;
-    batch_state_size_ += payload_length;
+    batch_state_size_ += cache_storage(address, incarnation, location, db_storage);
     return db_storage;
 }
 
@@ -28,6 +28,7 @@
 #include <silkworm/core/types/account.hpp>
 #include <silkworm/core/types/block.hpp>
 #include <silkworm/core/types/receipt.hpp>
+#include <silkworm/node/db/access_layer.hpp>
 #include <silkworm/node/db/mdbx.hpp>
 #include <silkworm/node/db/util.hpp>
 
@@ -38,7 +39,10 @@ class Buffer : public State {
     // txn must be valid (its handle != nullptr)
     explicit Buffer(ROTxn& txn, BlockNum prune_history_threshold,
                     std::optional<BlockNum> historical_block = std::nullopt)
-        : txn_{txn}, prune_history_threshold_{prune_history_threshold}, historical_block_{historical_block} {}
+        : txn_{txn},
+          data_model_{txn},
+          prune_history_threshold_{prune_history_threshold},
+          historical_block_{historical_block} {}
 
     /** @name Readers */
     ///@{
@@ -111,10 +115,10 @@ class Buffer : public State {
         return block_storage_changes_;
     }
 
-    //! \brief Approximate size of accrued state in bytes.
+    //! \brief Memory taken by accrued state in bytes (estimated including the overhead of containers)
     [[nodiscard]] size_t current_batch_state_size() const noexcept { return batch_state_size_; }
 
-    //! \brief Approximate size of accrued history in bytes.
+    //! \brief Memory taken by accrued history in bytes (estimated including the overhead of containers)
     [[nodiscard]] size_t current_batch_history_size() const noexcept { return batch_history_size_; }
 
     //! \brief Persists *all* accrued contents into db
@@ -128,7 +132,13 @@ class Buffer : public State {
     //! \brief Persists *state* accrued contents into db
     void write_state_to_db();
 
+    //! \brief Sets the value of a storage location in memory
+    //! \return The amount of memory taken by new map entries
+    size_t cache_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location,
+                         const evmc::bytes32& value) const;
+
     ROTxn& txn_;
+    DataModel data_model_;  // Headers and bodies of frozen blocks are found in snapshots only
     uint64_t prune_history_threshold_;
     std::optional<uint64_t> historical_block_{};
 
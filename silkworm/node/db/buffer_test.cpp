@@ -19,6 +19,7 @@
 
 #include <silkworm/core/common/endian.hpp>
 #include <silkworm/node/common/test_context.hpp>
+#include <silkworm/node/db/access_layer.hpp>
 #include <silkworm/node/db/buffer.hpp>
 #include <silkworm/node/db/tables.hpp>
 #include <silkworm/node/test/log.hpp>
@@ -154,4 +155,63 @@ TEST_CASE("Account update") {
     }
 }
 
+TEST_CASE("Sorted state writes") {
+    test::SetLogVerbosityGuard log_guard{log::Level::kNone};
+    test::Context context;
+    auto& txn{context.rw_txn()};
+
+    const auto address1{0x1000000000000000000000000000000000000000_address};
+    const auto address2{0x2000000000000000000000000000000000000000_address};
+    const auto address3{0x3000000000000000000000000000000000000000_address};  // Past last key in table
+    const Bytes key2{storage_prefix(address2, kDefaultIncarnation)};
+    const Bytes key3{storage_prefix(address3, kDefaultIncarnation)};
+
+    const auto location1{0x0000000000000000000000000000000000000000000000000000000000000001_bytes32};
+    const auto location2{0x0000000000000000000000000000000000000000000000000000000000000002_bytes32};
+    const auto location3{0x0000000000000000000000000000000000000000000000000000000000000003_bytes32};
+    const auto location4{0x0000000000000000000000000000000000000000000000000000000000000004_bytes32};
+    const auto value1{0x00000000000000000000000000000000000000000000000000000000000000a1_bytes32};
+    const auto value2{0x00000000000000000000000000000000000000000000000000000000000000a2_bytes32};
+
+    Account contract;
+    contract.incarnation = kDefaultIncarnation;
+    contract.code_hash = to_bytes32(keccak256(address2.bytes).bytes);  // Just a fake hash
+
+    auto state{db::open_cursor(txn, table::kPlainState)};
+    const Bytes encoded{contract.encode_for_storage()};
+    state.upsert(to_slice(address2), to_slice(encoded));
+    upsert_storage_value(state, key2, location1, value1);
+    upsert_storage_value(state, key2, location2, value1);
+    upsert_storage_value(state, key2, location3, value1);
+
+    Account eoa;
+    eoa.balance = kEther;
+    Account changed_contract{contract};
+    changed_contract.nonce = 1;
+
+    Buffer buffer{txn, 0};
+    buffer.begin_block(1);
+    buffer.update_account(address1, /*initial=*/std::nullopt, eoa);
+    buffer.update_account(address3, /*initial=*/std::nullopt, contract);
+    buffer.update_account(address2, /*initial=*/contract, changed_contract);
+    buffer.update_storage(address2, kDefaultIncarnation, location4, /*initial=*/{}, /*current=*/value2);
+    buffer.update_storage(address2, kDefaultIncarnation, location2, /*initial=*/value1, /*current=*/{});
+    buffer.update_storage(address2, kDefaultIncarnation, location1, /*initial=*/value1, /*current=*/value2);
+    buffer.update_storage(address3, kDefaultIncarnation, location3, /*initial=*/{}, /*current=*/value2);
+    buffer.update_storage(address3, kDefaultIncarnation, location1, /*initial=*/{}, /*current=*/value1);
+    REQUIRE_NOTHROW(buffer.write_to_db());
+
+    CHECK(read_account(txn, address1) == eoa);
+    CHECK(read_account(txn, address2) == changed_contract);
+    CHECK(read_account(txn, address3) == contract);
+
+    CHECK(find_value_suffix(state, key2, location1) == zeroless_view(value2));
+    CHECK(!find_value_suffix(state, key2, location2));
+    CHECK(find_value_suffix(state, key2, location3) == zeroless_view(value1));
+    CHECK(find_value_suffix(state, key2, location4) == zeroless_view(value2));
+    CHECK(find_value_suffix(state, key3, location1) == zeroless_view(value1));
+    CHECK(find_value_suffix(state, key3, location3) == zeroless_view(value2));
+    CHECK(txn->get_map_stat(state.map()).ms_entries == 3 + 3 + 2);
+}
+
 }  // namespace silkworm::db
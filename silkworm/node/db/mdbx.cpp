@@ -16,7 +16,9 @@
 
 #include "mdbx.hpp"
 
+#include <algorithm>
 #include <stdexcept>
+#include <thread>
 
 namespace silkworm::db {
 
@@ -290,6 +292,15 @@ bool has_map(::mdbx::txn& tx, const char* map_name) {
     }
 }
 
+bool is_committed(const ::mdbx::txn& tx) {
+    return !tx.is_readonly() && tx.get_info().txn_space_dirty == 0;
+}
+
+uint32_t max_parallel_readers(const ::mdbx::env& env) {
+    const auto reader_slots{static_cast<uint32_t>(env.max_readers())};
+    return std::max(std::min({std::thread::hardware_concurrency(), kMaxParallelReaders, reader_slots / 4}), 1u);
+}
+
 size_t cursor_for_each(::mdbx::cursor& cursor, WalkFuncRef walker, const CursorMoveDirection direction) {
     size_t ret{0};
     auto data{adjust_cursor_position_if_unpositioned(cursor, direction)};
@@ -92,6 +92,7 @@ class RWTxn : public ROTxn {
 
     void disable_commit() { commit_disabled_ = true; }
     void enable_commit() { commit_disabled_ = false; }
+    [[nodiscard]] bool commit_disabled() const { return commit_disabled_; }
 
     void commit(const bool renew = true) {
         /*
@@ -257,6 +258,21 @@ class PooledCursor : public ::mdbx::cursor {
 //! \return True / False
 bool has_map(::mdbx::txn& tx, const char* map_name);
 
+//! \brief Checks whether all changes made in a transaction are visible to other transactions (i.e. are committed)
+//! \param [in] tx : a reference to a valid mdbx transaction
+//! \return True if tx is a read-write transaction with no pending changes
+//! \remarks A read-only transaction may lag behind the last committed one, hence it is never deemed committed
+bool is_committed(const ::mdbx::txn& tx);
+
+//! \brief Max number of read-only transactions opened at once by the workers of a single task
+//! \remarks Keeps most reader slots (see EnvConfig::max_readers) free for RPC, prefetchers and other tasks
+inline constexpr uint32_t kMaxParallelReaders{16};
+
+//! \brief Computes how many workers of a task may read concurrently each through its own read-only transaction
+//! \param [in] env : a reference to a valid mdbx environment
+//! \return The number of hardware threads capped by kMaxParallelReaders and by a quarter of env reader slots (at least 1)
+uint32_t max_parallel_readers(const ::mdbx::env& env);
+
 //! \brief Builds the full path to mdbx datafile provided a directory
 //! \param [in] base_path : a reference to the directory holding the data file
 //! \return A path with file name
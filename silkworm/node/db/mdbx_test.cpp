@@ -14,6 +14,7 @@
    limitations under the License.
 */
 
+#include <algorithm>
 #include <atomic>
 #include <map>
 #include <thread>
@@ -241,6 +242,26 @@ TEST_CASE("RWTxn") {
         REQUIRE(db::has_map(tx2, table_name) == false);
     }
 
+    SECTION("is_committed") {
+        {
+            auto ro_tx{env.start_read()};
+            CHECK_FALSE(db::is_committed(ro_tx));
+        }
+        RWTxn tx{env};
+        CHECK(db::is_committed(*tx));
+        db::PooledCursor table_cursor(tx, {table_name});
+        table_cursor.upsert(mdbx::slice{"AAA"}, mdbx::slice{"Lysine"});
+        CHECK_FALSE(db::is_committed(*tx));
+        tx.commit();
+        CHECK(db::is_committed(*tx));
+
+        tx.disable_commit();
+        table_cursor.bind(tx, {table_name});
+        table_cursor.upsert(mdbx::slice{"AAC"}, mdbx::slice{"Asparagine"});
+        tx.commit();  // Does not have any effect
+        CHECK_FALSE(db::is_committed(*tx));
+    }
+
     SECTION("Cursor from RWTxn") {
         auto tx{db::RWTxn(env)};
         db::PooledCursor table_cursor(tx, {table_name});
@@ -251,6 +272,18 @@ TEST_CASE("RWTxn") {
     }
 }
 
+TEST_CASE("max_parallel_readers") {
+    const TemporaryDirectory tmp_dir;
+    db::EnvConfig db_config{tmp_dir.path().string(), /*create*/ true};
+    db_config.in_memory = true;
+    auto env{db::open_env(db_config)};
+
+    const auto readers{db::max_parallel_readers(env)};
+    CHECK(readers >= 1);
+    CHECK(readers <= db::kMaxParallelReaders);
+    CHECK(readers <= std::max(static_cast<uint32_t>(env.max_readers()) / 4, 1u));
+}
+
 TEST_CASE("Cursor walk") {
     const TemporaryDirectory tmp_dir;
     db::EnvConfig db_config{tmp_dir.path().string(), /*create*/ true};
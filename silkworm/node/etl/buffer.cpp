@@ -0,0 +1,167 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "buffer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <exception>
+#include <functional>
+#include <future>
+#include <thread>
+
+#include <silkworm/core/common/endian.hpp>
+#include <silkworm/node/concurrency/thread_pool.hpp>
+
+namespace silkworm::etl {
+
+namespace {
+
+    //! Threads sorting buffer slices, shared by all buffers so that concurrent flushes (e.g. of the collectors owned
+    //! by parallel workers) never run more sorting threads than the hardware ones
+    thread_pool& sort_workers() {
+        static thread_pool workers;
+        return workers;
+    }
+
+    //! Runs the jobs on the sort workers and waits for all of them, then rethrows the first failure if any
+    void run_on_sort_workers(const std::vector<std::function<void()>>& jobs) {
+        std::vector<std::future<bool>> futures;
+        std::exception_ptr exception;
+        try {
+            futures.reserve(jobs.size());
+            for (const auto& job : jobs) {
+                futures.push_back(sort_workers().submit(job));
+            }
+        } catch (...) {
+            exception = std::current_exception();
+        }
+        for (auto& future : futures) {
+            try {
+                future.get();
+            } catch (...) {
+                if (!exception) exception = std::current_exception();
+            }
+        }
+        if (exception) std::rethrow_exception(exception);
+    }
+
+}  // namespace
+
+void Buffer::put(ByteView key, ByteView value) {
+    // Add a new entry to the buffer
+    size_ += key.size() + value.size() + sizeof(head_t);
+    if (records_.empty()) {
+        key_size_ = key.size();
+    } else if (key.size() != key_size_) {
+        fixed_key_size_ = false;
+    }
+
+    uint64_t key_prefix{0};
+    if (key.size() >= sizeof(uint64_t)) {
+        key_prefix = endian::load_big_u64(key.data());
+    } else {
+        for (size_t i{0}; i < sizeof(uint64_t); ++i) {
+            key_prefix = (key_prefix << 8) | (i < key.size() ? key[i] : 0u);
+        }
+    }
+    records_.push_back({key_prefix, arena_.size(), static_cast<uint32_t>(key.size()),
+                        static_cast<uint32_t>(value.size())});
+    arena_.append(key);
+    arena_.append(value);
+}
+
+void Buffer::sort() {
+    if (fixed_key_size_ && records_.size() >= kMinRadixSortSize) {
+        radix_sort();
+    } else {
+        comparison_sort(records_.begin(), records_.end());
+    }
+}
+
+void Buffer::radix_sort() {
+    // Histograms of each byte of key prefixes (byte 0 is the least significant)
+    std::array<std::array<size_t, 256>, sizeof(uint64_t)> counts{};
+    for (const auto& record : records_) {
+        for (size_t byte{0}; byte < sizeof(uint64_t); ++byte) {
+            ++counts[byte][(record.key_prefix >> (8 * byte)) & 0xff];
+        }
+    }
+
+    // Least significant digit first: each pass is stable hence preserves the order given by previous ones
+    std::vector<Record> sorted(records_.size());
+    for (size_t byte{0}; byte < sizeof(uint64_t); ++byte) {
+        auto& count{counts[byte]};
+        if (count[(records_.front().key_prefix >> (8 * byte)) & 0xff] == records_.size()) {
+            continue;  // Same digit for all records (e.g. padding of short keys or high bytes of block numbers)
+        }
+        size_t position{0};
+        for (auto& item : count) {
+            position += std::exchange(item, position);
+        }
+        for (const auto& record : records_) {
+            sorted[count[(record.key_prefix >> (8 * byte)) & 0xff]++] = record;
+        }
+        records_.swap(sorted);
+    }
+
+    // Complete the ordering of records sharing the same key prefix (i.e. longer keys or same key)
+    for (auto first{records_.begin()}; first != records_.end();) {
+        auto last{std::find_if(std::next(first), records_.end(),
+                               [&first](const Record& record) { return record.key_prefix != first->key_prefix; })};
+        if (std::distance(first, last) > 1) {
+            std::sort(first, last, [this](const Record& a, const Record& b) { return less(a, b); });
+        }
+        first = last;
+    }
+}
+
+void Buffer::comparison_sort(std::vector<Record>::iterator first, std::vector<Record>::iterator last) {
+    const auto compare{[this](const Record& a, const Record& b) { return less(a, b); }};
+    const auto size{static_cast<size_t>(std::distance(first, last))};
+    const size_t max_slices{std::bit_floor(std::max(std::thread::hardware_concurrency(), 1u))};
+    const size_t num_slices{std::min(max_slices, std::bit_floor(std::max<size_t>(size / kMinSortSliceSize, 1)))};
+    if (num_slices < 2) {
+        std::sort(first, last, compare);
+        return;
+    }
+
+    // Slice boundaries: slice i is [bounds[i], bounds[i + 1])
+    std::vector<std::vector<Record>::iterator> bounds;
+    for (size_t i{0}; i <= num_slices; ++i) {
+        bounds.push_back(first + static_cast<std::ptrdiff_t>(i * size / num_slices));
+    }
+
+    std::vector<std::function<void()>> jobs;
+    for (size_t i{0}; i < num_slices; ++i) {
+        jobs.emplace_back([&bounds, &compare, i]() { std::sort(bounds[i], bounds[i + 1], compare); });
+    }
+    run_on_sort_workers(jobs);
+
+    // Merge adjacent sorted runs pairwise: each round halves their number
+    for (size_t width{1}; width < num_slices; width *= 2) {
+        jobs.clear();
+        for (size_t i{0}; i < num_slices; i += 2 * width) {
+            jobs.emplace_back([&bounds, &compare, i, width]() {
+                std::inplace_merge(bounds[i], bounds[i + width], bounds[i + 2 * width], compare);
+            });
+        }
+        run_on_sort_workers(jobs);
+    }
+}
+
+}  // namespace silkworm::etl
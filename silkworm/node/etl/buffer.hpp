@@ -16,7 +16,9 @@
 
 #pragma once
 
-#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <utility>
 #include <vector>
 
 #include <silkworm/core/common/base.hpp>
@@ -25,32 +27,32 @@
 namespace silkworm::etl {
 
 inline constexpr size_t kInitialBufferCapacity = 32768;
+inline constexpr size_t kMinSortSliceSize = 65536;  // Min number of entries sorted by each thread
+inline constexpr size_t kMinRadixSortSize = 1024;   // Min number of entries for radix sort to pay off
 
 // In ETL, a buffer must be used stores entries, sort them and write them to file
+// Keys and values are laid out contiguously in one arena while sorting moves compact records only
 class Buffer {
   public:
+    class Iterator;
+    class EntryRange;
+
     // Not copyable nor movable
     Buffer(const Buffer&) = delete;
     Buffer& operator=(const Buffer&) = delete;
 
-    explicit Buffer(size_t optimal_size) : optimal_size_(optimal_size) { buffer_.reserve(kInitialBufferCapacity); }
-
-    void put(const Entry& entry) {
-        // Add a new entry to the buffer
-        size_ += entry.size() + sizeof(head_t);
-        buffer_.push_back(entry);
-    }
+    explicit Buffer(size_t optimal_size) : optimal_size_(optimal_size) { records_.reserve(kInitialBufferCapacity); }
 
-    void put(Entry&& entry) {
-        // Add a new entry to the buffer
-        size_ += entry.size() + sizeof(head_t);
-        buffer_.push_back(std::move(entry));
-    }
+    void put(ByteView key, ByteView value);
+    void put(const Entry& entry) { put(entry.key, entry.value); }
 
     void clear() noexcept {
-        // Set the buffer to contain 0 entries
-        buffer_.clear();
+        // Set the buffer to contain 0 entries (allocated memory is retained for reuse)
+        arena_.clear();
+        records_.clear();
         size_ = 0;
+        key_size_ = 0;
+        fixed_key_size_ = true;
     }
 
     [[nodiscard]] bool overflows() const noexcept {
@@ -58,23 +60,97 @@ class Buffer {
         return size_ >= optimal_size_;
     }
 
-    void sort() {
-        // Sort buffer in increasing order by key comparison
-        std::sort(buffer_.begin(), buffer_.end());
+    void swap(Buffer& other) noexcept {
+        // Exchange contents with other buffer (e.g. to hand them over to a background flush)
+        arena_.swap(other.arena_);
+        records_.swap(other.records_);
+        std::swap(size_, other.size_);
+        std::swap(key_size_, other.key_size_);
+        std::swap(fixed_key_size_, other.fixed_key_size_);
     }
 
+    // Sort buffer in increasing order by key comparison
+    // Fixed size keys are radix sorted, otherwise large buffers are split in slices sorted in parallel and merged
+    void sort();
+
     [[nodiscard]] size_t size() const noexcept {
         // Actual size of accounted data
         return size_;
     }
 
-    [[nodiscard]] const std::vector<Entry>& entries() const noexcept { return buffer_; }
+    // Entries in buffer order: viewed data remains valid until the buffer is modified
+    [[nodiscard]] EntryRange entries() const noexcept;
 
   private:
+    // An entry in the arena along with the leading bytes of its key (big endian, zero padded)
+    struct Record {
+        uint64_t key_prefix;
+        size_t offset;
+        uint32_t key_size;
+        uint32_t value_size;
+    };
+
+    [[nodiscard]] EntryView view(const Record& record) const noexcept {
+        const uint8_t* data{arena_.data() + record.offset};
+        return {ByteView{data, record.key_size}, ByteView{data + record.key_size, record.value_size}};
+    }
+
+    [[nodiscard]] bool less(const Record& a, const Record& b) const noexcept {
+        if (a.key_prefix != b.key_prefix) {
+            return a.key_prefix < b.key_prefix;
+        }
+        return view(a) < view(b);
+    }
+
+    void radix_sort();
+    void comparison_sort(std::vector<Record>::iterator first, std::vector<Record>::iterator last);
+
     size_t optimal_size_;
     size_t size_ = 0;
 
-    std::vector<Entry> buffer_;  // buffer for holding entries
+    Bytes arena_;                  // keys and values of all entries
+    std::vector<Record> records_;  // entries in arena (sort order after sort())
+    size_t key_size_ = 0;          // size of keys if all of the same size
+    bool fixed_key_size_ = true;   // whether all keys have the same size
 };
 
+class Buffer::Iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = EntryView;
+    using pointer = void;
+    using reference = EntryView;
+
+    Iterator() = default;
+    Iterator(const Buffer* buffer, size_t index) : buffer_{buffer}, index_{index} {}
+
+    EntryView operator*() const noexcept { return buffer_->view(buffer_->records_[index_]); }
+    Iterator& operator++() noexcept {
+        ++index_;
+        return *this;
+    }
+    Iterator operator++(int) noexcept { return Iterator{buffer_, index_++}; }
+    bool operator==(const Iterator& other) const noexcept { return index_ == other.index_; }
+
+  private:
+    const Buffer* buffer_{nullptr};
+    size_t index_{0};
+};
+
+class Buffer::EntryRange {
+  public:
+    explicit EntryRange(const Buffer* buffer) : buffer_{buffer} {}
+
+    [[nodiscard]] Iterator begin() const noexcept { return {buffer_, 0}; }
+    [[nodiscard]] Iterator end() const noexcept { return {buffer_, buffer_->records_.size()}; }
+    [[nodiscard]] size_t size() const noexcept { return buffer_->records_.size(); }
+    [[nodiscard]] bool empty() const noexcept { return buffer_->records_.empty(); }
+
+  private:
+    const Buffer* buffer_;
+};
+
+inline Buffer::EntryRange Buffer::entries() const noexcept { return EntryRange{this}; }
+
 }  // namespace silkworm::etl
@@ -0,0 +1,73 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "buffer.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+#include <catch2/catch.hpp>
+
+namespace silkworm::etl {
+
+static void check_sort(const std::vector<size_t>& key_sizes, size_t count) {
+    Buffer buffer{256_Mebi};
+    std::vector<Entry> expected;
+    for (size_t i{0}; i < count; ++i) {
+        // Few distinct leading bytes give both duplicate keys and keys sharing long prefixes
+        Bytes key(key_sizes[static_cast<size_t>(std::rand()) % key_sizes.size()], '\0');
+        for (auto& byte : key) {
+            byte = static_cast<uint8_t>(std::rand() % 3);
+        }
+        Bytes value(1, static_cast<uint8_t>(i));
+        expected.push_back({key, value});
+        buffer.put({key, value});
+    }
+    std::sort(expected.begin(), expected.end());
+
+    buffer.sort();
+    const auto entries{buffer.entries()};
+    REQUIRE(entries.size() == expected.size());
+    CHECK(std::equal(entries.begin(), entries.end(), expected.begin(),
+                     [](const EntryView& a, const Entry& b) { return a.key == b.key && a.value == b.value; }));
+}
+
+TEST_CASE("Buffer sort") {
+    for (size_t count : {size_t{0}, size_t{1}, size_t{1000}, kMinRadixSortSize + 1, 4 * kMinSortSliceSize + 3}) {
+        SECTION("fixed size keys " + std::to_string(count)) {
+            check_sort({4}, count);
+            check_sort({8}, count);
+            check_sort({32}, count);
+        }
+        SECTION("variable size keys " + std::to_string(count)) {
+            check_sort({0, 3, 8, 9, 20}, count);
+        }
+    }
+}
+
+TEST_CASE("Buffer swap") {
+    Buffer a{1_Kibi};
+    Buffer b{1_Kibi};
+    a.put({Bytes{1, 2}, Bytes{3}});
+    a.swap(b);
+    CHECK(a.entries().empty());
+    CHECK(a.size() == 0);
+    REQUIRE(b.entries().size() == 1);
+    CHECK(b.size() == 3 + sizeof(head_t));
+}
+
+}  // namespace silkworm::etl
@@ -16,15 +16,21 @@
 
 #include "collector.hpp"
 
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
 #include <filesystem>
+#include <future>
 #include <iomanip>
-#include <queue>
 #include <stdexcept>
+#include <thread>
 
 #include <silkworm/node/common/directories.hpp>
 #include <silkworm/node/common/log.hpp>
 #include <silkworm/node/common/stopwatch.hpp>
 #include <silkworm/node/concurrency/signal_handler.hpp>
+#include <silkworm/node/etl/loser_tree.hpp>
 
 namespace silkworm::etl {
 
@@ -37,22 +43,40 @@ Collector::~Collector() {
     }
 }
 
+fs::path Collector::file_path(size_t index) const {
+    return work_path_ / fs::path(std::to_string(unique_id_) + "-" + std::to_string(index) + ".bin");
+}
+
 void Collector::flush_buffer() {
     if (buffer_.size()) {
-        StopWatch sw(/*auto_start=*/true);
-        buffer_.sort();
+        // Only one buffer at a time is flushed: this also bounds memory usage to twice the buffer size
+        wait_flushing();
 
         /* Build a unique file name to pass FileProvider */
-        fs::path new_file_path{
-            work_path_ / fs::path(std::to_string(unique_id_) + "-" + std::to_string(file_providers_.size()) + ".bin")};
+        const fs::path new_file_path{file_path(file_providers_.size())};
 
         file_providers_.emplace_back(new FileProvider(new_file_path.string(), file_providers_.size()));
-        file_providers_.back()->flush(buffer_);
-        buffer_.clear();
-        const auto [_, duration]{sw.stop()};
-        log::Info("Collector flushed file", {"path", std::string(file_providers_.back()->get_file_name()),
-                                             "size", human_size(file_providers_.back()->get_file_size()),
-                                             "in", StopWatch::format(duration)});
+        FileProvider* file_provider{file_providers_.back().get()};
+        file_provider->open(buffer_.size());
+
+        // Collection continues on the (empty) buffer previously flushed
+        buffer_.swap(flushing_buffer_);
+        flushing_ = std::async(std::launch::async, [this, file_provider]() {
+            StopWatch sw(/*auto_start=*/true);
+            flushing_buffer_.sort();
+            file_provider->flush(flushing_buffer_);
+            flushing_buffer_.clear();
+            const auto [_, duration]{sw.stop()};
+            log::Info("Collector flushed file", {"path", std::string(file_provider->get_file_name()), "size",
+                                                 human_size(file_provider->get_file_size()), "in",
+                                                 StopWatch::format(duration)});
+        });
+    }
+}
+
+void Collector::wait_flushing() {
+    if (flushing_.valid()) {
+        flushing_.get();
     }
 }
 
@@ -74,109 +98,270 @@ void Collector::collect(Entry&& entry) {
     }
 }
 
-void Collector::load(mdbx::cursor& target, const LoadFunc& load_func, MDBX_put_flags_t flags) {
-    using namespace std::chrono_literals;
-    static const auto kLogInterval{5s};               // Updates processing key (for log purposes) every this time
-    auto log_time{std::chrono::steady_clock::now()};  // To check if an update of key is needed
-
-    set_loading_key({});
-
-    if (empty()) {
-        return;
+void Collector::absorb(Collector& other) {
+    other.flush_buffer();
+    other.wait_flushing();
+    for (auto& file_provider : other.file_providers_) {
+        file_provider->rename(file_path(file_providers_.size()).string(), file_providers_.size());
+        file_providers_.push_back(std::move(file_provider));
     }
+    size_ += other.size_;
+    bytes_size_ += other.bytes_size_;
+    other.file_providers_.clear();
+    other.size_ = 0;
+    other.bytes_size_ = 0;
+}
 
-    if (file_providers_.empty()) {
-        buffer_.sort();
-
-        for (const auto& etl_entry : buffer_.entries()) {
-            if (const auto now{std::chrono::steady_clock::now()}; log_time <= now) {
-                if (SignalHandler::signalled()) {
-                    throw std::runtime_error("Operation cancelled");
-                }
-                set_loading_key(etl_entry.key);
-                log_time = now + kLogInterval;
+namespace {
+
+    //! \brief Bounded queue of merged chunks flowing from a partition merger to the loading thread
+    class MergedChunks {
+      public:
+        static constexpr size_t kChunkSize{1_Mebi};
+        static constexpr size_t kCapacity{4};
+
+        //! \brief Pushes a chunk waiting for room
+        //! \return False if the consumer has aborted
+        bool push(Bytes&& chunk) {
+            std::unique_lock lock{mutex_};
+            not_full_.wait(lock, [this] { return chunks_.size() < kCapacity || aborted_; });
+            if (aborted_) {
+                return false;
             }
-            if (load_func) {
-                load_func(etl_entry, target, flags);
-            } else {
-                mdbx::slice k{db::to_slice(etl_entry.key)};
-                if (etl_entry.value.empty()) {
-                    target.erase(k);
-                } else {
-                    mdbx::slice v{db::to_slice(etl_entry.value)};
-                    mdbx::error::success_or_throw(target.put(k, &v, flags));
-                }
+            chunks_.push_back(std::move(chunk));
+            lock.unlock();
+            not_empty_.notify_one();
+            return true;
+        }
+
+        //! \brief Pops next chunk waiting for it
+        //! \return Nothing if the producer is done and all chunks have been consumed
+        std::optional<Bytes> pop() {
+            std::unique_lock lock{mutex_};
+            not_empty_.wait(lock, [this] { return !chunks_.empty() || done_; });
+            if (chunks_.empty()) {
+                return std::nullopt;
             }
+            Bytes chunk{std::move(chunks_.front())};
+            chunks_.pop_front();
+            lock.unlock();
+            not_full_.notify_one();
+            return chunk;
         }
 
-        clear();
-        return;
-    }
+        void done() {
+            std::unique_lock lock{mutex_};
+            done_ = true;
+            lock.unlock();
+            not_empty_.notify_all();
+        }
 
-    // Flush not overflown buffer data to file
-    flush_buffer();
+        void abort() {
+            std::unique_lock lock{mutex_};
+            aborted_ = true;
+            lock.unlock();
+            not_full_.notify_all();
+        }
 
-    // Define a priority queue based on smallest available key
-    auto key_comparer = [](const std::pair<Entry, size_t>& left, const std::pair<Entry, size_t>& right) {
-        return right.first < left.first;
+      private:
+        std::mutex mutex_;
+        std::condition_variable not_empty_;
+        std::condition_variable not_full_;
+        std::deque<Bytes> chunks_;
+        bool done_{false};
+        bool aborted_{false};
     };
-    std::priority_queue<std::pair<Entry, size_t>, std::vector<std::pair<Entry, size_t>>, decltype(key_comparer)> queue(
-        key_comparer);
 
-    // Read one "record" from each data_provider and let the queue
-    // sort them. On top of the queue the smallest key
-    for (auto& file_provider : file_providers_) {
-        auto item{file_provider->read_entry()};
-        if (item.has_value()) {
-            queue.push(std::move(*item));
+    //! \brief Merges the records of the readers in sorted order through a loser tree
+    template <class Consumer>
+    void merge(std::vector<std::unique_ptr<FileReader>>& readers, Consumer&& consume) {
+        if (readers.empty()) {
+            return;
+        }
+        for (auto& reader : readers) {
+            reader->next();
         }
+        LoserTree tree{readers.size(), [&readers](size_t a, size_t b) {
+                           if (!readers[a]->has_current()) return false;
+                           if (!readers[b]->has_current()) return true;
+                           return readers[a]->current() < readers[b]->current();
+                       }};
+        for (size_t winner{tree.top()}; readers[winner]->has_current(); winner = tree.top()) {
+            consume(readers[winner]->current());
+            readers[winner]->next();
+            tree.replay();
+        }
+    }
+
+    //! \brief Appends a record to a chunk in the same format used by files
+    void append_record(Bytes& chunk, const EntryView& record) {
+        head_t head{};
+        head.lengths[0] = static_cast<uint32_t>(record.key.size());
+        head.lengths[1] = static_cast<uint32_t>(record.value.size());
+        chunk.append(head.bytes, sizeof(head_t));
+        chunk.append(record.key);
+        chunk.append(record.value);
     }
 
-    // Process the queue from smallest to largest key
-    while (!queue.empty()) {
-        auto& [etl_entry, provider_index]{queue.top()};           // Pick the smallest key by reference
-        auto& file_provider{file_providers_.at(provider_index)};  // and set current file provider
+}  // namespace
 
+void Collector::load(mdbx::cursor& target, const LoadFunc& load_func, MDBX_put_flags_t flags) {
+    using namespace std::chrono_literals;
+    static const auto kLogInterval{5s};               // Updates processing key (for log purposes) every this time
+    auto log_time{std::chrono::steady_clock::now()};  // To check if an update of key is needed
+
+    set_loading_key({});
+
+    if (empty()) {
+        return;
+    }
+
+    Entry load_entry;  // Reused to pass records to load_func: no allocation once capacity is enough
+    auto load_record{[&](const EntryView& record) {
         if (const auto now{std::chrono::steady_clock::now()}; log_time <= now) {
             if (SignalHandler::signalled()) {
                 throw std::runtime_error("Operation cancelled");
             }
             log_time = now + kLogInterval;
-            set_loading_key(etl_entry.key);
+            set_loading_key(record.key);
         }
 
         // Process linked pairs
         if (load_func) {
-            load_func(etl_entry, target, flags);
+            load_entry.key.assign(record.key);
+            load_entry.value.assign(record.value);
+            load_func(load_entry, target, flags);
         } else {
-            mdbx::slice k{db::to_slice(etl_entry.key)};
-            if (etl_entry.value.empty()) {
+            mdbx::slice k{db::to_slice(record.key)};
+            if (record.value.empty()) {
                 target.erase(k);
             } else {
-                mdbx::slice v{db::to_slice(etl_entry.value)};
+                mdbx::slice v{db::to_slice(record.value)};
                 mdbx::error::success_or_throw(target.put(k, &v, flags));
             }
         }
+    }};
 
-        // From the provider which has served the current key
-        // read next "record"
-        auto next{file_provider->read_entry()};
+    if (file_providers_.empty()) {
+        buffer_.sort();
+        for (const auto& etl_entry : buffer_.entries()) {
+            load_record(etl_entry);
+        }
+        clear();
+        return;
+    }
 
-        // At this point `current` has been processed.
-        // We can remove it from the queue
-        queue.pop();
+    // Flush not overflown buffer data to file
+    flush_buffer();
+    wait_flushing();
+
+    const auto bounds{partition_bounds(merge_partitions_)};
+    const size_t num_readers{file_providers_.size() * (bounds.size() + 1)};
+    const size_t chunk_size{std::clamp<size_t>(kReadAheadBudget / (2 * num_readers), 64_Kibi, 4_Mebi)};
+    thread_pool read_ahead_pool{static_cast<uint32_t>(
+        std::clamp<size_t>(num_readers, 1, std::max(std::thread::hardware_concurrency(), 1u)))};
+
+    if (bounds.empty()) {
+        // Process records from smallest to largest key as they are read
+        std::vector<std::unique_ptr<FileReader>> readers;
+        for (const auto& file_provider : file_providers_) {
+            readers.push_back(file_provider->get_reader(read_ahead_pool, chunk_size));
+        }
+        merge(readers, load_record);
+        readers.clear();
+        clear();
+        return;
+    }
 
-        // Add next item to the queue only if it has
-        // meaningful data
-        if (next.has_value()) {
-            queue.push(std::move(*next));
-        } else {
-            file_provider.reset();
+    // Each key range is merged on its own thread into chunks of records which are loaded here in range order
+    std::vector<std::unique_ptr<MergedChunks>> partitions;
+    std::vector<std::future<void>> mergers;
+    try {
+        for (size_t i{0}; i <= bounds.size(); ++i) {
+            MergedChunks* merged_chunks{partitions.emplace_back(std::make_unique<MergedChunks>()).get()};
+            ByteView start_key{i ? ByteView{bounds[i - 1]} : ByteView{}};
+            std::optional<Bytes> end_key{i < bounds.size() ? std::make_optional(bounds[i]) : std::nullopt};
+            std::vector<std::unique_ptr<FileReader>> readers;
+            for (const auto& file_provider : file_providers_) {
+                readers.push_back(file_provider->get_reader(read_ahead_pool, chunk_size, start_key, end_key));
+            }
+            mergers.push_back(std::async(std::launch::async, [merged_chunks, readers = std::move(readers)]() mutable {
+                try {
+                    Bytes chunk;
+                    merge(readers, [&](const EntryView& record) {
+                        append_record(chunk, record);
+                        if (chunk.size() >= MergedChunks::kChunkSize) {
+                            if (!merged_chunks->push(std::move(chunk))) {
+                                throw std::runtime_error("Operation cancelled");
+                            }
+                            chunk = Bytes{};
+                        }
+                    });
+                    if (!chunk.empty()) {
+                        (void)merged_chunks->push(std::move(chunk));
+                    }
+                } catch (...) {
+                    merged_chunks->done();
+                    throw;
+                }
+                merged_chunks->done();
+            }));
+        }
+
+        for (size_t i{0}; i < partitions.size(); ++i) {
+            while (auto chunk{partitions[i]->pop()}) {
+                ByteView data{*chunk};
+                head_t head{};
+                while (!data.empty()) {
+                    std::memcpy(head.bytes, data.data(), sizeof(head_t));
+                    const EntryView record{data.substr(sizeof(head_t), head.lengths[0]),
+                                           data.substr(sizeof(head_t) + head.lengths[0], head.lengths[1])};
+                    load_record(record);
+                    data.remove_prefix(sizeof(head_t) + record.size());
+                }
+            }
+            mergers[i].get();  // Surface any merge error
+        }
+    } catch (...) {
+        for (auto& merged_chunks : partitions) {
+            merged_chunks->abort();
+        }
+        for (auto& merger : mergers) {
+            if (merger.valid()) {
+                merger.wait();
+            }
         }
+        throw;
     }
     clear();
 }
 
+std::vector<Bytes> Collector::partition_bounds(size_t count) const {
+    std::vector<Bytes> bounds;
+    if (count < 2) {
+        return bounds;
+    }
+
+    // Index entries are evenly spaced in each file hence their keys are representative of data distribution
+    std::vector<ByteView> samples;
+    for (const auto& file_provider : file_providers_) {
+        for (const auto& index_entry : file_provider->index()) {
+            samples.emplace_back(index_entry.key);
+        }
+    }
+    if (samples.empty()) {
+        return bounds;
+    }
+    std::sort(samples.begin(), samples.end());
+    for (size_t i{1}; i < count; ++i) {
+        const ByteView bound{samples[i * samples.size() / count]};
+        if (bound != samples.front() && (bounds.empty() || ByteView{bounds.back()} < bound)) {
+            bounds.emplace_back(bound);
+        }
+    }
+    return bounds;
+}
+
 std::filesystem::path Collector::set_work_path(const std::optional<std::filesystem::path>& provided_work_path) {
     fs::path res;
 
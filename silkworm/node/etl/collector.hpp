@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <future>
 #include <mutex>
 
 #include <silkworm/node/common/settings.hpp>
@@ -30,6 +31,8 @@
 namespace silkworm::etl {
 
 inline constexpr size_t kOptimalBufferSize = 256_Mebi;
+inline constexpr size_t kReadAheadBudget = 256_Mebi;    // Overall size of read ahead data while loading from files
+inline constexpr size_t kLargeLoadMergePartitions = 8;  // Key ranges merged in parallel by loads of large collections
 
 // Function pointer to process Load on before Load data into tables
 using LoadFunc = std::function<void(const Entry&, mdbx::cursor&, MDBX_put_flags_t)>;
@@ -44,11 +47,18 @@ class Collector {
     explicit Collector(const NodeSettings* node_settings)
         : work_path_managed_{false},
           work_path_{set_work_path(node_settings->data_directory->etl().path())},
-          buffer_{node_settings->etl_buffer_size} {};
+          buffer_{node_settings->etl_buffer_size},
+          flushing_buffer_{node_settings->etl_buffer_size} {};
     explicit Collector(const std::filesystem::path& work_path, size_t optimal_size = kOptimalBufferSize)
-        : work_path_managed_{false}, work_path_{set_work_path(work_path)}, buffer_{optimal_size} {}
+        : work_path_managed_{false},
+          work_path_{set_work_path(work_path)},
+          buffer_{optimal_size},
+          flushing_buffer_{optimal_size} {}
     explicit Collector(size_t optimal_size = kOptimalBufferSize)
-        : work_path_managed_{true}, work_path_{set_work_path(std::nullopt)}, buffer_{optimal_size} {}
+        : work_path_managed_{true},
+          work_path_{set_work_path(std::nullopt)},
+          buffer_{optimal_size},
+          flushing_buffer_{optimal_size} {}
 
     ~Collector();
 
@@ -63,6 +73,16 @@ class Collector {
     void load(mdbx::cursor& target, const LoadFunc& load_func = {},
               MDBX_put_flags_t flags = MDBX_put_flags_t::MDBX_UPSERT);
 
+    //! \brief Takes over all entries collected by another collector, which is left empty
+    //! \remarks Entries of other are flushed to file and merged on load along with own ones. Files are renamed as
+    //! if flushed by this collector, so that they neither collide with files flushed later by other nor get deleted
+    //! along with its own ones
+    void absorb(Collector& other);
+
+    //! \brief Sets the number of key ranges merged in parallel when loading from files
+    //! \remarks Each range is merged on its own thread while the loading thread appends ranges to db in order
+    void set_merge_partitions(size_t partitions) { merge_partitions_ = partitions ? partitions : 1; }
+
     //! \brief Returns the number of actually collected items
     [[nodiscard]] size_t size() const { return size_; }
 
@@ -74,8 +94,13 @@ class Collector {
 
     //! \brief Clears contents of collector and reset
     void clear() {
+        if (flushing_.valid()) {
+            flushing_.wait();  // Any error is discarded along with data
+            flushing_ = {};
+        }
         file_providers_.clear();
         buffer_.clear();
+        flushing_buffer_.clear();
         size_ = 0;
         bytes_size_ = 0;
     }
@@ -89,7 +114,14 @@ class Collector {
   private:
     static std::filesystem::path set_work_path(const std::optional<std::filesystem::path>& provided_work_path);
 
-    void flush_buffer();  // Write buffer to file
+    //! \brief Returns the path of the file of given index among the ones flushed by this collector
+    [[nodiscard]] std::filesystem::path file_path(size_t index) const;
+
+    void flush_buffer();   // Hand buffer over to a background task writing it to file
+    void wait_flushing();  // Wait for the background flush to complete (if any) rethrowing its errors
+
+    //! \brief Returns at most (count - 1) increasing keys splitting the flushed data in ranges of similar size
+    [[nodiscard]] std::vector<Bytes> partition_bounds(size_t count) const;
 
     void set_loading_key(ByteView key) {
         std::unique_lock l{mutex_};
@@ -98,7 +130,9 @@ class Collector {
 
     bool work_path_managed_;
     std::filesystem::path work_path_;
-    Buffer buffer_;
+    Buffer buffer_;           // Buffer collecting entries
+    Buffer flushing_buffer_;  // Buffer being sorted and written to file in background while collection continues
+    std::future<void> flushing_;
 
     /*
      * TL;DR; In no way two instances of collector can have
@@ -116,6 +150,7 @@ class Collector {
     std::vector<std::unique_ptr<FileProvider>> file_providers_;  // Collection of file providers
     size_t size_{0};                                             // Count of total collected items
     size_t bytes_size_{0};                                       // Count of total collected bytes
+    size_t merge_partitions_{1};                                 // Count of key ranges merged in parallel on load
     mutable std::mutex mutex_{};                                 // To sync loading_key_
     std::string loading_key_{};                                  // Actual load key (for log purposes)
 };
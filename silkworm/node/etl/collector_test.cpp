@@ -16,6 +16,7 @@
 
 #include "collector.hpp"
 
+#include <algorithm>
 #include <filesystem>
 #include <set>
 #include <thread>
@@ -109,6 +110,115 @@ TEST_CASE("collect_and_default_load_move") {
     run_collector_test(nullptr, false);
 }
 
+TEST_CASE("collect_and_partitioned_load") {
+    test::SetLogVerbosityGuard log_guard{log::Level::kNone};
+    test::Context context;
+
+    auto set{generate_entry_set(1000)};
+    size_t generated_size{0};
+    for (const auto& entry : set) {
+        generated_size += entry.size() + 8;
+    }
+    auto collector{Collector(context.dir().etl().path(), generated_size / 10)};
+    collector.set_merge_partitions(4);
+    for (const auto& entry : set) {
+        collector.collect(entry);
+    }
+
+    auto to{db::open_cursor(context.txn(), db::table::kHeaderNumbers)};
+    collector.load(to);
+    CHECK(std::distance(fs::directory_iterator{context.dir().etl().path()}, fs::directory_iterator{}) == 0);
+
+    // Records with empty value are erased, all others must have been put
+    std::sort(set.begin(), set.end());
+    size_t expected_count{0};
+    for (const auto& entry : set) {
+        auto data{to.find(db::to_slice(entry.key), /*throw_notfound=*/false)};
+        if (entry.value.empty()) {
+            CHECK_FALSE(data);
+        } else {
+            REQUIRE(data);
+            CHECK(db::from_slice(data.value) == entry.value);
+            ++expected_count;
+        }
+    }
+    CHECK(context.txn().get_map_stat(to.map()).ms_entries == expected_count);
+}
+
+TEST_CASE("collect_and_absorb") {
+    test::SetLogVerbosityGuard log_guard{log::Level::kNone};
+    test::Context context;
+
+    auto set{generate_entry_set(1000)};
+    auto collector{Collector(context.dir().etl().path())};
+    auto other_collector{Collector(context.dir().etl().path())};
+    for (size_t i{0}; i < set.size(); ++i) {
+        (i % 2 ? collector : other_collector).collect(set[i]);
+    }
+
+    collector.absorb(other_collector);
+    CHECK(other_collector.empty());
+    CHECK(collector.size() == set.size());
+
+    auto to{db::open_cursor(context.txn(), db::table::kHeaderNumbers)};
+    collector.load(to);
+    CHECK(std::distance(fs::directory_iterator{context.dir().etl().path()}, fs::directory_iterator{}) == 0);
+
+    // Entries of both collectors are merged in order
+    size_t expected_count{0};
+    for (const auto& entry : set) {
+        auto data{to.find(db::to_slice(entry.key), /*throw_notfound=*/false)};
+        if (entry.value.empty()) {
+            CHECK_FALSE(data);
+        } else {
+            REQUIRE(data);
+            CHECK(db::from_slice(data.value) == entry.value);
+            ++expected_count;
+        }
+    }
+    CHECK(context.txn().get_map_stat(to.map()).ms_entries == expected_count);
+}
+
+TEST_CASE("absorbed files are owned by the absorbing collector") {
+    test::SetLogVerbosityGuard log_guard{log::Level::kNone};
+    test::Context context;
+
+    auto set{generate_entry_set(1000)};
+    auto collector{Collector(context.dir().etl().path(), 1_Kibi)};
+    auto other_collector{Collector(context.dir().etl().path(), 1_Kibi)};
+    for (size_t i{0}; i < set.size() / 2; ++i) {
+        other_collector.collect(set[i]);
+    }
+    collector.absorb(other_collector);
+
+    // Files flushed later by the donor must not overwrite the absorbed ones
+    for (size_t i{set.size() / 2}; i < set.size(); ++i) {
+        other_collector.collect(set[i]);
+    }
+    {
+        auto from_other{db::open_cursor(context.txn(), db::table::kCanonicalHashes)};
+        other_collector.load(from_other);
+        CHECK(context.txn().get_map_stat(from_other.map()).ms_entries > 0);
+    }
+
+    auto to{db::open_cursor(context.txn(), db::table::kHeaderNumbers)};
+    collector.load(to);
+    CHECK(std::distance(fs::directory_iterator{context.dir().etl().path()}, fs::directory_iterator{}) == 0);
+
+    size_t expected_count{0};
+    for (size_t i{0}; i < set.size() / 2; ++i) {
+        auto data{to.find(db::to_slice(set[i].key), /*throw_notfound=*/false)};
+        if (set[i].value.empty()) {
+            CHECK_FALSE(data);
+        } else {
+            REQUIRE(data);
+            CHECK(db::from_slice(data.value) == set[i].value);
+            ++expected_count;
+        }
+    }
+    CHECK(context.txn().get_map_stat(to.map()).ms_entries == expected_count);
+}
+
 TEST_CASE("collect_and_load") {
     test::SetLogVerbosityGuard log_guard{log::Level::kNone};
     run_collector_test([](const Entry& entry, mdbx::cursor& table, MDBX_put_flags_t) {
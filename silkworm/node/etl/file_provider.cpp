@@ -16,6 +16,10 @@
 
 #include "file_provider.hpp"
 
+#include <snappy.h>
+
+#include <algorithm>
+#include <cstring>
 #include <filesystem>
 
 #include <silkworm/core/common/cast.hpp>
@@ -24,88 +28,315 @@ namespace silkworm::etl {
 
 namespace fs = std::filesystem;
 
+namespace {
+
+    void encode_varint(uint64_t value, Bytes& out) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    uint64_t decode_varint(ByteView& data) {
+        uint64_t value{0};
+        for (size_t shift{0}; shift < 64 && !data.empty(); shift += 7) {
+            const uint8_t byte{data.front()};
+            data.remove_prefix(1);
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) {
+                return value;
+            }
+        }
+        throw etl_error("Invalid record in file");
+    }
+
+    //! \brief Compresses a block of records and appends it to output preceded by its head
+    void append_block(ByteView block, Bytes& output) {
+        const size_t offset{output.size()};
+        output.resize(offset + sizeof(head_t) + snappy::MaxCompressedLength(block.size()));
+        size_t compressed_size{0};
+        snappy::RawCompress(byte_ptr_cast(block.data()), block.size(), byte_ptr_cast(&output[offset + sizeof(head_t)]),
+                            &compressed_size);
+        head_t head{};
+        head.lengths[0] = static_cast<uint32_t>(compressed_size);
+        head.lengths[1] = static_cast<uint32_t>(block.size());
+        std::memcpy(&output[offset], head.bytes, sizeof(head_t));
+        output.resize(offset + sizeof(head_t) + compressed_size);
+    }
+
+    //! \brief Restores the records of a decompressed block appending them to chunk in plain format (head, key, value)
+    void decode_block(ByteView block, Bytes& chunk) {
+        Bytes key;
+        head_t head{};
+        while (!block.empty()) {
+            const uint64_t shared{decode_varint(block)};
+            const uint64_t suffix_size{decode_varint(block)};
+            const uint64_t value_size{decode_varint(block)};
+            if (shared > key.size() || suffix_size > block.size() || value_size > block.size() - suffix_size) {
+                throw etl_error("Invalid record in file");
+            }
+            key.resize(shared);
+            key.append(block.substr(0, suffix_size));
+            head.lengths[0] = static_cast<uint32_t>(key.size());
+            head.lengths[1] = static_cast<uint32_t>(value_size);
+            chunk.append(head.bytes, sizeof(head_t));
+            chunk.append(key);
+            chunk.append(block.substr(suffix_size, value_size));
+            block.remove_prefix(suffix_size + value_size);
+        }
+    }
+
+}  // namespace
+
 // https://abseil.io/tips/117
 FileProvider::FileProvider(std::string file_name, size_t id) : id_{id}, file_name_{std::move(file_name)} {}
 
 FileProvider::~FileProvider() { reset(); }
 
-void FileProvider::flush(Buffer& buffer) {
-    head_t head{};
-
+void FileProvider::open(size_t data_size) {
     // Check we have enough space to store all data
-    auto entries{buffer.entries()};
-    file_size_ = buffer.size();
     fs::path workdir(fs::path(file_name_).parent_path());
-    if (fs::space(workdir).available < file_size_) {
-        file_size_ = 0;
+    if (fs::space(workdir).available < data_size) {
         throw etl_error("Insufficient disk space");
     }
 
-    // Open file for output and flush data
+    // Open file for output
     file_.open(file_name_, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
     if (!file_.is_open()) {
         reset();
         throw etl_error(errno2str(errno));
     }
+}
+
+void FileProvider::flush(Buffer& buffer) {
+    if (!file_.is_open()) {
+        open(buffer.size());
+    }
+
+    index_.clear();
+    file_size_ = 0;
+    Bytes block;   // Records of the block being built (not compressed yet)
+    Bytes output;  // Compressed blocks to be written at once
+    ByteView previous_key;
 
-    for (const auto& entry : entries) {
-        head.lengths[0] = static_cast<uint32_t>(entry.key.size());
-        head.lengths[1] = static_cast<uint32_t>(entry.value.size());
-        if (!file_.write(byte_ptr_cast(head.bytes), 8) ||
-            !file_.write(byte_ptr_cast(entry.key.data()), static_cast<std::streamsize>(entry.key.size())) ||
-            !file_.write(byte_ptr_cast(entry.value.data()), static_cast<std::streamsize>(entry.value.size()))) {
+    auto write_output{[&]() {
+        if (!file_.write(byte_ptr_cast(output.data()), static_cast<std::streamsize>(output.size()))) {
             auto err{errno};
             reset();
             throw etl_error(errno2str(err));
         }
+        file_size_ += output.size();
+        output.clear();
+    }};
+
+    for (const auto& entry : buffer.entries()) {
+        // Keys are sorted hence each one is stored as the suffix not shared with the previous one
+        // except for the first key of a block which is stored in full so that blocks can be decoded independently
+        size_t shared{0};
+        if (block.empty()) {
+            index_.push_back({Bytes{entry.key}, file_size_ + output.size()});
+        } else {
+            const size_t max_shared{std::min(previous_key.size(), entry.key.size())};
+            while (shared < max_shared && previous_key[shared] == entry.key[shared]) {
+                ++shared;
+            }
+        }
+        encode_varint(shared, block);
+        encode_varint(entry.key.size() - shared, block);
+        encode_varint(entry.value.size(), block);
+        block.append(entry.key.substr(shared));
+        block.append(entry.value);
+        previous_key = entry.key;
+
+        if (block.size() >= kBlockSize) {
+            append_block(block, output);
+            block.clear();
+            if (output.size() >= kWriteSize) {
+                write_output();
+            }
+        }
+    }
+    if (!block.empty()) {
+        append_block(block, output);
+    }
+    if (!output.empty()) {
+        write_output();
     }
 
-    // Close file in output mode and reopen for input mode
-    // This is actually not strictly needed but amends an odd behavior on Windows
+    // Close file in output mode: data is read back by FileReader(s)
+    // Closing is also needed to amend an odd behavior on Windows
     // which prevents correct display of file size if the handle
     // has not been closed
     file_.close();
-    file_.open(file_name_, std::ios_base::in | std::ios_base::binary);
-    if (!file_.is_open()) {
+    if (file_.fail()) {
         auto err{errno};
         reset();
         throw etl_error(errno2str(err));
     }
 }
 
-std::optional<std::pair<Entry, size_t>> FileProvider::read_entry() {
-    head_t head{};
-
-    if (!file_.is_open() || !file_size_) {
+std::unique_ptr<FileReader> FileProvider::get_reader(thread_pool& pool, size_t chunk_size, ByteView start_key,
+                                                     std::optional<Bytes> end_key) const {
+    if (!file_size_) {
         throw etl_error("Invalid file handle");
     }
 
-    if (!file_.read(byte_ptr_cast(head.bytes), 8)) {
-        reset();
-        return std::nullopt;
-    }
-
-    Entry entry{Bytes(head.lengths[0], '\0'), Bytes(head.lengths[1], '\0')};
-    if (!file_.read(byte_ptr_cast(entry.key.data()), head.lengths[0]) ||
-        !file_.read(byte_ptr_cast(entry.value.data()), head.lengths[1])) {
-        auto err{errno};
-        reset();
-        throw etl_error(errno2str(err));
+    // Start from the last indexed block whose first key is lower than start_key: records with same key
+    // may span more blocks hence blocks starting with start_key are not a safe starting point
+    size_t offset{0};
+    if (!start_key.empty()) {
+        auto it{std::lower_bound(index_.begin(), index_.end(), start_key,
+                                 [](const FileIndexEntry& item, ByteView key) { return ByteView{item.key} < key; })};
+        if (it != index_.begin()) {
+            offset = std::prev(it)->offset;
+        }
     }
-
-    return std::make_pair(entry, id_);
+    return std::make_unique<FileReader>(file_name_, offset, file_size_, pool, chunk_size, start_key,
+                                        std::move(end_key));
 }
 
 void FileProvider::reset() {
     file_size_ = 0;
+    index_.clear();
     if (file_.is_open()) {
         file_.close();
+    }
+    if (fs::exists(file_name_)) {
         fs::remove(file_name_.c_str());
     }
 }
 
+void FileProvider::rename(std::string file_name, size_t id) {
+    if (file_.is_open()) {
+        throw etl_error("Cannot rename a file being written");
+    }
+    if (fs::exists(file_name_)) {
+        fs::rename(file_name_, file_name);
+    }
+    file_name_ = std::move(file_name);
+    id_ = id;
+}
+
 std::string FileProvider::get_file_name() const { return file_name_; }
 
 size_t FileProvider::get_file_size() const { return file_size_; }
 
+FileReader::FileReader(const std::string& file_name, size_t offset, size_t file_size, thread_pool& pool,
+                       size_t chunk_size, ByteView start_key, std::optional<Bytes> end_key)
+    : pool_{pool},
+      chunk_size_{std::max<size_t>(chunk_size, sizeof(head_t))},
+      remaining_{file_size - offset},
+      end_key_{std::move(end_key)} {
+    if (!start_key.empty()) {
+        start_key_.assign(start_key);
+    }
+    file_.open(file_name, std::ios_base::in | std::ios_base::binary);
+    if (!file_.is_open() || !file_.seekg(static_cast<std::streamoff>(offset))) {
+        throw etl_error(errno2str(errno));
+    }
+    next_chunk_ = pool_.submit([this]() { return read_chunk(); });
+}
+
+FileReader::~FileReader() {
+    // Pending read ahead refers to this instance
+    if (next_chunk_.valid()) {
+        next_chunk_.wait();
+    }
+}
+
+bool FileReader::next() {
+    has_current_ = false;
+    while (true) {
+        if (chunk_pos_ == chunk_.size()) {
+            // Chunks hold whole records only: move to the one read ahead (if any) and request next one
+            if (!next_chunk_.valid()) {
+                return false;
+            }
+            chunk_ = next_chunk_.get();
+            chunk_pos_ = 0;
+            if (remaining_ || !tail_.empty()) {
+                next_chunk_ = pool_.submit([this]() { return read_chunk(); });
+            }
+            continue;
+        }
+
+        head_t head{};
+        std::memcpy(head.bytes, &chunk_[chunk_pos_], sizeof(head_t));
+        const uint8_t* data{&chunk_[chunk_pos_ + sizeof(head_t)]};
+        current_.key = ByteView{data, head.lengths[0]};
+        current_.value = ByteView{data + head.lengths[0], head.lengths[1]};
+        chunk_pos_ += sizeof(head_t) + current_.size();
+
+        if (!start_key_.empty()) {
+            if (current_.key < ByteView{start_key_}) {
+                continue;  // Still before requested range
+            }
+            start_key_.clear();
+        }
+        if (end_key_ && current_.key >= ByteView{*end_key_}) {
+            // Past requested range: no need to read further
+            chunk_pos_ = chunk_.size();
+            if (next_chunk_.valid()) {
+                next_chunk_.wait();
+                next_chunk_ = {};
+            }
+            return false;
+        }
+        has_current_ = true;
+        return true;
+    }
+}
+
+Bytes FileReader::read_chunk() {
+    Bytes data{std::move(tail_)};
+    tail_.clear();
+
+    size_t boundary{0};  // Position past last whole block in data
+    head_t head{};
+    do {
+        const size_t read_size{std::min(chunk_size_, remaining_)};
+        if (read_size) {
+            const size_t previous_size{data.size()};
+            data.resize(previous_size + read_size);
+            if (!file_.read(byte_ptr_cast(&data[previous_size]), static_cast<std::streamsize>(read_size))) {
+                throw etl_error(errno2str(errno));
+            }
+            remaining_ -= read_size;
+        }
+        while (boundary + sizeof(head_t) <= data.size()) {
+            std::memcpy(head.bytes, &data[boundary], sizeof(head_t));
+            const size_t block_size{sizeof(head_t) + head.lengths[0]};
+            if (boundary + block_size > data.size()) {
+                break;
+            }
+            boundary += block_size;
+        }
+        // A block larger than chunk_size_ needs more reads to be completed
+    } while (!boundary && remaining_);
+
+    if (boundary < data.size()) {
+        if (!remaining_) {
+            throw etl_error("Truncated block in file");
+        }
+        tail_.assign(data, boundary);
+        data.resize(boundary);
+    }
+
+    // Decompress blocks and restore full keys: the consumer gets plain records
+    Bytes chunk;
+    ByteView blocks{data};
+    while (!blocks.empty()) {
+        std::memcpy(head.bytes, blocks.data(), sizeof(head_t));
+        const ByteView compressed{blocks.substr(sizeof(head_t), head.lengths[0])};
+        blocks.remove_prefix(sizeof(head_t) + head.lengths[0]);
+        block_.resize(head.lengths[1]);
+        if (!snappy::RawUncompress(byte_ptr_cast(compressed.data()), compressed.size(), byte_ptr_cast(block_.data()))) {
+            throw etl_error("Invalid block in file");
+        }
+        decode_block(block_, chunk);
+    }
+    return chunk;
+}
+
 }  // namespace silkworm::etl
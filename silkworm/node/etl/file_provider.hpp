@@ -17,35 +17,108 @@
 #pragma once
 
 #include <fstream>
+#include <future>
 #include <memory>
 #include <optional>
+#include <vector>
 
+#include <silkworm/node/concurrency/thread_pool.hpp>
 #include <silkworm/node/etl/buffer.hpp>
 #include <silkworm/node/etl/util.hpp>
 
 namespace silkworm::etl {
 
+// An entry of the sparse index built while flushing a file (one per block)
+struct FileIndexEntry {
+    Bytes key;         // Key of the first record in block
+    size_t offset{0};  // Position of the block in file
+};
+
+class FileReader;
+
 /**
  * Provides an abstraction to flush data to disk
- * and re-read flushed data sequentially
+ * and re-read flushed data sequentially.
+ * Records are grouped in blocks compressed with Snappy where each key is stored
+ * as the suffix not shared with the previous one (first key of each block is stored in full).
+ * File layout is a sequence of: head_t{compressed size, raw size} + compressed block
  */
 class FileProvider {
   public:
+    static constexpr size_t kBlockSize{64_Kibi};  // Size of records grouped in a compressed block
+    static constexpr size_t kWriteSize{4_Mebi};   // Size of compressed data written at once
+
     FileProvider(std::string file_name, size_t id);
     ~FileProvider();
 
-    void flush(Buffer& buffer);                            // Write buffer's contents to disk
-    std::optional<std::pair<Entry, size_t>> read_entry();  // Read next data element from file starting from position 0
-    void reset();                                          // Remove the file when eof is met
+    void open(size_t data_size);  // Check disk space for data_size bytes and create the file
+    void flush(Buffer& buffer);   // Write buffer's contents to disk (file is created if not opened yet)
+    void reset();                 // Remove the file
+
+    //! \brief Moves the flushed file under a new name and id (e.g. when handed over to another collector)
+    void rename(std::string file_name, size_t id);
+
+    //! \brief Opens a sequential reader over the flushed records whose key lays in [start_key, end_key)
+    //! \param [in] pool : the pool where reads ahead are carried out
+    //! \param [in] chunk_size : the amount of bytes read ahead at once
+    [[nodiscard]] std::unique_ptr<FileReader> get_reader(thread_pool& pool, size_t chunk_size, ByteView start_key = {},
+                                                         std::optional<Bytes> end_key = std::nullopt) const;
+
+    [[nodiscard]] const std::vector<FileIndexEntry>& index() const { return index_; }
 
     std::string get_file_name() const;
     size_t get_file_size() const;
 
   private:
     size_t id_;
-    std::fstream file_;      // Actual file stream
-    std::string file_name_;  // Actual name of file
-    size_t file_size_{0};    // Actual size of written data
+    std::fstream file_;                  // Actual file stream
+    std::string file_name_;              // Actual name of file
+    size_t file_size_{0};                // Actual size of written (compressed) data
+    std::vector<FileIndexEntry> index_;  // Sparse index of written data
+};
+
+/**
+ * Reads the records of a flushed file sequentially.
+ * Data is read ahead and decompressed in chunks made of whole records on a separate thread
+ * and entries are exposed as views on current chunk (i.e. with no copy).
+ * Upon construction the reader is not positioned: call next() to get first record
+ */
+class FileReader {
+  public:
+    FileReader(const std::string& file_name, size_t offset, size_t file_size, thread_pool& pool, size_t chunk_size,
+               ByteView start_key, std::optional<Bytes> end_key);
+    ~FileReader();
+
+    // Not copyable nor movable
+    FileReader(const FileReader&) = delete;
+    FileReader& operator=(const FileReader&) = delete;
+
+    //! \brief Moves to the next record in range
+    //! \return Whether a record is available
+    bool next();
+
+    //! \brief Whether the reader is positioned on a record
+    [[nodiscard]] bool has_current() const noexcept { return has_current_; }
+
+    //! \brief Current record: viewed data remains valid until next() is called
+    [[nodiscard]] const EntryView& current() const noexcept { return current_; }
+
+  private:
+    Bytes read_chunk();  // Runs on read-ahead pool
+
+    std::ifstream file_;
+    thread_pool& pool_;
+    size_t chunk_size_;
+    size_t remaining_;     // Bytes in file still to be read
+    Bytes tail_;           // Incomplete block at the end of the last read (accessed by read-ahead task only)
+    Bytes block_;          // Decompressed block (accessed by read-ahead task only)
+    Bytes chunk_;          // Chunk of plain records being consumed
+    size_t chunk_pos_{0};  // Position of next record in chunk_
+    std::future<Bytes> next_chunk_;
+    Bytes start_key_;  // Records with lower keys are skipped
+    std::optional<Bytes> end_key_;
+    EntryView current_;
+    bool has_current_{false};
 };
 
 }  // namespace silkworm::etl
@@ -0,0 +1,87 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "file_provider.hpp"
+
+#include <algorithm>
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/node/common/directories.hpp>
+
+namespace silkworm::etl {
+
+static std::vector<Entry> read_all(FileReader& reader) {
+    std::vector<Entry> entries;
+    while (reader.next()) {
+        entries.push_back({Bytes{reader.current().key}, Bytes{reader.current().value}});
+    }
+    return entries;
+}
+
+TEST_CASE("FileProvider") {
+    TemporaryDirectory tmp_dir;
+    thread_pool pool{2};
+
+    // Many records sharing key prefixes, each key repeated so that same keys span more blocks
+    Buffer buffer{256_Mebi};
+    std::vector<Entry> expected;
+    for (size_t i{0}; i < 20'000; ++i) {
+        Bytes key(20, 0xaa);
+        key[18] = static_cast<uint8_t>(i / 2 / 256);
+        key[19] = static_cast<uint8_t>(i / 2 % 256);
+        Bytes value(i % 50, static_cast<uint8_t>(i));
+        expected.push_back({key, value});
+        buffer.put({key, value});
+    }
+    buffer.sort();
+    std::sort(expected.begin(), expected.end());
+
+    FileProvider provider{(tmp_dir.path() / "etl.bin").string(), 0};
+    provider.flush(buffer);
+    CHECK(provider.get_file_size() < buffer.size());
+    REQUIRE(provider.index().size() > 1);
+
+    SECTION("read all records") {
+        auto reader{provider.get_reader(pool, /*chunk_size=*/4_Kibi)};
+        const auto entries{read_all(*reader)};
+        REQUIRE(entries.size() == expected.size());
+        for (size_t i{0}; i < entries.size(); ++i) {
+            CHECK(entries[i].key == expected[i].key);
+            CHECK(entries[i].value == expected[i].value);
+        }
+    }
+
+    SECTION("read records in range starting at block boundaries") {
+        for (size_t i{1}; i + 1 < provider.index().size(); ++i) {
+            const Bytes start_key{provider.index()[i].key};
+            const Bytes end_key{provider.index()[i + 1].key};
+            auto reader{provider.get_reader(pool, /*chunk_size=*/1_Mebi, start_key, end_key)};
+            const auto entries{read_all(*reader)};
+
+            const auto first{std::lower_bound(expected.begin(), expected.end(), Entry{start_key, {}})};
+            const auto last{std::lower_bound(expected.begin(), expected.end(), Entry{end_key, {}})};
+            REQUIRE(entries.size() == static_cast<size_t>(std::distance(first, last)));
+            CHECK(std::equal(entries.begin(), entries.end(), first,
+                             [](const Entry& a, const Entry& b) { return a.key == b.key && a.value == b.value; }));
+        }
+    }
+
+    provider.reset();
+    CHECK_THROWS_AS(provider.get_reader(pool, 4_Kibi), etl_error);
+}
+
+}  // namespace silkworm::etl
@@ -0,0 +1,79 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace silkworm::etl {
+
+//! \brief Tournament tree of losers for k-way merging of sorted sources
+//! \details Leaves are the sources (identified by index), internal nodes keep the loser of the match played among
+//! their children and node 0 keeps the overall winner. After the winner source has advanced, replay() walks the
+//! path from its leaf to the root only, costing log2(k) comparisons against the ~2*log2(k) of a binary heap pop+push.
+//! \tparam Less a callable returning true if the current item of source a precedes the one of source b. Exhausted
+//! sources must compare greater than any other one
+template <class Less>
+class LoserTree {
+  public:
+    LoserTree(size_t size, Less less) : size_{size}, less_{std::move(less)}, tree_(size ? size : 1, 0) { init(); }
+
+    //! \brief Returns the index of the source holding the smallest item
+    [[nodiscard]] size_t top() const noexcept { return tree_[0]; }
+
+    //! \brief Restores the tree after the source returned by top() has advanced to its next item
+    void replay() {
+        size_t winner{tree_[0]};
+        for (size_t node{(winner + size_) / 2}; node > 0; node /= 2) {
+            if (less_(tree_[node], winner)) {
+                std::swap(tree_[node], winner);
+            }
+        }
+        tree_[0] = winner;
+    }
+
+  private:
+    void init() {
+        if (size_ < 2) {
+            return;
+        }
+        // Winners of each subtree: leaves are in [size_, 2 * size_)
+        std::vector<size_t> winners(2 * size_);
+        for (size_t i{0}; i < size_; ++i) {
+            winners[size_ + i] = i;
+        }
+        for (size_t node{size_ - 1}; node > 0; --node) {
+            const size_t left{winners[2 * node]};
+            const size_t right{winners[2 * node + 1]};
+            if (less_(right, left)) {
+                winners[node] = right;
+                tree_[node] = left;
+            } else {
+                winners[node] = left;
+                tree_[node] = right;
+            }
+        }
+        tree_[0] = winners[1];
+    }
+
+    size_t size_;
+    Less less_;
+    std::vector<size_t> tree_;
+};
+
+}  // namespace silkworm::etl
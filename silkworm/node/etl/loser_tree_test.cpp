@@ -0,0 +1,57 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "loser_tree.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include <catch2/catch.hpp>
+
+namespace silkworm::etl {
+
+TEST_CASE("LoserTree merges sorted sources") {
+    for (size_t num_sources : {1u, 2u, 3u, 7u, 16u}) {
+        std::vector<std::vector<int>> sources(num_sources);
+        std::vector<int> expected;
+        for (auto& source : sources) {
+            const size_t size{static_cast<size_t>(std::rand() % 50)};  // Some sources may be empty
+            for (size_t i{0}; i < size; ++i) {
+                source.push_back(std::rand() % 100);
+            }
+            std::sort(source.begin(), source.end());
+            expected.insert(expected.end(), source.begin(), source.end());
+        }
+        std::sort(expected.begin(), expected.end());
+
+        std::vector<size_t> positions(num_sources, 0);
+        auto less{[&](size_t a, size_t b) {
+            if (positions[a] == sources[a].size()) return false;
+            if (positions[b] == sources[b].size()) return true;
+            return sources[a][positions[a]] < sources[b][positions[b]];
+        }};
+        LoserTree tree{num_sources, less};
+
+        std::vector<int> merged;
+        for (size_t winner{tree.top()}; positions[winner] < sources[winner].size(); winner = tree.top()) {
+            merged.push_back(sources[winner][positions[winner]++]);
+            tree.replay();
+        }
+        CHECK(merged == expected);
+    }
+}
+
+}  // namespace silkworm::etl
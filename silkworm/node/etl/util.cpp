@@ -41,4 +41,12 @@ bool operator<(const Entry& a, const Entry& b) {
     return diff < 0;
 }
 
+bool operator<(const EntryView& a, const EntryView& b) {
+    auto diff{a.key.compare(b.key)};
+    if (diff == 0) {
+        return a.value < b.value;
+    }
+    return diff < 0;
+}
+
 }  // namespace silkworm::etl
@@ -46,4 +46,13 @@ struct Entry {
 
 bool operator<(const Entry& a, const Entry& b);
 
+// A non-owning view on a data chunk held in a read buffer
+struct EntryView {
+    ByteView key;
+    ByteView value;
+    [[nodiscard]] size_t size() const noexcept { return key.size() + value.size(); }
+};
+
+bool operator<(const EntryView& a, const EntryView& b);
+
 }  // namespace silkworm::etl
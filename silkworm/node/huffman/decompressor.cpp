@@ -192,33 +192,49 @@ const CodeWord* PatternTable::search_condensed(uint16_t code) const {
     if (bit_length_ <= condensed_table_bit_length_threshold_) {
         return codeword(code);
     } else {
-        CodeWord* previous{nullptr};
-        for (auto* current = head_; current != nullptr; previous = current, current = current->next()) {
+        // Plain scan with no move-to-front reordering: the table is shared by concurrent point reads
+        for (const auto& current : codewords_) {
             if (current->code() == code) {
-                if (previous != nullptr) {
-                    previous->set_next(current->next());
-                    current->set_next(head_);
-                    head_ = current;
-                }
-                return current;
+                return current.get();
             }
             const auto distance = code - current->code();
             if ((distance & 0x1) != 0) {
                 continue;
             }
             if (check_distance(current->code_length(), distance)) {
-                if (previous != nullptr) {
-                    previous->set_next(current->next());
-                    current->set_next(head_);
-                    head_ = current;
-                }
-                return current;
+                return current.get();
             }
         }
     }
     return nullptr;
 }
 
+uint32_t PatternTable::flatten(std::vector<FlatDecodingTable<ByteView>::Entry>& entries) const {
+    const auto table_offset{entries.size()};
+    const auto table_size{std::size_t(1) << bit_length_};
+    entries.resize(table_offset + table_size);
+    for (std::size_t code{0}; code < table_size; ++code) {
+        const CodeWord* cw = search_condensed(static_cast<uint16_t>(code));
+        if (cw == nullptr) {
+            continue;
+        }
+        if (cw->table() != nullptr) {
+            // Child tables are appended recursively, so link them by offset (entries may be reallocated)
+            const auto child_offset = cw->table()->flatten(entries);
+            auto& entry = entries[table_offset + code];
+            entry.child_offset = child_offset;
+            entry.code_length = static_cast<uint8_t>(bit_length_);
+            entry.child_bit_length = static_cast<uint8_t>(cw->table()->bit_length());
+        } else if (cw->code_length() > 0 || bit_length_ == 0) {
+            auto& entry = entries[table_offset + code];
+            entry.symbol = cw->pattern();
+            entry.code_length = cw->code_length();
+            entry.is_symbol = true;
+        }
+    }
+    return static_cast<uint32_t>(table_offset);
+}
+
 bool PatternTable::check_distance(std::size_t power, int distance) {
     const auto& distances = PatternTable::word_distances_[power];
     auto it = std::find_if(distances.cbegin(), distances.cend(), [distance](const int d) {
@@ -272,6 +288,28 @@ int PositionTable::build_tree(std::span<Position> positions, uint64_t highest_de
     return b0 + build_tree(positions.subspan(static_cast<std::size_t>(b0)), highest_depth - 1, (1 << bits) | code, bits + 1, depth + 1);
 }
 
+uint32_t PositionTable::flatten(std::vector<FlatDecodingTable<uint64_t>::Entry>& entries) const {
+    const auto table_offset{entries.size()};
+    const auto table_size{std::size_t(1) << bit_length_};
+    entries.resize(table_offset + table_size);
+    for (std::size_t code{0}; code < table_size; ++code) {
+        if (children_[code] != nullptr) {
+            // Child tables are appended recursively, so link them by offset (entries may be reallocated)
+            const auto child_offset = children_[code]->flatten(entries);
+            auto& entry = entries[table_offset + code];
+            entry.child_offset = child_offset;
+            entry.code_length = static_cast<uint8_t>(bit_length_);
+            entry.child_bit_length = static_cast<uint8_t>(children_[code]->bit_length());
+        } else if (lengths_[code] > 0 || bit_length_ == 0) {
+            auto& entry = entries[table_offset + code];
+            entry.symbol = positions_[code];
+            entry.code_length = lengths_[code];
+            entry.is_symbol = true;
+        }
+    }
+    return static_cast<uint32_t>(table_offset);
+}
+
 std::ostream& operator<<(std::ostream& out, const PositionTable& pt) {
     out << "Position Table:\n";
     out << "bit length: " << pt.bit_length_ << "\n";
@@ -346,6 +384,69 @@ bool Decompressor::read_ahead(ReadAheadFuncRef fn) {
     return fn(it);
 }
 
+std::vector<uint64_t> Decompressor::make_checkpoints(uint64_t step) const {
+    if (!compressed_file_) {
+        throw std::logic_error{"decompressor closed, call open first"};
+    }
+    if (step == 0) {
+        throw std::invalid_argument{"invalid zero checkpoint step"};
+    }
+    compressed_file_->advise_sequential();
+    auto _ = gsl::finally([&]() { compressed_file_->advise_random(); });
+
+    std::vector<uint64_t> checkpoints;
+    checkpoints.reserve((words_count_ + step - 1) / step);
+    Iterator it{this};
+    uint64_t word_index{0}, offset{0};
+    while (it.has_next()) {
+        if (word_index % step == 0) {
+            checkpoints.push_back(offset);
+        }
+        offset = it.skip();
+        ++word_index;
+    }
+    return checkpoints;
+}
+
+void Decompressor::check_checkpoints(std::span<const uint64_t> checkpoints, uint64_t step) const {
+    if (!compressed_file_) {
+        throw std::logic_error{"decompressor closed, call open first"};
+    }
+    if (step == 0) {
+        throw std::invalid_argument{"invalid zero checkpoint step"};
+    }
+    const uint64_t expected_checkpoints = (words_count_ + step - 1) / step;
+    if (checkpoints.size() != expected_checkpoints) {
+        throw std::runtime_error{"checkpoint count mismatch: expected=" + std::to_string(expected_checkpoints) +
+                                 " got=" + std::to_string(checkpoints.size()) + " in: " + compressed_path_.string()};
+    }
+}
+
+uint64_t Decompressor::read_word(uint64_t word_offset, Bytes& buffer) const {
+    Iterator it{make_iterator_at(word_offset)};
+    buffer.clear();
+    return it.next(buffer);
+}
+
+uint64_t Decompressor::read_word_uncompressed(uint64_t word_offset, Bytes& buffer) const {
+    Iterator it{make_iterator_at(word_offset)};
+    buffer.clear();
+    return it.next_uncompressed(buffer);
+}
+
+Decompressor::Iterator Decompressor::make_iterator_at(uint64_t word_offset) const {
+    if (!compressed_file_) {
+        throw std::logic_error{"decompressor closed, call open first"};
+    }
+    if (word_offset >= words_length_) {
+        throw std::out_of_range{"word offset " + std::to_string(word_offset) + " out of range in: " +
+                                compressed_path_.string()};
+    }
+    Iterator it{this};
+    it.reset(word_offset);
+    return it;
+}
+
 void Decompressor::close() {
     compressed_file_.reset();
 }
@@ -404,13 +505,18 @@ void Decompressor::read_patterns(ByteView dict) {
 
     SILK_INFO << "Pattern count: " << pattern_count << " highest depth: " << pattern_highest_depth;
 
-    pattern_dict_ = std::make_unique<PatternTable>(pattern_highest_depth);
+    PatternTable pattern_table{pattern_highest_depth};
     if (dict.length() > 0) {
-        pattern_dict_->build_condensed({patterns.begin(), pattern_count});
+        pattern_table.build_condensed({patterns.begin(), pattern_count});
     }
 
-    SILK_INFO << "#codewords: " << pattern_dict_->num_codewords();
-    SILK_TRACE << *pattern_dict_;
+    SILK_INFO << "#codewords: " << pattern_table.num_codewords();
+    SILK_TRACE << pattern_table;
+
+    // Patterns are views on the mapped file, so the flattened table does not need the tree used to build it
+    std::vector<FlatDecodingTable<ByteView>::Entry> entries;
+    pattern_table.flatten(entries);
+    pattern_dict_ = FlatDecodingTable<ByteView>{pattern_table.bit_length(), std::move(entries)};
 }
 
 void Decompressor::read_positions(ByteView dict) {
@@ -460,13 +566,17 @@ void Decompressor::read_positions(ByteView dict) {
 
     SILK_INFO << "Position count: " << position_count << " highest depth: " << position_highest_depth;
 
-    position_dict_ = std::make_unique<PositionTable>(position_highest_depth);
+    PositionTable position_table{position_highest_depth};
     if (dict.length() > 0) {
-        position_dict_->build({positions.begin(), position_count});
+        position_table.build({positions.begin(), position_count});
     }
 
-    SILK_INFO << "#positions: " << position_dict_->num_positions();
-    SILK_TRACE << *position_dict_;
+    SILK_INFO << "#positions: " << position_table.num_positions();
+    SILK_TRACE << position_table;
+
+    std::vector<FlatDecodingTable<uint64_t>::Entry> entries;
+    position_table.flatten(entries);
+    position_dict_ = FlatDecodingTable<uint64_t>{position_table.bit_length(), std::move(entries)};
 }
 
 Decompressor::Iterator::Iterator(const Decompressor* decoder) : decoder_(decoder) {}
@@ -502,11 +612,13 @@ uint64_t Decompressor::Iterator::next(Bytes& buffer) {
     SILK_TRACE << "Iterator::next buffer resized to: " << buffer.length();
 
     // Fill in the patterns
-    for (auto pos{next_position(false)}; pos != 0; pos = next_position(false)) {
+    for (auto pos{next_position(false)}; pos != 0;) {
         // Positions where to insert are encoded relative to one another
         buffer_position += pos - 1;
         const ByteView pattern = next_pattern();
-        SILK_TRACE << "Iterator::next data-from-patterns pos=" << pos << " pattern=" << to_hex(pattern);
+        // Decode next position while the pattern bytes prefetched by next_pattern are loaded
+        pos = next_position(false);
+        SILK_TRACE << "Iterator::next data-from-patterns pattern=" << to_hex(pattern);
         pattern.copy(buffer.data() + buffer_position, pattern.size(), 0);
     }
     if (bit_position_ > 0) {
@@ -646,35 +758,19 @@ void Decompressor::Iterator::reset(uint64_t data_offset) {
 }
 
 ByteView Decompressor::Iterator::next_pattern() {
-    const PatternTable* table = decoder_->pattern_dict_.get();
-    if (table->bit_length() == 0) {
-        return table->codeword(0)->pattern();
-    }
-    uint8_t length{0};
-    ByteView pattern{};
-    while (length == 0) {
-        const uint16_t code = next_code(table->bit_length());
-
-        const auto* codeword{table->search_condensed(code)};
-        if (codeword == nullptr) {
-            const auto error_msg =
-                "Unexpected missing codeword for code: " + std::to_string(code) +
-                " in snapshot: " + decoder_->compressed_path().string();
-            SILK_ERROR << error_msg;
-            throw std::runtime_error{error_msg};
-        }
-        length = codeword->code_length();
-        if (length == 0) {
-            table = codeword->table();
-            bit_position_ += 9;  // TODO(canepat) remove hard-coded value
-        } else {
-            bit_position_ += length;
-            pattern = codeword->pattern();
-        }
-        word_offset_ += bit_position_ / CHAR_BIT;
-        bit_position_ = bit_position_ % CHAR_BIT;
-    }
-    return pattern;
+    const ByteView* pattern = next_symbol(decoder_->pattern_dict_);
+    if (pattern == nullptr) {
+        const auto error_msg =
+            "Unexpected missing codeword at offset: " + std::to_string(word_offset_) +
+            " in snapshot: " + decoder_->compressed_path().string();
+        SILK_ERROR << error_msg;
+        throw std::runtime_error{error_msg};
+    }
+#if defined(__GNUC__) || defined(__clang__)
+    // Patterns are scattered across the dictionary, so start loading the bytes to copy as soon as possible
+    __builtin_prefetch(pattern->data());
+#endif
+    return *pattern;
 }
 
 uint64_t Decompressor::Iterator::next_position(bool clean) {
@@ -682,35 +778,50 @@ uint64_t Decompressor::Iterator::next_position(bool clean) {
         word_offset_++;
         bit_position_ = 0;
     }
-    const PositionTable* table = decoder_->position_dict_.get();
-    if (table->bit_length() == 0) {
-        return table->position(0);
-    }
-    uint8_t length{0};
-    uint64_t position{0};
-    while (length == 0) {
-        const uint16_t code = next_code(table->bit_length());
-        length = table->length(code);
-        if (length == 0) {
-            table = table->child(code);
-            bit_position_ += 9;  // TODO(canepat) remove hard-coded value
-        } else {
-            bit_position_ += length;
-            position = table->position(code);
-        }
+    const uint64_t* position = next_symbol(decoder_->position_dict_);
+    if (position == nullptr) {
+        throw std::runtime_error{"Unexpected missing position at offset: " + std::to_string(word_offset_) +
+                                 " in snapshot: " + decoder_->compressed_path().string()};
+    }
+    return *position;
+}
+
+template <typename Symbol>
+const Symbol* Decompressor::Iterator::next_symbol(const FlatDecodingTable<Symbol>& table) {
+    const auto* entries = table.entries();
+    if (table.bit_length() == 0) {
+        return entries[0].is_symbol ? &entries[0].symbol : nullptr;
+    }
+    std::size_t bit_length{table.bit_length()};
+    while (true) {
+        const auto& entry = entries[next_code(bit_length)];
+        bit_position_ += entry.code_length;
         word_offset_ += bit_position_ / CHAR_BIT;
         bit_position_ = bit_position_ % CHAR_BIT;
+        if (entry.is_symbol) {
+            return &entry.symbol;
+        }
+        if (entry.child_bit_length == 0) {
+            return nullptr;
+        }
+        entries = table.entries() + entry.child_offset;
+        bit_length = entry.child_bit_length;
     }
-    return position;
 }
 
-uint16_t Decompressor::Iterator::next_code(std::size_t bit_length) {
-    uint16_t code = static_cast<uint16_t>(decoder_->words_start_[word_offset_]) >> bit_position_;
-    if (static_cast<std::size_t>(CHAR_BIT - bit_position_) < bit_length && word_offset_ + 1 < data_size()) {
-        code |= decoder_->words_start_[word_offset_ + 1] << (CHAR_BIT - bit_position_);
+uint16_t Decompressor::Iterator::next_code(std::size_t bit_length) const {
+    // Load a 64-bit window starting at current byte: it covers any code because bit_length + bit_position_ <= 16
+    const uint8_t* data = decoder_->words_start_ + word_offset_;
+    const uint64_t available = word_offset_ < data_size() ? data_size() - word_offset_ : 0;
+    uint64_t window{0};
+    if (available >= sizeof(uint64_t)) {
+        window = endian::load_little_u64(data);
+    } else {
+        for (uint64_t i{0}; i < available; ++i) {
+            window |= uint64_t{data[i]} << (i * CHAR_BIT);
+        }
     }
-    code &= (1 << bit_length) - 1;
-    return code;
+    return static_cast<uint16_t>((window >> bit_position_) & ((uint64_t{1} << bit_length) - 1));
 }
 
 }  // namespace silkworm
@@ -16,19 +16,26 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <deque>
 #include <filesystem>
 #include <functional>
+#include <future>
 #include <memory>
 #include <ostream>
 #include <span>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <absl/functional/function_ref.h>
+#include <gsl/util>
 
 #include <silkworm/core/common/base.hpp>
 #include <silkworm/node/common/memory_mapped_file.hpp>
+#include <silkworm/node/concurrency/thread_pool.hpp>
 
 namespace silkworm {
 
@@ -46,6 +53,41 @@ class DecodingTable {
     std::size_t max_depth_;
 };
 
+//! Decoding table flattened into one contiguous array for fast lookups
+//! @details Each table level is a block of 2^bit_length entries indexed by code, child tables are laid out after their
+//! parent and linked by offset, so decoding a code never chases pointers nor touches the tree used to build the table
+template <typename Symbol>
+class FlatDecodingTable {
+  public:
+    struct Entry {
+        //! The decoded symbol, meaningful only if is_symbol is true
+        Symbol symbol{};
+        //! The offset of the first entry of the child table, meaningful only if is_symbol is false
+        uint32_t child_offset{0};
+        //! The number of bits consumed by this entry
+        uint8_t code_length{0};
+        //! The bit length of the child table, zero for symbols and for missing entries
+        uint8_t child_bit_length{0};
+        //! Flag indicating if this entry is a symbol or a link to a child table
+        bool is_symbol{false};
+    };
+
+    FlatDecodingTable() = default;
+    FlatDecodingTable(std::size_t bit_length, std::vector<Entry> entries)
+        : bit_length_{bit_length}, entries_{std::move(entries)} {}
+
+    [[nodiscard]] std::size_t bit_length() const { return bit_length_; }
+    [[nodiscard]] const Entry* entries() const { return entries_.data(); }
+    [[nodiscard]] std::size_t num_entries() const { return entries_.size(); }
+
+  private:
+    //! The bit length of the root table
+    std::size_t bit_length_{0};
+
+    //! The entries of all table levels
+    std::vector<Entry> entries_;
+};
+
 class PatternTable;
 
 class CodeWord {
@@ -106,6 +148,10 @@ class PatternTable : public DecodingTable {
 
     std::size_t build_condensed(std::span<Pattern> patterns);
 
+    //! Append the entries of this table and of its child tables to the specified flattened entries
+    //! @return the offset of the first entry of this table
+    uint32_t flatten(std::vector<FlatDecodingTable<ByteView>::Entry>& entries) const;
+
   private:
     static const WordDistances word_distances_;
     static std::size_t condensed_table_bit_length_threshold_;
@@ -122,7 +168,7 @@ class PatternTable : public DecodingTable {
     [[maybe_unused]] CodeWord* insert_word(std::shared_ptr<CodeWord> codeword);
 
     std::vector<std::shared_ptr<CodeWord>> codewords_;
-    mutable CodeWord* head_{nullptr};
+    CodeWord* head_{nullptr};
 
     friend std::ostream& operator<<(std::ostream& out, const PatternTable& pt);
 };
@@ -152,6 +198,10 @@ class PositionTable : public DecodingTable {
 
     int build(std::span<Position> positions);
 
+    //! Append the entries of this table and of its child tables to the specified flattened entries
+    //! @return the offset of the first entry of this table
+    uint32_t flatten(std::vector<FlatDecodingTable<uint64_t>::Entry>& entries) const;
+
   private:
     int build_tree(
         std::span<Position> positions,
@@ -176,6 +226,9 @@ class Decompressor {
     //! The max number of positions in decoding tables
     constexpr static std::size_t kMaxTablePositions = (1 << DecodingTable::kMaxTableBitLength) * 100;
 
+    //! The default number of words between two consecutive checkpoints
+    constexpr static uint64_t kDefaultCheckpointStep{16'384};
+
     //! Read-only access to the file data stream
     class Iterator {
       public:
@@ -184,6 +237,9 @@ class Decompressor {
         [[nodiscard]] std::size_t data_size() const { return decoder_->words_length_; }
         [[nodiscard]] bool has_next() const { return word_offset_ < decoder_->words_length_; }
 
+        //! The offset of the current word, meaningful only between words i.e. not in the middle of decoding
+        [[nodiscard]] uint64_t offset() const { return word_offset_; }
+
         //! Extract one *compressed* word from current offset in the file and append it to buffer
         //! After extracting current word, move at the beginning of the next one
         //! @return the next word position
@@ -216,7 +272,12 @@ class Decompressor {
         [[nodiscard]] uint64_t next_position(bool clean);
 
         //! Read next code from the data stream
-        [[nodiscard]] inline uint16_t next_code(std::size_t bit_length);
+        [[nodiscard]] inline uint16_t next_code(std::size_t bit_length) const;
+
+        //! Decode the next symbol from the data stream walking the specified flattened table
+        //! @return the decoded symbol or nullptr if no symbol matches the code
+        template <typename Symbol>
+        [[nodiscard]] const Symbol* next_symbol(const FlatDecodingTable<Symbol>& table);
 
         //! The decoder on which iterator works
         const Decompressor* decoder_;
@@ -244,9 +305,76 @@ class Decompressor {
     //! Read the data stream eagerly applying the specified function, expected read in sequential order
     bool read_ahead(ReadAheadFuncRef fn);
 
+    //! Compute the offsets of words 0, step, 2*step... skipping all the words in the data stream
+    //! @details Each checkpoint starts a range of step words that can be decoded independently of the others
+    [[nodiscard]] std::vector<uint64_t> make_checkpoints(uint64_t step) const;
+
+    //! Read the data stream on many threads decoding the disjoint ranges of words starting at the specified checkpoints
+    //! @param checkpoints the offsets of words 0, step, 2*step..., e.g. as computed by make_checkpoints or by an index
+    //! @param step the number of words in each range but the last one
+    //! @param workers the thread pool where the ranges are decoded, it must not be the pool of the calling thread
+    //! @param decode function decoding one range given its first word index, its word count and an iterator at its
+    //! first word, called concurrently on different ranges so it must be thread-safe
+    //! @param consume function applied to the results of decode on the calling thread, following the order of ranges
+    //! @details At most two ranges per worker are decoded ahead of consume, so memory usage stays bounded
+    //! @return true if consume returns true for all ranges, false otherwise
+    template <typename DecodeFunc, typename ConsumeFunc>
+    bool read_ahead_parallel(std::span<const uint64_t> checkpoints, uint64_t step, thread_pool& workers,
+                             DecodeFunc decode, ConsumeFunc consume) const {
+        using Result = std::invoke_result_t<DecodeFunc&, uint64_t, uint64_t, Iterator>;
+
+        check_checkpoints(checkpoints, step);
+        compressed_file_->advise_sequential();
+        auto advise_random = gsl::finally([&]() { compressed_file_->advise_random(); });
+
+        std::deque<std::future<Result>> pending_ranges;
+        // Ranges in flight must be done before leaving, because they refer to decode and to this decoder
+        auto wait_pending = gsl::finally([&]() {
+            for (auto& range : pending_ranges) {
+                if (range.valid()) range.wait();
+            }
+        });
+        const std::size_t max_pending_ranges{2 * std::size_t{workers.get_thread_count()}};
+        std::size_t next_range{0};
+        while (next_range < checkpoints.size() || !pending_ranges.empty()) {
+            while (next_range < checkpoints.size() && pending_ranges.size() < max_pending_ranges) {
+                const uint64_t first_word{next_range * step};
+                const uint64_t word_count{std::min(step, words_count_ - first_word)};
+                const Iterator it{make_iterator_at(checkpoints[next_range])};
+                pending_ranges.push_back(workers.submit([&decode, first_word, word_count, it]() {
+                    return decode(first_word, word_count, it);
+                }));
+                ++next_range;
+            }
+            Result result = pending_ranges.front().get();
+            pending_ranges.pop_front();
+            if (!consume(std::move(result))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    //! Decode exactly one *compressed* word starting at the specified offset in the data stream
+    //! @param word_offset the offset of the word in the data stream, e.g. as returned by a snapshot index
+    //! @param buffer the buffer where the word is stored, its previous content is discarded but capacity is reused
+    //! @details Point reads do not change any decoder state, so many threads can read concurrently from the same file
+    //! @return the offset of the next word
+    uint64_t read_word(uint64_t word_offset, Bytes& buffer) const;
+
+    //! Decode exactly one *uncompressed* word starting at the specified offset in the data stream
+    //! @see read_word
+    uint64_t read_word_uncompressed(uint64_t word_offset, Bytes& buffer) const;
+
     void close();
 
   private:
+    //! Check that the specified checkpoints split the data stream in ranges of step words, throw otherwise
+    void check_checkpoints(std::span<const uint64_t> checkpoints, uint64_t step) const;
+
+    //! Create an iterator positioned at the specified offset for a point read, checking the offset is valid
+    [[nodiscard]] Iterator make_iterator_at(uint64_t word_offset) const;
+
     void read_patterns(ByteView dict);
 
     void read_positions(ByteView dict);
@@ -264,10 +392,10 @@ class Decompressor {
     uint64_t empty_words_count_{0};
 
     //! The table of patterns used to decode the data words
-    std::unique_ptr<PatternTable> pattern_dict_;
+    FlatDecodingTable<ByteView> pattern_dict_;
 
     //! The table of positions used to decode the data words
-    std::unique_ptr<PositionTable> position_dict_;
+    FlatDecodingTable<uint64_t> position_dict_;
 
     //! The start offset of the data words
     uint8_t* words_start_{nullptr};
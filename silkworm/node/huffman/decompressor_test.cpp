@@ -20,6 +20,7 @@
 #include <map>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <vector>
 
@@ -169,6 +170,47 @@ TEST_CASE("PatternTable::search_condensed", "[silkworm][snapshot][decompressor]"
     CHECK(table2.search_condensed(0) == nullptr);
 }
 
+TEST_CASE("PatternTable::flatten", "[silkworm][snapshot][decompressor]") {
+    std::vector<FlatDecodingTable<ByteView>::Entry> entries;
+
+    SECTION("one level") {
+        Bytes v1{0x00, 0x11};
+        Bytes v2{0x00, 0x22};
+        std::vector<Pattern> patterns{{1, v1}, {2, v2}};
+        PatternTable table{2};
+        REQUIRE(table.build_condensed(patterns) == patterns.size());
+        CHECK(table.flatten(entries) == 0);
+        REQUIRE(entries.size() == 4);
+        CHECK(entries[0].is_symbol);
+        CHECK(entries[0].symbol == ByteView{v1});
+        CHECK(entries[0].code_length == 1);
+        CHECK(entries[1].is_symbol);
+        CHECK(entries[1].symbol == ByteView{v2});
+        CHECK(entries[1].code_length == 2);
+        CHECK(entries[2].is_symbol);
+        CHECK(entries[2].symbol == ByteView{v1});
+        CHECK(entries[2].code_length == 1);
+        CHECK_FALSE(entries[3].is_symbol);
+        CHECK(entries[3].child_bit_length == 0);
+    }
+
+    SECTION("two levels") {
+        Bytes v1{0x00, 0x11};
+        std::vector<Pattern> patterns{{12, v1}};
+        PatternTable table{12};
+        REQUIRE(table.build_condensed(patterns) == patterns.size());
+        CHECK(table.flatten(entries) == 0);
+        REQUIRE(entries.size() == (1 << 9) + (1 << 3));
+        CHECK_FALSE(entries[0].is_symbol);
+        CHECK(entries[0].code_length == 9);
+        CHECK(entries[0].child_offset == 1 << 9);
+        CHECK(entries[0].child_bit_length == 3);
+        CHECK(entries[1 << 9].is_symbol);
+        CHECK(entries[1 << 9].symbol == ByteView{v1});
+        CHECK(entries[1 << 9].code_length == 3);
+    }
+}
+
 TEST_CASE("PatternTable::operator<<", "[silkworm][snapshot][decompressor]") {
     PatternTable table1{0};
     CHECK_NOTHROW(test::null_stream() << table1);
@@ -188,6 +230,24 @@ TEST_CASE("PositionTable::PositionTable", "[silkworm][snapshot][decompressor]")
     CHECK(table.child(table.num_positions()) == nullptr);
 }
 
+TEST_CASE("PositionTable::flatten", "[silkworm][snapshot][decompressor]") {
+    std::vector<Position> positions{{1, 7}, {2, 11}};
+    PositionTable table{2};
+    REQUIRE(table.build(positions) == 2);
+    std::vector<FlatDecodingTable<uint64_t>::Entry> entries;
+    CHECK(table.flatten(entries) == 0);
+    REQUIRE(entries.size() == 4);
+    CHECK(entries[0].is_symbol);
+    CHECK(entries[0].symbol == 7);
+    CHECK(entries[0].code_length == 1);
+    CHECK(entries[1].is_symbol);
+    CHECK(entries[1].symbol == 11);
+    CHECK(entries[1].code_length == 2);
+    CHECK(entries[2].is_symbol);
+    CHECK(entries[2].symbol == 7);
+    CHECK_FALSE(entries[3].is_symbol);
+}
+
 TEST_CASE("PositionTable::operator<<", "[silkworm][snapshot][decompressor]") {
     PositionTable table{0};
     CHECK_NOTHROW(test::null_stream() << table);
@@ -454,4 +514,180 @@ TEST_CASE("Decompressor: lorem ipsum skip", "[silkworm][snapshot][decompressor]"
     });
 }
 
+TEST_CASE("Decompressor: lorem ipsum read_word", "[silkworm][snapshot][decompressor]") {
+    test::SetLogVerbosityGuard guard{log::Level::kNone};
+    test::TemporaryFile tmp_file{};
+    tmp_file.write(kLoremIpsumDict);
+    Decompressor decoder{tmp_file.path()};
+
+    SECTION("failure before open") {
+        Bytes word;
+        CHECK_THROWS_AS(decoder.read_word(0, word), std::logic_error);
+        CHECK_THROWS_AS(decoder.read_word_uncompressed(0, word), std::logic_error);
+    }
+
+    CHECK_NOTHROW(decoder.open());
+
+    // Collect the word offsets scanning the data stream sequentially
+    std::vector<uint64_t> word_offsets;
+    decoder.read_ahead([&](auto it) {
+        uint64_t offset{0};
+        while (it.has_next()) {
+            word_offsets.push_back(offset);
+            offset = it.skip();
+        }
+        return true;
+    });
+    REQUIRE(word_offsets.size() == kLoremIpsumWords.size());
+
+    const auto expected_word = [&](std::size_t i) {
+        const std::string word_plus_index{kLoremIpsumWords[i] + " " + std::to_string(i)};
+        return Bytes{word_plus_index.cbegin(), word_plus_index.cend()};
+    };
+
+    SECTION("random order") {
+        Bytes word;
+        for (std::size_t i{word_offsets.size()}; i > 0; --i) {
+            const auto next_offset = decoder.read_word(word_offsets[i - 1], word);
+            CHECK(word == expected_word(i - 1));
+            if (i < word_offsets.size()) {
+                CHECK(next_offset == word_offsets[i]);
+            }
+        }
+    }
+
+    SECTION("uncompressed") {
+        Bytes word;
+        for (std::size_t i{0}; i < word_offsets.size(); ++i) {
+            decoder.read_word_uncompressed(word_offsets[i], word);
+            CHECK(word == expected_word(i));
+        }
+    }
+
+    SECTION("concurrent readers") {
+        constexpr std::size_t kNumReaders{4};
+        std::vector<std::size_t> mismatches(kNumReaders, 0);
+        std::vector<std::thread> readers;
+        for (std::size_t r{0}; r < kNumReaders; ++r) {
+            readers.emplace_back([&, r]() {
+                Bytes word;
+                for (std::size_t i{r}; i < word_offsets.size() * kNumReaders; i += kNumReaders) {
+                    const std::size_t index{i % word_offsets.size()};
+                    decoder.read_word(word_offsets[index], word);
+                    if (word != expected_word(index)) {
+                        ++mismatches[r];
+                    }
+                }
+            });
+        }
+        for (auto& reader : readers) {
+            reader.join();
+        }
+        for (const auto mismatch_count : mismatches) {
+            CHECK(mismatch_count == 0);
+        }
+    }
+
+    SECTION("invalid offset") {
+        Bytes word;
+        CHECK_THROWS_AS(decoder.read_word(~uint64_t{0}, word), std::out_of_range);
+    }
+}
+
+TEST_CASE("Decompressor: lorem ipsum read_ahead_parallel", "[silkworm][snapshot][decompressor]") {
+    test::SetLogVerbosityGuard guard{log::Level::kNone};
+    test::TemporaryFile tmp_file{};
+    tmp_file.write(kLoremIpsumDict);
+    Decompressor decoder{tmp_file.path()};
+    thread_pool workers{4};
+    constexpr uint64_t kStep{7};
+
+    SECTION("failure before open") {
+        CHECK_THROWS_AS(decoder.make_checkpoints(kStep), std::logic_error);
+    }
+
+    CHECK_NOTHROW(decoder.open());
+
+    // Collect the word offsets scanning the data stream sequentially
+    std::vector<uint64_t> word_offsets;
+    decoder.read_ahead([&](auto it) {
+        uint64_t offset{0};
+        while (it.has_next()) {
+            word_offsets.push_back(offset);
+            offset = it.skip();
+        }
+        return true;
+    });
+    REQUIRE(word_offsets.size() == kLoremIpsumWords.size());
+
+    SECTION("make_checkpoints") {
+        const auto checkpoints = decoder.make_checkpoints(kStep);
+        REQUIRE(checkpoints.size() == (word_offsets.size() + kStep - 1) / kStep);
+        for (std::size_t k{0}; k < checkpoints.size(); ++k) {
+            CHECK(checkpoints[k] == word_offsets[k * kStep]);
+        }
+        CHECK_THROWS_AS(decoder.make_checkpoints(0), std::invalid_argument);
+    }
+
+    SECTION("words consumed in order") {
+        const auto checkpoints = decoder.make_checkpoints(kStep);
+        using RangeWords = std::pair<uint64_t, std::vector<Bytes>>;
+        auto decode_words = [](uint64_t first_word, uint64_t word_count, Decompressor::Iterator it) {
+            RangeWords range_words{first_word, {}};
+            for (uint64_t i{0}; i < word_count; ++i) {
+                Bytes word;
+                it.next(word);
+                range_words.second.push_back(std::move(word));
+            }
+            return range_words;
+        };
+        std::vector<Bytes> words;
+        auto collect_words = [&](RangeWords&& range_words) {
+            CHECK(range_words.first == words.size());
+            words.insert(words.end(), range_words.second.begin(), range_words.second.end());
+            return true;
+        };
+        CHECK(decoder.read_ahead_parallel(checkpoints, kStep, workers, decode_words, collect_words));
+        REQUIRE(words.size() == kLoremIpsumWords.size());
+        for (std::size_t i{0}; i < words.size(); ++i) {
+            const std::string word_plus_index{kLoremIpsumWords[i] + " " + std::to_string(i)};
+            CHECK(words[i] == Bytes{word_plus_index.cbegin(), word_plus_index.cend()});
+        }
+    }
+
+    SECTION("consume stops reading") {
+        const auto checkpoints = decoder.make_checkpoints(kStep);
+        std::size_t consumed_ranges{0};
+        auto count_words = [](uint64_t /*first_word*/, uint64_t word_count, Decompressor::Iterator it) {
+            for (uint64_t i{0}; i < word_count; ++i) {
+                it.skip();
+            }
+            return word_count;
+        };
+        auto stop_at_second_range = [&](uint64_t /*word_count*/) { return ++consumed_ranges < 2; };
+        CHECK_FALSE(decoder.read_ahead_parallel(checkpoints, kStep, workers, count_words, stop_at_second_range));
+        CHECK(consumed_ranges == 2);
+    }
+
+    SECTION("decode errors are rethrown") {
+        const auto checkpoints = decoder.make_checkpoints(kStep);
+        auto throw_error = [](uint64_t first_word, uint64_t /*word_count*/, Decompressor::Iterator /*it*/) -> bool {
+            if (first_word > 0) throw std::runtime_error{"decode error"};
+            return true;
+        };
+        auto ignore = [](bool) { return true; };
+        CHECK_THROWS_AS(decoder.read_ahead_parallel(checkpoints, kStep, workers, throw_error, ignore),
+                        std::runtime_error);
+    }
+
+    SECTION("checkpoint mismatch") {
+        const auto checkpoints = decoder.make_checkpoints(kStep);
+        auto unused = [](uint64_t, uint64_t, Decompressor::Iterator) { return true; };
+        auto ignore = [](bool) { return true; };
+        CHECK_THROWS_AS(decoder.read_ahead_parallel(checkpoints, kStep + 1, workers, unused, ignore),
+                        std::runtime_error);
+        CHECK_THROWS_AS(decoder.read_ahead_parallel(checkpoints, 0, workers, unused, ignore), std::invalid_argument);
+    }
+}
+
 }  // namespace silkworm
@@ -50,6 +50,8 @@
 #include <iostream>
 #include <limits>
 #include <span>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 #include <silkworm/core/common/assert.hpp>
@@ -108,6 +110,30 @@ class EliasFanoList32 {
         words_upper_bits_ = derive_fields();
     }
 
+    //! \brief Sets up a read-only list decoding its encoding in place (e.g. within a memory-mapped file)
+    //! \param [in] encoded : the encoding as written by operator<<, possibly followed by other data
+    explicit EliasFanoList32(ByteView encoded) {
+        if (encoded.size() < 2 * sizeof(uint64_t)) {
+            throw std::runtime_error{"EliasFanoList32: encoding too short: " + std::to_string(encoded.size())};
+        }
+        count_ = endian::load_big_u64(encoded.data());
+        u_ = endian::load_big_u64(encoded.data() + sizeof(uint64_t));
+        if (u_ == 0) throw std::runtime_error{"EliasFanoList32: invalid upper bound"};
+        max_offset_ = u_ - 1;
+        derive_sizes();
+        if ((encoded.size() - 2 * sizeof(uint64_t)) / sizeof(uint64_t) < total_words()) {
+            throw std::runtime_error{"EliasFanoList32: encoding too short for " + std::to_string(total_words()) + " words"};
+        }
+        words_ = encoded.data() + 2 * sizeof(uint64_t);
+    }
+
+    // Not copyable as words may refer to own data
+    EliasFanoList32(const EliasFanoList32&) = delete;
+    EliasFanoList32& operator=(const EliasFanoList32&) = delete;
+
+    //! \brief Returns the count of bytes taken by the encoding of this list
+    [[nodiscard]] std::size_t encoded_size() const { return (2 + total_words()) * sizeof(uint64_t); }
+
     [[nodiscard]] std::size_t count() const { return count_ + 1; }
 
     [[nodiscard]] std::size_t max() const { return max_offset_; }
@@ -120,9 +146,9 @@ class EliasFanoList32 {
         uint64_t lower = i * l_;
         uint64_t idx64 = lower / 64;
         uint64_t shift = lower % 64;
-        lower = lower_bits_[idx64] >> shift;
+        lower = lower_word(idx64) >> shift;
         if (shift > 0) {
-            lower |= lower_bits_[idx64 + 1] << (64 - shift);
+            lower |= lower_word(idx64 + 1) << (64 - shift);
         }
 
         const uint64_t jump_super_q = (i / kSuperQ) * kSuperQSize32;
@@ -130,15 +156,15 @@ class EliasFanoList32 {
         idx64 = jump_super_q + 1 + (jump_inside_super_q >> 1);
         shift = 32 * (jump_inside_super_q % 2);
         const uint64_t mask = 0xffffffff << shift;
-        const uint64_t jump = jump_[jump_super_q] + ((jump_[idx64] & mask) >> shift);
+        const uint64_t jump = jump_word(jump_super_q) + ((jump_word(idx64) & mask) >> shift);
 
         uint64_t current_word = jump / 64;
-        uint64_t window = upper_bits_[current_word] & (0xffffffffffffffff << (jump % 64));
+        uint64_t window = upper_word(current_word) & (0xffffffffffffffff << (jump % 64));
         uint64_t d = i & kQMask;
 
         for (auto bit_count{std::popcount(window)}; uint64_t(bit_count) <= d; bit_count = std::popcount(window)) {
             current_word++;
-            window = upper_bits_[current_word];
+            window = upper_word(current_word);
             d -= uint64_t(bit_count);
         }
 
@@ -200,20 +226,31 @@ class EliasFanoList32 {
 
   private:
     uint64_t derive_fields() {
+        derive_sizes();
+        data_.resize(total_words());
+        std::span data_span{data_.data(), data_.size()};
+        lower_bits_ = data_span.subspan(0, words_lower_bits_);
+        upper_bits_ = data_span.subspan(words_lower_bits_, words_upper_bits_);
+        jump_ = data_span.subspan(words_lower_bits_ + words_upper_bits_, jump_size_words());
+        words_ = reinterpret_cast<const uint8_t*>(data_.data());
+
+        return words_upper_bits_;
+    }
+
+    void derive_sizes() {
         l_ = u_ / (count_ + 1) == 0 ? 0 : 63 ^ uint64_t(std::countl_zero(u_ / (count_ + 1)));
         lower_bits_mask_ = (uint64_t(1) << l_) - 1;
 
-        uint64_t words_lower_bits = ((count_ + 1) * l_ + 63) / 64 + 1;
-        uint64_t words_upper_bits = ((count_ + 1) + (u_ >> l_) + 63) / 64;
-        uint64_t jump_words = jump_size_words();
-        uint64_t total_words = words_lower_bits + words_upper_bits + jump_words;
-        data_.resize(total_words);
-        std::span data_span{data_.data(), data_.size()};
-        lower_bits_ = data_span.subspan(0, words_lower_bits);
-        upper_bits_ = data_span.subspan(words_lower_bits, words_upper_bits);
-        jump_ = data_span.subspan(words_lower_bits + words_upper_bits, jump_words);
+        words_lower_bits_ = ((count_ + 1) * l_ + 63) / 64 + 1;
+        words_upper_bits_ = ((count_ + 1) + (u_ >> l_) + 63) / 64;
+    }
 
-        return words_upper_bits;
+    [[nodiscard]] uint64_t total_words() const { return words_lower_bits_ + words_upper_bits_ + jump_size_words(); }
+
+    [[nodiscard]] uint64_t lower_word(uint64_t i) const { return load_word(words_, i); }
+    [[nodiscard]] uint64_t upper_word(uint64_t i) const { return load_word(words_, words_lower_bits_ + i); }
+    [[nodiscard]] uint64_t jump_word(uint64_t i) const {
+        return load_word(words_, words_lower_bits_ + words_upper_bits_ + i);
     }
 
     [[nodiscard]] inline uint64_t jump_size_words() const {
@@ -234,7 +271,11 @@ class EliasFanoList32 {
     uint64_t l_{0};
     uint64_t max_offset_{0};
     uint64_t i_{0};
+    uint64_t words_lower_bits_{0};
     uint64_t words_upper_bits_{0};
+
+    //! The encoded words either in data_ or in place within an external encoding
+    const uint8_t* words_{nullptr};
 };
 
 //! 16-bit Double Elias-Fano list that used to encode *two* monotone non-decreasing sequences in RecSplit
@@ -243,6 +284,29 @@ class DoubleEliasFanoList16 {
   public:
     DoubleEliasFanoList16() = default;
 
+    //! \brief Sets up a read-only list decoding its encoding in place (e.g. within a memory-mapped file)
+    //! \param [in] encoded : the encoding as written by operator<<, possibly followed by other data
+    explicit DoubleEliasFanoList16(ByteView encoded) {
+        if (encoded.size() < kHeaderSize) {
+            throw std::runtime_error{"DoubleEliasFanoList16: encoding too short: " + std::to_string(encoded.size())};
+        }
+        read_header(encoded.data());
+        if ((encoded.size() - kHeaderSize) / sizeof(uint64_t) < total_words()) {
+            throw std::runtime_error{"DoubleEliasFanoList16: encoding too short for " + std::to_string(total_words()) +
+                                     " words"};
+        }
+        words_ = encoded.data() + kHeaderSize;
+    }
+
+    // Not copyable as words may refer to own data
+    DoubleEliasFanoList16(const DoubleEliasFanoList16&) = delete;
+    DoubleEliasFanoList16& operator=(const DoubleEliasFanoList16&) = delete;
+    DoubleEliasFanoList16(DoubleEliasFanoList16&&) = default;
+    DoubleEliasFanoList16& operator=(DoubleEliasFanoList16&&) = default;
+
+    //! \brief Returns the count of bytes taken by the encoding of this list
+    [[nodiscard]] std::size_t encoded_size() const { return kHeaderSize + total_words() * sizeof(uint64_t); }
+
     [[nodiscard]] const Uint64Sequence& data() const { return data_; }
 
     [[nodiscard]] uint64_t num_buckets() const { return num_buckets_; }
@@ -341,37 +405,69 @@ class DoubleEliasFanoList16 {
         window_cum_keys &= (uint64_t(0xffffffffffffffff) << select_cum_keys) << 1;
         while (window_cum_keys == 0) {
             curr_word_cum_keys++;
-            window_cum_keys = upper_bits_cum_keys[curr_word_cum_keys];
+            window_cum_keys = cum_keys_word(curr_word_cum_keys);
         }
         lower >>= l_position;
         cum_keys_next = ((curr_word_cum_keys * 64 + static_cast<uint64_t>(rho(window_cum_keys)) - i - 1) << l_cum_keys | (lower & lower_bits_mask_cum_keys)) + cum_delta + cum_keys_min_delta_;
     }
 
   private:
+    //! Size of the header fields preceding the encoded words
+    static constexpr std::size_t kHeaderSize{5 * sizeof(uint64_t)};
+
     std::pair<uint64_t, uint64_t> derive_fields() {
+        derive_sizes();
+        SILKWORM_ASSERT(l_cum_keys * 2 + l_position <= 56);
+
+        data_.resize(total_words());
+        auto first = data_.data();
+        lower_bits = std::span{first, first + words_lower_bits_};
+        first += words_lower_bits_;
+        upper_bits_cum_keys = std::span{first, first + words_cum_keys_};
+        first += words_cum_keys_;
+        upper_bits_position = std::span{first, first + words_position_};
+        first += words_position_;
+        jump = std::span{first, first + jump_size_words()};
+        words_ = reinterpret_cast<const uint8_t*>(data_.data());
+
+        return {words_cum_keys_, words_position_};
+    }
+
+    void derive_sizes() {
         l_position = u_position / (num_buckets_ + 1) == 0 ? 0 : 63 ^ uint64_t(std::countl_zero(u_position / (num_buckets_ + 1)));
         l_cum_keys = u_cum_keys / (num_buckets_ + 1) == 0 ? 0 : 63 ^ uint64_t(std::countl_zero(u_cum_keys / (num_buckets_ + 1)));
-        SILKWORM_ASSERT(l_cum_keys * 2 + l_position <= 56);
 
         lower_bits_mask_cum_keys = (1UL << l_cum_keys) - 1;
         lower_bits_mask_position = (1UL << l_position) - 1;
 
-        const uint64_t words_lower_bits = lower_bits_size_words();
-        const uint64_t words_cum_keys = cum_keys_size_words();
-        const uint64_t words_position = position_size_words();
-        const uint64_t jump_words = jump_size_words();
-        const uint64_t total_words = words_lower_bits + words_cum_keys + words_position + jump_words;
-        data_.resize(total_words);
-        auto first = data_.data();
-        lower_bits = std::span{first, first + words_lower_bits};
-        first += words_lower_bits;
-        upper_bits_cum_keys = std::span{first, first + words_cum_keys};
-        first += words_cum_keys;
-        upper_bits_position = std::span{first, first + words_position};
-        first += words_position;
-        jump = std::span{first, first + jump_words};
-
-        return {words_cum_keys, words_position};
+        words_lower_bits_ = lower_bits_size_words();
+        words_cum_keys_ = cum_keys_size_words();
+        words_position_ = position_size_words();
+    }
+
+    void read_header(const uint8_t* header) {
+        num_buckets_ = endian::load_big_u64(header);
+        u_cum_keys = endian::load_big_u64(header + sizeof(uint64_t));
+        u_position = endian::load_big_u64(header + 2 * sizeof(uint64_t));
+        cum_keys_min_delta_ = endian::load_big_u64(header + 3 * sizeof(uint64_t));
+        position_min_delta_ = endian::load_big_u64(header + 4 * sizeof(uint64_t));
+        derive_sizes();
+        if (l_cum_keys * 2 + l_position > 56) {
+            throw std::runtime_error{"DoubleEliasFanoList16: invalid lower bits widths"};
+        }
+    }
+
+    [[nodiscard]] uint64_t total_words() const {
+        return words_lower_bits_ + words_cum_keys_ + words_position_ + jump_size_words();
+    }
+
+    [[nodiscard]] uint64_t lower_word(uint64_t i) const { return load_word(words_, i); }
+    [[nodiscard]] uint64_t cum_keys_word(uint64_t i) const { return load_word(words_, words_lower_bits_ + i); }
+    [[nodiscard]] uint64_t position_word(uint64_t i) const {
+        return load_word(words_, words_lower_bits_ + words_cum_keys_ + i);
+    }
+    [[nodiscard]] uint64_t jump_word(uint64_t i) const {
+        return load_word(words_, words_lower_bits_ + words_cum_keys_ + words_position_ + i);
     }
 
     void get(const uint64_t i, uint64_t& cum_keys, uint64_t& position, uint64_t& window_cum_keys, uint64_t& select_cum_keys,
@@ -379,9 +475,9 @@ class DoubleEliasFanoList16 {
         const uint64_t pos_lower = i * (l_cum_keys + l_position);
         uint64_t idx64 = pos_lower / 64;
         uint64_t shift = pos_lower % 64;
-        lower = lower_bits[idx64] >> shift;
+        lower = lower_word(idx64) >> shift;
         if (shift > 0) {
-            lower |= lower_bits[idx64 + 1] << (64 - shift);
+            lower |= lower_word(idx64 + 1) << (64 - shift);
         }
 
         const uint64_t jump_super_q = (i / kSuperQ) * kSuperQSize16 * 2;
@@ -390,28 +486,28 @@ class DoubleEliasFanoList16 {
         idx64 = idx16 / 4;
         shift = 16 * (idx16 % 4);
         uint64_t mask = uint64_t(0xffff) << shift;
-        const uint64_t jump_cum_keys = jump[jump_super_q] + ((jump[idx64] & mask) >> shift);
+        const uint64_t jump_cum_keys = jump_word(jump_super_q) + ((jump_word(idx64) & mask) >> shift);
         idx16++;
         idx64 = idx16 / 4;
         shift = 16 * (idx16 % 4);
         mask = uint64_t(0xffff) << shift;
-        const uint64_t jump_position = jump[jump_super_q + 1] + ((jump[idx64] & mask) >> shift);
+        const uint64_t jump_position = jump_word(jump_super_q + 1) + ((jump_word(idx64) & mask) >> shift);
 
         curr_word_cum_keys = jump_cum_keys / 64;
         uint64_t curr_word_position = jump_position / 64;
-        window_cum_keys = upper_bits_cum_keys[curr_word_cum_keys] & (uint64_t(0xffffffffffffffff) << (jump_cum_keys % 64));
-        uint64_t window_position = upper_bits_position[curr_word_position] & (uint64_t(0xffffffffffffffff) << (jump_position % 64));
+        window_cum_keys = cum_keys_word(curr_word_cum_keys) & (uint64_t(0xffffffffffffffff) << (jump_cum_keys % 64));
+        uint64_t window_position = position_word(curr_word_position) & (uint64_t(0xffffffffffffffff) << (jump_position % 64));
         uint64_t delta_cum_keys = i & kQMask;
         uint64_t delta_position = i & kQMask;
 
         for (auto bit_count{std::popcount(window_cum_keys)}; uint64_t(bit_count) <= delta_cum_keys; bit_count = std::popcount(window_cum_keys)) {
             curr_word_cum_keys++;
-            window_cum_keys = upper_bits_cum_keys[curr_word_cum_keys];
+            window_cum_keys = cum_keys_word(curr_word_cum_keys);
             delta_cum_keys -= uint64_t(bit_count);
         }
         for (auto bit_count{std::popcount(window_position)}; uint64_t(bit_count) <= delta_position; bit_count = std::popcount(window_position)) {
             curr_word_position++;
-            window_position = upper_bits_position[curr_word_position];
+            window_position = position_word(curr_word_position);
             delta_position -= uint64_t(bit_count);
         }
 
@@ -446,6 +542,12 @@ class DoubleEliasFanoList16 {
     //! Minimum delta between successive positions
     uint64_t position_min_delta_{0};
 
+    //! Sizes in words of the sections of encoded words
+    uint64_t words_lower_bits_{0}, words_cum_keys_{0}, words_position_{0};
+
+    //! The encoded words either in data_ or in place within an external encoding
+    const uint8_t* words_{nullptr};
+
     [[nodiscard]] inline std::size_t lower_bits_size_words() const {
         return ((num_buckets_ + 1) * (l_cum_keys + l_position) + 63) / 64 + 1;
     }
@@ -492,36 +594,13 @@ class DoubleEliasFanoList16 {
     }
 
     friend std::istream& operator>>(std::istream& is, DoubleEliasFanoList16& ef) {
-        Bytes uint64_buffer(8, '\0');
-
-        is.read(reinterpret_cast<char*>(uint64_buffer.data()), sizeof(uint64_t));
-        ef.num_buckets_ = endian::load_big_u64(uint64_buffer.data());
-
-        is.read(reinterpret_cast<char*>(uint64_buffer.data()), sizeof(uint64_t));
-        ef.u_cum_keys = endian::load_big_u64(uint64_buffer.data());
-
-        is.read(reinterpret_cast<char*>(uint64_buffer.data()), sizeof(uint64_t));
-        ef.u_position = endian::load_big_u64(uint64_buffer.data());
+        Bytes header(kHeaderSize, '\0');
+        is.read(reinterpret_cast<char*>(header.data()), static_cast<std::streamsize>(kHeaderSize));
+        ef.read_header(header.data());
 
-        is.read(reinterpret_cast<char*>(uint64_buffer.data()), sizeof(uint64_t));
-        ef.cum_keys_min_delta_ = endian::load_big_u64(uint64_buffer.data());
-
-        is.read(reinterpret_cast<char*>(uint64_buffer.data()), sizeof(uint64_t));
-        ef.position_min_delta_ = endian::load_big_u64(uint64_buffer.data());
-
-        ef.l_position = ef.u_position / (ef.num_buckets_ + 1) == 0 ? 0 : static_cast<uint64_t>(lambda(ef.u_position / (ef.num_buckets_ + 1)));
-        ef.l_cum_keys = ef.u_cum_keys / (ef.num_buckets_ + 1) == 0 ? 0 : static_cast<uint64_t>(lambda(ef.u_cum_keys / (ef.num_buckets_ + 1)));
-        SILKWORM_ASSERT(ef.l_cum_keys * 2 + ef.l_position <= 56);
-
-        ef.lower_bits_mask_cum_keys = (1UL << ef.l_cum_keys) - 1;
-        ef.lower_bits_mask_position = (1UL << ef.l_position) - 1;
-
-        // Erigon assumes that data fills up the stream until the end
-        int read_count{0};
-        while (!is.eof()) {
-            is.read(reinterpret_cast<char*>(ef.data_.data() + read_count), static_cast<std::streamsize>(sizeof(uint64_t)));
-            ++read_count;
-        }
+        // Erigon does not write data size: it is derived from header fields
+        ef.derive_fields();
+        is.read(reinterpret_cast<char*>(ef.data_.data()), static_cast<std::streamsize>(ef.data_.size() * sizeof(uint64_t)));
         return is;
     }
 };
@@ -48,8 +48,12 @@
 #include <cstdint>
 #include <cstdio>
 #include <iostream>
+#include <stdexcept>
+#include <string>
 
 #include <silkworm/core/common/assert.hpp>
+#include <silkworm/core/common/base.hpp>
+#include <silkworm/core/common/endian.hpp>
 #include <silkworm/node/recsplit/encoding/sequence.hpp>
 #include <silkworm/node/recsplit/support/common.hpp>
 
@@ -116,24 +120,47 @@ class GolombRiceVector {
     };
 
     GolombRiceVector() = default;
-    explicit GolombRiceVector(std::vector<uint64_t>&& input_data) : data(std::move(input_data)) {}
+    explicit GolombRiceVector(std::vector<uint64_t>&& input_data)
+        : data(std::move(input_data)), words(reinterpret_cast<const uint8_t*>(data.data())), word_count(data.size()) {}
+
+    //! \brief Sets up a read-only vector decoding its encoding in place (e.g. within a memory-mapped file)
+    //! \param [in] encoded : the encoding as written by operator<<, possibly followed by other data
+    explicit GolombRiceVector(ByteView encoded) {
+        if (encoded.size() < sizeof(uint64_t)) {
+            throw std::runtime_error{"GolombRiceVector: encoding too short: " + std::to_string(encoded.size())};
+        }
+        word_count = endian::load_big_u64(encoded.data());
+        if ((encoded.size() - sizeof(uint64_t)) / sizeof(uint64_t) < word_count) {
+            throw std::runtime_error{"GolombRiceVector: encoding too short for " + std::to_string(word_count) + " words"};
+        }
+        words = encoded.data() + sizeof(uint64_t);
+    }
 
-    [[nodiscard]] size_t size() const { return data.size(); }
+    // Not copyable as words may refer to own data
+    GolombRiceVector(const GolombRiceVector&) = delete;
+    GolombRiceVector& operator=(const GolombRiceVector&) = delete;
+    GolombRiceVector(GolombRiceVector&&) = default;
+    GolombRiceVector& operator=(GolombRiceVector&&) = default;
+
+    [[nodiscard]] size_t size() const { return word_count; }
+
+    //! \brief Returns the count of bytes taken by the encoding of this vector
+    [[nodiscard]] size_t encoded_size() const { return sizeof(uint64_t) + word_count * sizeof(uint64_t); }
 
     class Reader {
       public:
-        explicit Reader(Uint64Sequence& input_data) : data(input_data) {}
+        explicit Reader(const uint8_t* input_data) : data(input_data) {}
 
         uint64_t read_next(const uint64_t log2golomb) {
             uint64_t result = 0;
 
             if (curr_window_unary == 0) {
                 result += valid_lower_bits_unary;
-                curr_window_unary = *(curr_ptr_unary++);
+                curr_window_unary = load_word(data, curr_word_unary++);
                 valid_lower_bits_unary = 64;
                 while (curr_window_unary == 0) {
                     [[unlikely]] result += 64;
-                    curr_window_unary = *(curr_ptr_unary++);
+                    curr_window_unary = load_word(data, curr_word_unary++);
                 }
             }
 
@@ -147,7 +174,7 @@ class GolombRiceVector {
             result <<= log2golomb;
 
             uint64_t fixed;
-            std::memcpy(&fixed, reinterpret_cast<const uint8_t*>(data.data()) + curr_fixed_offset / 8, 8);
+            std::memcpy(&fixed, data + curr_fixed_offset / 8, 8);
             result |= (fixed >> curr_fixed_offset % 8) & ((uint64_t(1) << log2golomb) - 1);
             curr_fixed_offset += log2golomb;
             return result;
@@ -157,7 +184,7 @@ class GolombRiceVector {
             SILKWORM_ASSERT(nodes > 0);
             std::size_t missing = nodes, cnt;
             while ((cnt = static_cast<std::size_t>(nu(curr_window_unary))) < missing) {
-                curr_window_unary = *(curr_ptr_unary++);
+                curr_window_unary = load_word(data, curr_word_unary++);
                 missing -= cnt;
                 valid_lower_bits_unary = 64;
             }
@@ -173,24 +200,28 @@ class GolombRiceVector {
             // assert(bit_pos < bit_count);
             curr_fixed_offset = bit_pos;
             size_t unary_pos = bit_pos + unary_offset;
-            curr_ptr_unary = data.data() + unary_pos / 64;
-            curr_window_unary = *(curr_ptr_unary++) >> (unary_pos & 63);
+            curr_word_unary = unary_pos / 64;
+            curr_window_unary = load_word(data, curr_word_unary++) >> (unary_pos & 63);
             valid_lower_bits_unary = 64 - (unary_pos & 63);
         }
 
       private:
-        Uint64Sequence& data;
+        const uint8_t* data;
         std::size_t curr_fixed_offset{0};
         uint64_t curr_window_unary{0};
-        uint64_t* curr_ptr_unary{nullptr};
+        std::size_t curr_word_unary{0};
         std::size_t valid_lower_bits_unary{0};
     };
 
-    Reader reader() { return Reader{data}; }
+    [[nodiscard]] Reader reader() const { return Reader{words}; }
 
   private:
     Uint64Sequence data;
 
+    //! The encoded words either in data or in place within an external encoding
+    const uint8_t* words{nullptr};
+    std::size_t word_count{0};
+
     friend std::ostream& operator<<(std::ostream& os, const GolombRiceVector& rbv) {
         os << rbv.data;
         return os;
@@ -198,6 +229,8 @@ class GolombRiceVector {
 
     friend std::istream& operator>>(std::istream& is, GolombRiceVector& rbv) {
         is >> rbv.data;
+        rbv.words = reinterpret_cast<const uint8_t*>(rbv.data.data());
+        rbv.word_count = rbv.data.size();
         return is;
     }
 };
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <vector>
 
@@ -31,6 +32,13 @@ using UnsignedIntegralSequence = std::vector<T>;
 using Uint32Sequence = UnsignedIntegralSequence<uint32_t>;
 using Uint64Sequence = UnsignedIntegralSequence<uint64_t>;
 
+//! \brief Loads the i-th 64-bit word of a sequence with no alignment requirement (e.g. within a memory-mapped file)
+inline uint64_t load_word(const uint8_t* words, std::size_t i) {
+    uint64_t word;
+    std::memcpy(&word, words + i * sizeof(uint64_t), sizeof(uint64_t));
+    return word;
+}
+
 template <UnsignedIntegral T>
 std::ostream& operator<<(std::ostream& os, const UnsignedIntegralSequence<T>& s) {
     // Serialize the integer sequence size using 8-bytes
@@ -69,6 +69,7 @@
 #include <silkworm/core/common/assert.hpp>
 #include <silkworm/core/common/endian.hpp>
 #include <silkworm/node/common/log.hpp>
+#include <silkworm/node/common/memory_mapped_file.hpp>
 #include <silkworm/node/etl/collector.hpp>
 
 #pragma GCC diagnostic push
@@ -186,8 +187,8 @@ class RecSplit {
           base_data_id_(settings.base_data_id),
           index_path_(settings.index_path),
           double_enum_index_(settings.double_enum_index),
-          offset_collector_(settings.etl_optimal_size),
-          bucket_collector_(settings.etl_optimal_size) {
+          offset_collector_(std::make_unique<etl::Collector>(settings.etl_optimal_size)),
+          bucket_collector_(std::make_unique<etl::Collector>(settings.etl_optimal_size)) {
         bucket_size_accumulator_.reserve(bucket_count_ + 1);
         bucket_position_accumulator_.reserve(bucket_count_ + 1);
         bucket_size_accumulator_.resize(1);      // Start with 0 as bucket accumulated size
@@ -203,6 +204,93 @@ class RecSplit {
         hasher_ = std::make_unique<Murmur3>(salt_);
     }
 
+    //! \brief Opens an existing index file for lookups, memory-mapping it
+    //! \details Golomb-Rice codes and Elias-Fano lists are decoded in place: no index data is copied or allocated
+    //! \param [in] index_path : the path of the index file as written by build()
+    explicit RecSplit(std::filesystem::path index_path)
+        : index_path_{std::move(index_path)},
+          encoded_file_{std::make_unique<MemoryMappedFile>(index_path_)} {
+        const uint8_t* address{encoded_file_->address()};
+        const std::size_t length{encoded_file_->length()};
+        const auto ensure_available{[&](std::size_t offset, std::size_t size) {
+            if (offset > length || length - offset < size) {
+                throw std::runtime_error{"index file is too short: " + index_path_.string()};
+            }
+        }};
+
+        // Read app-specific data ID, number of keys and bytes per index record
+        std::size_t offset{0};
+        ensure_available(offset, 2 * sizeof(uint64_t) + sizeof(uint8_t));
+        base_data_id_ = endian::load_big_u64(address);
+        key_count_ = endian::load_big_u64(address + sizeof(uint64_t));
+        keys_added_ = key_count_;
+        bytes_per_record_ = address[2 * sizeof(uint64_t)];
+        if (bytes_per_record_ > sizeof(uint64_t)) {
+            throw std::runtime_error{"invalid bytes per record: " + std::to_string(bytes_per_record_)};
+        }
+        record_mask_ = bytes_per_record_ == sizeof(uint64_t) ? std::numeric_limits<uint64_t>::max()
+                                                             : (uint64_t(1) << (8 * bytes_per_record_)) - 1;
+        offset = kRecordsOffset;
+
+        // Skip index records: they are read in place on lookup
+        ensure_available(offset, key_count_ * bytes_per_record_);
+        offset += key_count_ * bytes_per_record_;
+
+        // Read bucket count, bucket size, leaf size
+        ensure_available(offset, sizeof(uint64_t) + 2 * sizeof(uint16_t) + sizeof(uint32_t) + sizeof(uint8_t));
+        bucket_count_ = endian::load_big_u64(address + offset);
+        offset += sizeof(uint64_t);
+        bucket_size_ = endian::load_big_u16(address + offset);
+        offset += sizeof(uint16_t);
+        const uint16_t leaf_size = endian::load_big_u16(address + offset);
+        if (leaf_size != LEAF_SIZE) {
+            throw std::runtime_error{"index leaf size " + std::to_string(leaf_size) + " while expected " +
+                                     std::to_string(LEAF_SIZE)};
+        }
+        offset += sizeof(uint16_t);
+
+        // Read salt
+        salt_ = endian::load_big_u32(address + offset);
+        offset += sizeof(uint32_t);
+        hasher_ = std::make_unique<Murmur3>(salt_);
+
+        // Read start seeds: they must match the ones used here in lookups
+        const uint8_t start_seed_length = address[offset];
+        offset += sizeof(uint8_t);
+        if (start_seed_length != sizeof(kStartSeed) / sizeof(uint64_t)) {
+            throw std::runtime_error{"index start seed length mismatch: " + std::to_string(start_seed_length)};
+        }
+        ensure_available(offset, start_seed_length * sizeof(uint64_t) + sizeof(uint8_t));
+        for (const uint64_t s : kStartSeed) {
+            if (endian::load_big_u64(address + offset) != s) {
+                throw std::runtime_error{"index start seed mismatch: " + index_path_.string()};
+            }
+            offset += sizeof(uint64_t);
+        }
+
+        // Read index flag and Elias-Fano code for offsets (if any)
+        double_enum_index_ = address[offset] != 0;
+        offset += sizeof(uint8_t);
+        if (double_enum_index_) {
+            ef_offsets_ = std::make_unique<EliasFano>(ByteView{address + offset, length - offset});
+            offset += ef_offsets_->encoded_size();
+        }
+
+        // Read the number of Golomb-Rice code params: Erigon writes 4-instead-of-2 bytes here
+        ensure_available(offset, sizeof(uint32_t));
+        offset += sizeof(uint32_t);
+
+        // Read Golomb-Rice code
+        golomb_rice_codes_ = GolombRiceVector{ByteView{address + offset, length - offset}};
+        offset += golomb_rice_codes_.encoded_size();
+
+        // Read Elias-Fano code for bucket cumulative keys and bit positions
+        double_ef_index_ = DoubleEliasFano{ByteView{address + offset, length - offset}};
+
+        encoded_file_->advise_random();
+        built_ = true;
+    }
+
     void add_key(const hash128_t& key_hash, uint64_t offset) {
         if (built_) {
             throw std::logic_error{"cannot add key after perfect hash function has been built"};
@@ -229,13 +317,13 @@ class RecSplit {
         }
 
         if (double_enum_index_) {
-            offset_collector_.collect({offset_key, {}});
+            offset_collector_->collect({offset_key, {}});
 
             Bytes current_key_count(8, '\0');
             endian::store_big_u64(current_key_count.data(), keys_added_);
-            bucket_collector_.collect({bucket_key, current_key_count});
+            bucket_collector_->collect({bucket_key, current_key_count});
         } else {
-            bucket_collector_.collect({bucket_key, offset_key});
+            bucket_collector_->collect({bucket_key, offset_key});
         }
         keys_added_++;
         previous_offset_ = offset;
@@ -289,7 +377,7 @@ class RecSplit {
 
         current_bucket_id_ = std::numeric_limits<uint64_t>::max();  // To make sure 0 bucket is detected
 
-        auto bucket_collector_clear = gsl::finally([&]() { bucket_collector_.clear(); });
+        auto bucket_collector_clear = gsl::finally([&]() { bucket_collector_->clear(); });
         SILK_INFO << "[index] calculating file=" << index_path_.string();
 
         // We use an exception for collision error condition because ETL currently does not support loading errors
@@ -301,7 +389,7 @@ class RecSplit {
         try {
             // Passing a void cursor is valid case for ETL when DB modification is not expected
             mdbx::cursor empty_cursor{};
-            bucket_collector_.load(empty_cursor, [&](const etl::Entry& entry, mdbx::cursor&, MDBX_put_flags_t) {
+            bucket_collector_->load(empty_cursor, [&](const etl::Entry& entry, mdbx::cursor&, MDBX_put_flags_t) {
                 // k is the big-endian encoding of the bucket number and the v is the key that is assigned into that bucket
                 const uint64_t bucket_id = endian::load_big_u64(entry.key.data());
                 SILK_TRACE << "[index] processing bucket_id=" << bucket_id;
@@ -330,7 +418,7 @@ class RecSplit {
         if (double_enum_index_) {
             ef_offsets_ = std::make_unique<EliasFano>(keys_added_, max_offset_);
             mdbx::cursor empty_cursor{};
-            offset_collector_.load(empty_cursor, [&](const etl::Entry& entry, mdbx::cursor&, MDBX_put_flags_t) {
+            offset_collector_->load(empty_cursor, [&](const etl::Entry& entry, mdbx::cursor&, MDBX_put_flags_t) {
                 const uint64_t offset = endian::load_big_u64(entry.key.data());
                 ef_offsets_->add_offset(offset);
             });
@@ -406,8 +494,8 @@ class RecSplit {
     void reset_new_salt() {
         built_ = false;
         keys_added_ = 0;
-        bucket_collector_.clear();
-        offset_collector_.clear();
+        bucket_collector_->clear();
+        offset_collector_->clear();
         current_bucket_.clear();
         current_bucket_offsets_.clear();
         max_offset_ = 0;
@@ -423,7 +511,7 @@ class RecSplit {
      * @param hash a 128-bit hash.
      * @return the associated value.
      */
-    size_t operator()(const hash128_t& hash) {
+    size_t operator()(const hash128_t& hash) const {
         if (!built_) throw std::logic_error{"perfect hash function not built yet"};
 
         const std::size_t bucket = hash128_to_bucket(hash);
@@ -482,16 +570,47 @@ class RecSplit {
     //! Return the number of keys used to build the RecSplit instance
     inline size_t size() const { return key_count_; }
 
+    //! \brief Returns the value stored in the index record of the given key
+    //! \details This is the key ordinal if double enum index is enabled, its data offset otherwise
+    //! \remarks The result is meaningless for keys not used to build the index
+    [[nodiscard]] uint64_t lookup(ByteView key) const {
+        if (!encoded_file_) throw std::logic_error{"lookup requires an index file opened for reading"};
+        if (key_count_ == 0) throw std::logic_error{"lookup in empty index: " + index_path_.string()};
+
+        const std::size_t record{key_count_ == 1 ? 0 : operator()(murmur_hash_3(key.data(), key.size()))};
+
+        // Read 8 bytes ending at the end of the record, the leading ones belonging to previous records or header
+        const std::size_t position{kRecordsOffset + bytes_per_record_ * (record + 1) - sizeof(uint64_t)};
+        return endian::load_big_u64(encoded_file_->address() + position) & record_mask_;
+    }
+
+    //! \brief Returns the data offset of the key having the given ordinal (requires double enum index)
+    [[nodiscard]] uint64_t ordinal_lookup(uint64_t i) const {
+        if (!ef_offsets_) throw std::logic_error{"ordinal lookup requires double enum index: " + index_path_.string()};
+        return ef_offsets_->get(i);
+    }
+
+    //! \brief Returns the minimal app-specific ID of entries of this index
+    [[nodiscard]] uint64_t base_data_id() const { return base_data_id_; }
+
+    //! \brief Returns whether this index has the two levels "recsplit -> enum" and "enum -> offset"
+    [[nodiscard]] bool double_enum_index() const { return double_enum_index_; }
+
   private:
     static inline std::size_t skip_bits(std::size_t m) { return memo[m] & 0xFFFF; }
 
     static inline std::size_t skip_nodes(std::size_t m) { return (memo[m] >> 16) & 0x7FF; }
 
     static constexpr uint64_t golomb_param(const std::size_t m, const std::array<uint32_t, kMaxBucketSize>& memo) {
-        if (m > golomb_param_max_index_) golomb_param_max_index_ = m;
         return memo[m] >> 27;
     }
 
+    //! Same as golomb_param also tracking the max index used, to be called only when building
+    static uint64_t golomb_param_for_build(const std::size_t m, const std::array<uint32_t, kMaxBucketSize>& memo) {
+        if (m > golomb_param_max_index_) golomb_param_max_index_ = m;
+        return golomb_param(m, memo);
+    }
+
     // Generates the precomputed table of 32-bit values holding the Golomb-Rice code
     // of a splitting (upper 5 bits), the number of nodes in the associated subtree
     // (following 11 bits) and the sum of the Golomb-Rice code lengths in the same
@@ -572,7 +691,7 @@ class RecSplit {
             for (const auto offset : current_bucket_offsets_) {
                 Bytes uint64_buffer(8, '\0');
                 endian::store_big_u64(uint64_buffer.data(), offset);
-                index_output_stream.write(reinterpret_cast<const char*>(uint64_buffer.data()), 8);
+                index_output_stream.write(reinterpret_cast<const char*>(uint64_buffer.data() + (8 - bytes_per_record_)), bytes_per_record_);
                 SILK_DEBUG << "[index] written offset: " << offset;
             }
         }
@@ -642,7 +761,7 @@ class RecSplit {
                 }
             }
             salt -= kStartSeed[level];
-            const auto log2golomb = golomb_param(m, memo);
+            const auto log2golomb = golomb_param_for_build(m, memo);
             gr_builder_.append_fixed(salt, log2golomb);
             unary.push_back(static_cast<uint32_t>(salt >> log2golomb));
         } else {
@@ -677,7 +796,7 @@ class RecSplit {
             std::copy(buffer_offsets_.data(), buffer_offsets_.data() + m, offsets.data() + start);
 
             salt -= kStartSeed[level];
-            const auto log2golomb = golomb_param(m, memo);
+            const auto log2golomb = golomb_param_for_build(m, memo);
             gr_builder_.append_fixed(salt, log2golomb);
             unary.push_back(static_cast<uint32_t>(salt >> log2golomb));
 
@@ -698,7 +817,7 @@ class RecSplit {
         }
     }
 
-    hash128_t inline murmur_hash_3(const void* data, const size_t length) {
+    hash128_t inline murmur_hash_3(const void* data, const size_t length) const {
         hash128_t h{};
         hasher_->hash_x64_128(data, length, &h);
         return h;
@@ -733,6 +852,9 @@ class RecSplit {
         return is;
     }
 
+    //! Offset of the index records in index file: right after app-specific data ID, number of keys and bytes per record
+    static constexpr std::size_t kRecordsOffset{2 * sizeof(uint64_t) + sizeof(uint8_t)};
+
     static const std::size_t kLowerAggregationBound;
 
     static const std::size_t kUpperAggregationBound;
@@ -802,10 +924,16 @@ class RecSplit {
     bool built_{false};
 
     //! The ETL collector sorting keys by offset
-    etl::Collector offset_collector_{};
+    std::unique_ptr<etl::Collector> offset_collector_;
 
     //! The ETL collector sorting keys by bucket
-    etl::Collector bucket_collector_{};
+    std::unique_ptr<etl::Collector> bucket_collector_;
+
+    //! The memory-mapped index file (only when opened for lookups)
+    std::unique_ptr<MemoryMappedFile> encoded_file_;
+
+    //! Mask applied to the 8 bytes read for an index record (only when opened for lookups)
+    uint64_t record_mask_{0};
 
     //! Accumulator for size of every bucket
     std::vector<int64_t> bucket_size_accumulator_;
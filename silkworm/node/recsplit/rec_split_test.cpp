@@ -21,6 +21,7 @@
 
 #include <catch2/catch.hpp>
 
+#include <silkworm/core/common/cast.hpp>
 #include <silkworm/node/test/files.hpp>
 #include <silkworm/node/test/log.hpp>
 #include <silkworm/node/test/xoroshiro128pp.hpp>
@@ -54,6 +55,49 @@ TEST_CASE("RecSplit8", "[silkworm][recsplit]") {
     }
 }
 
+TEST_CASE("RecSplit8: index lookup", "[silkworm][recsplit]") {
+    test::SetLogVerbosityGuard guard{log::Level::kNone};
+    test::TemporaryFile index_file;
+
+    for (const bool double_enum_index : {true, false}) {
+        for (const std::size_t key_count : std::vector<std::size_t>{1, 100, 1'000}) {
+            SECTION("double_enum_index=" + std::to_string(double_enum_index) +
+                    " keys=" + std::to_string(key_count)) {  // NOLINT
+                RecSplitSettings settings{
+                    .keys_count = key_count,
+                    .bucket_size = 100,
+                    .index_path = index_file.path(),
+                    .base_data_id = 42,
+                    .double_enum_index = double_enum_index};
+                RecSplit8 rs{settings, /*.salt=*/kTestSalt};
+                for (std::size_t i{0}; i < key_count; ++i) {
+                    rs.add_key("key" + std::to_string(i), 1'000 + i * 100);
+                }
+                REQUIRE_FALSE(rs.build() /*collision_detected*/);
+
+                RecSplit8 index{index_file.path()};
+                CHECK(index.size() == key_count);
+                CHECK(index.base_data_id() == 42);
+                CHECK(index.double_enum_index() == double_enum_index);
+                for (std::size_t i{0}; i < key_count; ++i) {
+                    const std::string key{"key" + std::to_string(i)};
+                    const uint64_t value{index.lookup(string_view_to_byte_view(key))};
+                    if (double_enum_index) {
+                        // Key ordinal first, then its data offset
+                        CHECK(value == i);
+                        CHECK(index.ordinal_lookup(value) == 1'000 + i * 100);
+                    } else {
+                        CHECK(value == 1'000 + i * 100);
+                    }
+                }
+                if (!double_enum_index) {
+                    CHECK_THROWS_AS(index.ordinal_lookup(0), std::logic_error);
+                }
+            }
+        }
+    }
+}
+
 template <typename RS>
 static void check_bijection(RS& rec_split, const std::vector<hash128_t>& keys) {
     // RecSplit implements a MPHF K={k1...kN} -> V={0..N-1} so we must check all codomain is exhausted
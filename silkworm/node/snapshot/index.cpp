@@ -16,7 +16,9 @@
 
 #include "index.hpp"
 
+#include <algorithm>
 #include <stdexcept>
+#include <vector>
 
 #include <magic_enum.hpp>
 
@@ -24,6 +26,7 @@
 #include <silkworm/core/common/util.hpp>
 #include <silkworm/core/types/hash.hpp>
 #include <silkworm/node/common/log.hpp>
+#include <silkworm/node/concurrency/thread_pool.hpp>
 #include <silkworm/node/test/snapshots.hpp>
 
 namespace silkworm {
@@ -31,6 +34,28 @@ namespace silkworm {
 using RecSplitSettings = succinct::RecSplitSettings;
 using RecSplit8 = succinct::RecSplit8;
 
+namespace {
+
+    //! Keys of one range of words computed by a worker, added to RecSplit following the order of words
+    struct KeyBatch {
+        Bytes keys;
+        std::vector<std::size_t> key_lengths;
+        std::vector<uint64_t> offsets;
+    };
+
+    //! Keys of one transaction computed by a worker
+    struct TxKey {
+        Hash tx_hash;
+        uint64_t offset{0};
+        BlockNum block_number{0};
+    };
+
+}  // namespace
+
+uint32_t Index::worker_count(std::size_t range_count) const {
+    return static_cast<uint32_t>(std::min<std::size_t>(max_workers_, range_count));
+}
+
 void Index::build() {
     SILK_TRACE << "Index::build path: " << segment_path_.path().string() << " start";
 
@@ -46,26 +71,45 @@ void Index::build() {
     RecSplit8 rec_split{rec_split_settings};
 
     SILK_INFO << "Build index for: " << segment_path_.path().string() << " start";
+
+    // Checkpoints do not change across iterations, so skip all words just once
+    const auto checkpoints = decoder.make_checkpoints(Decompressor::kDefaultCheckpointStep);
+    thread_pool workers{worker_count(checkpoints.size())};
+
+    auto decode_keys = [&](uint64_t first_word, uint64_t word_count, Decompressor::Iterator it) {
+        KeyBatch batch;
+        batch.key_lengths.reserve(word_count);
+        batch.offsets.reserve(word_count);
+        Bytes word{};
+        word.reserve(kPageSize);
+        uint64_t offset{it.offset()};
+        for (uint64_t i{first_word}; i < first_word + word_count; ++i) {
+            const uint64_t next_position = it.next(word);
+            const std::size_t keys_size = batch.keys.size();
+            make_key(i, word, batch.keys);
+            batch.key_lengths.push_back(batch.keys.size() - keys_size);
+            batch.offsets.push_back(offset);
+            offset = next_position;
+            word.clear();
+        }
+        return batch;
+    };
+    auto add_keys = [&](KeyBatch&& batch) {
+        std::size_t key_offset{0};
+        for (std::size_t k{0}; k < batch.offsets.size(); ++k) {
+            rec_split.add_key(batch.keys.data() + key_offset, batch.key_lengths[k], batch.offsets[k]);
+            key_offset += batch.key_lengths[k];
+        }
+        return true;
+    };
+
     uint64_t iterations{0};
     bool collision_detected;
     do {
         iterations++;
         SILK_INFO << "Process snapshot items to prepare index build for: " << segment_path_.path().string();
-        const bool read_ok = decoder.read_ahead([&](Decompressor::Iterator it) {
-            Bytes word{};
-            word.reserve(kPageSize);
-            uint64_t i{0}, offset{0};
-            while (it.has_next()) {
-                uint64_t next_position = it.next(word);
-                if (bool ok = walk(rec_split, i, offset, word); !ok) {
-                    return false;
-                }
-                ++i;
-                offset = next_position;
-                word.clear();
-            }
-            return true;
-        });
+        const bool read_ok = decoder.read_ahead_parallel(checkpoints, Decompressor::kDefaultCheckpointStep, workers,
+                                                         decode_keys, add_keys);
         if (!read_ok) throw std::runtime_error{"cannot build index for: " + segment_path_.path().string()};
 
         SILK_INFO << "Build RecSplit index for: " << segment_path_.path().string() << " [" << iterations << "]";
@@ -78,18 +122,18 @@ void Index::build() {
     SILK_TRACE << "Index::build path: " << segment_path_.path().string() << " end";
 }
 
-bool HeaderIndex::walk(RecSplit8& rec_split, uint64_t /*i*/, uint64_t offset, ByteView word) {
+void Index::make_key(uint64_t /*i*/, ByteView /*word*/, Bytes& /*keys*/) const {
+    throw std::logic_error{"Index::make_key not implemented for: " + segment_path_.path().string()};
+}
+
+void HeaderIndex::make_key(uint64_t /*i*/, ByteView word, Bytes& keys) const {
     const ByteView rlp_encoded_header{word.data() + 1, word.size() - 1};
     const ethash::hash256 hash = keccak256(rlp_encoded_header);
-    rec_split.add_key(hash.bytes, kHashLength, offset);
-    return true;
+    keys.append(hash.bytes, kHashLength);
 }
 
-bool BodyIndex::walk(RecSplit8& rec_split, uint64_t i, uint64_t offset, ByteView /*word*/) {
-    const auto size = test::encode_varint<uint64_t>(i, uint64_buffer_);
-    rec_split.add_key(uint64_buffer_.data(), size, offset);
-    uint64_buffer_.clear();
-    return true;
+void BodyIndex::make_key(uint64_t i, ByteView /*word*/, Bytes& keys) const {
+    test::encode_varint<uint64_t>(i, keys);
 }
 
 void TransactionIndex::build() {
@@ -140,107 +184,84 @@ void TransactionIndex::build() {
         .etl_optimal_size = etl::kOptimalBufferSize / 2};
     RecSplit8 tx_hash_to_block_rs{tx_hash_to_block_rs_settings, 1};
 
-    Decompressor bodies_decoder{bodies_segment.path()};
-    bodies_decoder.open();
+    // Transaction id past the last one of each block, so that any worker can find the block of any transaction
+    std::vector<uint64_t> block_txn_ends;
+    block_txn_ends.reserve(segment_path_.block_to() - segment_path_.block_from());
+    bodies_snapshot.for_each_body([&](BlockNum /*number*/, const db::detail::BlockBodyForStorage* body) {
+        block_txn_ends.push_back(body->base_txn_id + body->txn_count);
+        return true;
+    });
+
+    // Checkpoints do not change across iterations, so skip all words just once
+    const auto checkpoints = txs_decoder.make_checkpoints(Decompressor::kDefaultCheckpointStep);
+    thread_pool workers{worker_count(checkpoints.size())};
+
+    auto decode_keys = [&, first_tx_id = first_tx_id](uint64_t first_word, uint64_t word_count, Decompressor::Iterator it) {
+        std::vector<TxKey> tx_keys;
+        tx_keys.reserve(word_count);
+        Bytes tx_buffer{};
+        tx_buffer.reserve(kPageSize);
+        uint64_t offset{it.offset()};
+        for (uint64_t i{first_word}; i < first_word + word_count; ++i) {
+            const uint64_t next_position = it.next(tx_buffer);
+            const uint64_t tx_id{first_tx_id + i};
+            const auto block_it = std::upper_bound(block_txn_ends.cbegin(), block_txn_ends.cend(), tx_id);
+            if (block_it == block_txn_ends.cend()) {
+                throw std::runtime_error{"cannot find block for tx: " + std::to_string(tx_id) +
+                                         " in: " + segment_path_.path().string()};
+            }
+
+            TxKey& tx_key = tx_keys.emplace_back();
+            tx_key.offset = offset;
+            tx_key.block_number = first_block_num + static_cast<BlockNum>(block_it - block_txn_ends.cbegin());
+
+            const bool is_system_tx{tx_buffer.empty()};
+            if (is_system_tx) {
+                // system-txs: hash:pad32(txnID)
+                endian::store_big_u64(tx_key.tx_hash.bytes, tx_id);
+            } else {
+                // Skip first byte plus address length for transaction decoding
+                constexpr int kTxFirstByteAndAddressLength{1 + kAddressLength};
+                const ByteView tx_envelope{ByteView{tx_buffer}.substr(kTxFirstByteAndAddressLength)};
+                ByteView tx_envelope_view{tx_envelope};
+
+                rlp::Header tx_header;
+                Transaction::Type tx_type;
+                const auto decode_result = rlp::decode_transaction_header_and_type(tx_envelope_view, tx_header, tx_type);
+                if (!decode_result) {
+                    throw std::runtime_error{"cannot decode tx envelope: " + to_hex(tx_envelope) + " i: " +
+                                             std::to_string(i) + " error: " + std::string{magic_enum::enum_name(decode_result.error())}};
+                }
+                const std::size_t tx_payload_offset = tx_type == Transaction::Type::kLegacy ? 0 : (tx_envelope.length() - tx_header.payload_length);
+
+                const ByteView tx_payload{tx_envelope.substr(tx_payload_offset)};
+                const auto h256{keccak256(tx_payload)};
+                std::copy(std::begin(h256.bytes), std::begin(h256.bytes) + kHashLength, std::begin(tx_key.tx_hash.bytes));
+                SILK_DEBUG << "type: " << int(tx_type) << " i: " << i << " payload: " << to_hex(tx_payload)
+                           << " h256: " << to_hex(h256.bytes, kHashLength);
+            }
 
-    using DoubleReadAheadFunc = std::function<bool(Decompressor::Iterator, Decompressor::Iterator)>;
-    auto double_read_ahead = [&txs_decoder, &bodies_decoder](const DoubleReadAheadFunc& fn) -> bool {
-        return txs_decoder.read_ahead([fn, &bodies_decoder](Decompressor::Iterator tx_it) -> bool {
-            return bodies_decoder.read_ahead([fn, &tx_it](Decompressor::Iterator body_it) {
-                return fn(tx_it, body_it);
-            });
-        });
+            offset = next_position;
+            tx_buffer.clear();
+        }
+        return tx_keys;
+    };
+    auto add_keys = [&](std::vector<TxKey>&& tx_keys) {
+        for (const auto& tx_key : tx_keys) {
+            tx_hash_rs.add_key(tx_key.tx_hash.bytes, kHashLength, tx_key.offset);
+            tx_hash_to_block_rs.add_key(tx_key.tx_hash.bytes, kHashLength, tx_key.block_number);
+        }
+        return true;
     };
 
     SILK_INFO << "Build index for: " << segment_path_.path().string() << " start";
     uint64_t iterations{0};
-    Hash tx_hash;
     bool collision_detected;
     do {
         iterations++;
         SILK_INFO << "Process snapshot items to prepare index build for: " << segment_path_.path().string();
-        const bool read_ok = double_read_ahead(
-            [&, first_tx_id = first_tx_id, expected_tx_count = expected_tx_count](auto tx_it, auto body_it) -> bool {
-                BlockNum block_number = first_block_num;
-
-                db::detail::BlockBodyForStorage body;
-
-                Bytes tx_buffer{}, body_buffer{};
-                tx_buffer.reserve(kPageSize);
-                body_buffer.reserve(kPageSize);
-
-                body_it.next(body_buffer);
-                ByteView body_rlp{body_buffer.data(), body_buffer.length()};
-                SILK_DEBUG << "double_read_ahead block_number: " << block_number << " body_rlp: " << to_hex(body_rlp);
-                auto decode_result = db::detail::decode_stored_block_body(body_rlp, body);
-                if (!decode_result) {
-                    SILK_ERROR << "cannot decode block " << block_number << " body: " << to_hex(body_rlp) << " error: " << magic_enum::enum_name(decode_result.error());
-                    return false;
-                }
-                body_buffer.clear();
-
-                uint64_t i{0}, offset{0};
-                while (tx_it.has_next()) {
-                    uint64_t next_position = tx_it.next(tx_buffer);
-                    while (body.base_txn_id + body.txn_count <= first_tx_id + i) {
-                        if (!body_it.has_next()) return false;
-                        body_it.next(body_buffer);
-                        body_rlp = ByteView{body_buffer.data(), body_buffer.length()};
-                        decode_result = db::detail::decode_stored_block_body(body_rlp, body);
-                        if (!decode_result) {
-                            SILK_ERROR << "cannot decode block " << block_number << " body: " << to_hex(body_rlp) << " i: " << i << " error: " << magic_enum::enum_name(decode_result.error());
-                            return false;
-                        }
-                        body_buffer.clear();
-                        ++block_number;
-                    }
-                    const bool is_system_tx{tx_buffer.empty()};
-                    if (is_system_tx) {
-                        // system-txs: hash:pad32(txnID)
-                        endian::store_big_u64(tx_hash.bytes, first_tx_id + i);
-
-                        tx_hash_rs.add_key(tx_hash.bytes, kHashLength, offset);
-                        tx_hash_to_block_rs.add_key(tx_hash.bytes, kHashLength, block_number);
-                    } else {
-                        // Skip first byte plus address length for transaction decoding
-                        constexpr int kTxFirstByteAndAddressLength{1 + kAddressLength};
-                        const Bytes tx_envelope{tx_buffer.substr(kTxFirstByteAndAddressLength)};
-                        ByteView tx_envelope_view{tx_envelope};
-
-                        rlp::Header tx_header;
-                        Transaction::Type tx_type;
-                        decode_result = rlp::decode_transaction_header_and_type(tx_envelope_view, tx_header, tx_type);
-                        if (!decode_result) {
-                            SILK_ERROR << "cannot decode tx envelope: " << to_hex(tx_envelope) << " i: " << i << " error: " << magic_enum::enum_name(decode_result.error());
-                            return false;
-                        }
-                        const std::size_t tx_payload_offset = tx_type == Transaction::Type::kLegacy ? 0 : (tx_envelope.length() - tx_header.payload_length);
-
-                        if (i % 100'000 == 0) {
-                            SILK_DEBUG << "header.list: " << tx_header.list << " header.payload_length: " << tx_header.payload_length << " i: " << i;
-                        }
-
-                        const Bytes tx_payload{tx_buffer.substr(kTxFirstByteAndAddressLength + tx_payload_offset)};
-                        const auto h256{keccak256(tx_payload)};
-                        std::copy(std::begin(h256.bytes), std::begin(h256.bytes) + kHashLength, std::begin(tx_hash.bytes));
-                        SILK_DEBUG << "type: " << int(tx_type) << " i: " << i << " payload: " << to_hex(tx_payload)
-                                   << " h256: " << to_hex(h256.bytes, kHashLength);
-                        tx_hash_rs.add_key(tx_hash.bytes, kHashLength, offset);
-                        tx_hash_to_block_rs.add_key(tx_hash.bytes, kHashLength, block_number);
-                    }
-
-                    ++i;
-                    offset = next_position;
-                    tx_buffer.clear();
-                }
-
-                if (i != expected_tx_count) {
-                    throw std::runtime_error{"tx count mismatch: expected=" + std::to_string(expected_tx_count) +
-                                             " got=" + std::to_string(i)};
-                }
-
-                return true;
-            });
+        const bool read_ok = txs_decoder.read_ahead_parallel(checkpoints, Decompressor::kDefaultCheckpointStep, workers,
+                                                             decode_keys, add_keys);
         if (!read_ok) throw std::runtime_error{"cannot build index for: " + segment_path_.path().string()};
 
         SILK_INFO << "Build tx_hash RecSplit index for: " << segment_path_.path().string() << " [" << iterations << "]";
@@ -261,8 +282,4 @@ void TransactionIndex::build() {
     SILK_INFO << "TransactionIndex::build path: " << segment_path_.path().string() << " end";
 }
 
-bool TransactionIndex::walk(RecSplit8& /*rec_split*/, uint64_t /*i*/, uint64_t /*offset*/, ByteView /*word*/) {
-    return true;
-}
-
 }  // namespace silkworm
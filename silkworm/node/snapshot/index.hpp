@@ -17,6 +17,7 @@
 #pragma once
 
 #include <memory>
+#include <thread>
 #include <utility>
 
 #include <silkworm/node/huffman/decompressor.hpp>
@@ -35,12 +36,22 @@ class Index {
 
     [[nodiscard]] SnapshotPath path() const { return segment_path_.index_file(); }
 
+    //! Set the max number of threads decoding the segment words in build, defaults to all hardware threads
+    void set_max_workers(uint32_t max_workers) { max_workers_ = max_workers; }
+
     virtual void build();
 
   protected:
-    virtual bool walk(succinct::RecSplit8& rec_split, uint64_t i, uint64_t offset, ByteView word) = 0;
+    //! Append the key of the i-th word in the segment to the specified keys
+    //! @details Words are decoded on many threads, so this is called concurrently and must be thread-safe.
+    //! Needed only by the default build: indexes overriding build may leave it unimplemented, and then it throws
+    virtual void make_key(uint64_t i, ByteView word, Bytes& keys) const;
+
+    //! The number of threads decoding words, never more than the ranges to decode nor than the max workers
+    [[nodiscard]] uint32_t worker_count(std::size_t range_count) const;
 
     SnapshotPath segment_path_;
+    uint32_t max_workers_{std::thread::hardware_concurrency()};
 };
 
 class HeaderIndex : public Index {
@@ -48,18 +59,15 @@ class HeaderIndex : public Index {
     explicit HeaderIndex(SnapshotPath segment_path) : Index(std::move(segment_path)) {}
 
   protected:
-    bool walk(succinct::RecSplit8& rec_split, uint64_t i, uint64_t offset, ByteView word) override;
+    void make_key(uint64_t i, ByteView word, Bytes& keys) const override;
 };
 
 class BodyIndex : public Index {
   public:
-    explicit BodyIndex(SnapshotPath path) : Index(std::move(path)), uint64_buffer_(8, '\0') {}
+    explicit BodyIndex(SnapshotPath path) : Index(std::move(path)) {}
 
   protected:
-    bool walk(succinct::RecSplit8& rec_split, uint64_t i, uint64_t offset, ByteView word) override;
-
-  private:
-    Bytes uint64_buffer_;
+    void make_key(uint64_t i, ByteView word, Bytes& keys) const override;
 };
 
 class TransactionIndex : public Index {
@@ -67,9 +75,6 @@ class TransactionIndex : public Index {
     explicit TransactionIndex(SnapshotPath segment_path) : Index(std::move(segment_path)) {}
 
     void build() override;
-
-  protected:
-    bool walk(succinct::RecSplit8& rec_split, uint64_t i, uint64_t offset, ByteView word) override;
 };
 
 }  // namespace silkworm
@@ -17,8 +17,11 @@
 #include "repository.hpp"
 
 #include <algorithm>
+#include <iterator>
 #include <memory>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include <silkworm/core/common/assert.hpp>
 #include <silkworm/core/types/block.hpp>
@@ -28,6 +31,9 @@
 
 namespace silkworm {
 
+//! The max number of indexes built at the same time, each one decoding its segment on its share of hardware threads
+constexpr std::size_t kMaxConcurrentIndexBuilds{4};
+
 namespace fs = std::filesystem;
 
 SnapshotRepository::SnapshotRepository(SnapshotSettings settings) : settings_(std::move(settings)) {}
@@ -44,7 +50,7 @@ void SnapshotRepository::verify() {
 }
 
 void SnapshotRepository::build_missing_indexes() {
-    thread_pool workers;
+    std::vector<std::shared_ptr<Index>> missing_indexes;
 
     SnapshotPathList segment_files = get_segment_files();
     for (const auto& seg_file : segment_files) {
@@ -70,14 +76,25 @@ void SnapshotRepository::build_missing_indexes() {
                 }
             }
             if (index) {
-                workers.submit([&index]() {
-                    log::Info() << "[Snapshots] Build index: " << index->path().path().string() << " start";
-                    index->build();
-                    log::Info() << "[Snapshots] Build index: " << index->path().path().string() << " end";
-                });
+                missing_indexes.push_back(std::move(index));
             }
         }
     }
+    if (missing_indexes.empty()) return;
+
+    // Each build decodes its segment on many threads, so run a few builds at once sharing the hardware threads
+    const uint32_t hardware_threads{std::max(std::thread::hardware_concurrency(), 1u)};
+    const auto concurrent_builds{static_cast<uint32_t>(
+        std::min<std::size_t>({kMaxConcurrentIndexBuilds, missing_indexes.size(), hardware_threads}))};
+    thread_pool workers{concurrent_builds};
+    for (const auto& index : missing_indexes) {
+        index->set_max_workers(hardware_threads / concurrent_builds);
+        workers.submit([index]() {
+            log::Info() << "[Snapshots] Build index: " << index->path().path().string() << " start";
+            index->build();
+            log::Info() << "[Snapshots] Build index: " << index->path().path().string() << " end";
+        });
+    }
 
     workers.wait_for_tasks();
 }
@@ -108,6 +125,15 @@ bool SnapshotRepository::for_each_header(const HeaderSnapshot::Walker& fn) {
     return true;
 }
 
+bool SnapshotRepository::for_each_header(const HeaderSnapshot::HashedWalker& fn, thread_pool& workers) {
+    for (const auto& [_, header_snapshot] : header_segments_) {
+        SILK_DEBUG << "for_each_header header_snapshot: " << header_snapshot->path().string();
+        const auto keep_going = header_snapshot->for_each_header(fn, workers);
+        if (!keep_going) return false;
+    }
+    return true;
+}
+
 bool SnapshotRepository::for_each_body(const BodySnapshot::Walker& fn) {
     for (const auto& [_, body_snapshot] : body_segments_) {
         SILK_DEBUG << "for_each_body body_snapshot: " << body_snapshot->path().string();
@@ -131,6 +157,26 @@ SnapshotRepository::ViewResult SnapshotRepository::view_tx_segment(BlockNum numb
     return view(tx_segments_, number, walker);
 }
 
+const HeaderSnapshot* SnapshotRepository::find_header_segment(BlockNum number) const {
+    return find_segment(header_segments_, number);
+}
+
+const BodySnapshot* SnapshotRepository::find_body_segment(BlockNum number) const {
+    return find_segment(body_segments_, number);
+}
+
+const TransactionSnapshot* SnapshotRepository::find_tx_segment(BlockNum number) const {
+    return find_segment(tx_segments_, number);
+}
+
+std::optional<BlockHeader> SnapshotRepository::find_header_by_hash(const evmc::bytes32& block_hash) const {
+    for (auto it = header_segments_.rbegin(); it != header_segments_.rend(); ++it) {
+        auto header{it->second->header_by_hash(block_hash)};
+        if (header) return header;
+    }
+    return std::nullopt;
+}
+
 void SnapshotRepository::reopen_list(const SnapshotPathList& segment_files, bool optimistic) {
     close_segments_not_in_list(segment_files);
 
@@ -186,27 +232,44 @@ void SnapshotRepository::close_segments_not_in_list(const SnapshotPathList& /*se
 }
 
 template <ConcreteSnapshot T>
-SnapshotRepository::ViewResult SnapshotRepository::view(const SnapshotsByPath<T>& segments, BlockNum number,
+SnapshotRepository::ViewResult SnapshotRepository::view(const SnapshotsByBlock<T>& segments, BlockNum number,
                                                         const SnapshotWalker<T>& walker) {
+    const T* snapshot = find_segment(segments, number);
+    if (snapshot == nullptr) return kSnapshotNotFound;
+    const bool walk_done = walker(snapshot);
+    return walk_done ? kWalkSuccess : kWalkFailed;
+}
+
+template <ConcreteSnapshot T>
+const T* SnapshotRepository::find_segment(const SnapshotsByBlock<T>& segments, BlockNum number) {
+    // The only candidate is the last segment starting at or before number
+    auto it = segments.upper_bound(number);
+    if (it == segments.begin()) return nullptr;
+    const auto& snapshot = std::prev(it)->second;
+    return number < snapshot->block_to() ? snapshot.get() : nullptr;
+}
+
+template <ConcreteSnapshot T>
+BlockNum SnapshotRepository::max_idx_available(const SnapshotsByBlock<T>& segments) {
+    // Segments are ordered by block range, so indexes are available up to the first segment missing them
+    BlockNum max_block{0};
     for (const auto& [_, snapshot] : segments) {
-        if (snapshot->block_from() <= number && number < snapshot->block_to()) {
-            const bool walk_done = walker(snapshot.get());
-            return walk_done ? kWalkSuccess : kWalkFailed;
-        }
+        if (snapshot->block_from() != max_block || !snapshot->has_index()) break;
+        max_block = snapshot->block_to();
     }
-    return kSnapshotNotFound;
+    return max_block;
 }
 
 template <ConcreteSnapshot T>
-bool SnapshotRepository::reopen(SnapshotsByPath<T>& segments, const SnapshotPath& seg_file) {
-    if (segments.find(seg_file.path()) == segments.end()) {
+bool SnapshotRepository::reopen(SnapshotsByBlock<T>& segments, const SnapshotPath& seg_file) {
+    if (segments.find(seg_file.block_from()) == segments.end()) {
         auto segment = std::make_unique<T>(seg_file.path(), seg_file.block_from(), seg_file.block_to());
         segment->reopen_segment();
         if (segment->empty()) return false;
-        segments[seg_file.path()] = std::move(segment);
+        segments[seg_file.block_from()] = std::move(segment);
     }
-    SILKWORM_ASSERT(segments.find(seg_file.path()) != segments.end());
-    const auto& segment = segments[seg_file.path()];
+    SILKWORM_ASSERT(segments.find(seg_file.block_from()) != segments.end());
+    const auto& segment = segments[seg_file.block_from()];
     segment->reopen_index();
     return true;
 }
@@ -236,8 +299,9 @@ SnapshotPathList SnapshotRepository::get_files(const std::string& ext) const {
 }
 
 uint64_t SnapshotRepository::max_idx_available() const {
-    // TODO(canepat): implement
-    return 0;
+    return std::min({max_idx_available(header_segments_),
+                     max_idx_available(body_segments_),
+                     max_idx_available(tx_segments_)});
 }
 
 }  // namespace silkworm
@@ -18,6 +18,8 @@
 
 #include <filesystem>
 #include <functional>
+#include <map>
+#include <memory>
 #include <optional>
 #include <string>
 #include <type_traits>
@@ -34,8 +36,9 @@ namespace silkworm {
 template <typename T>
 concept ConcreteSnapshot = std::is_base_of<Snapshot, T>::value;
 
+//! Snapshots of one type keyed by their first block, hence ordered by block range
 template <ConcreteSnapshot T>
-using SnapshotsByPath = std::map<std::filesystem::path, std::unique_ptr<T>>;
+using SnapshotsByBlock = std::map<BlockNum, std::unique_ptr<T>>;
 
 template <ConcreteSnapshot T>
 using SnapshotWalker = std::function<bool(const T* snapshot)>;
@@ -53,6 +56,7 @@ class SnapshotRepository {
   public:
     explicit SnapshotRepository(SnapshotSettings settings = {});
 
+    //! \brief Blocks having number lower than this are available with all their segments and indexes
     [[nodiscard]] BlockNum max_block_available() const { return std::min(segment_max_block_, idx_max_block_); }
 
     void verify();
@@ -62,6 +66,7 @@ class SnapshotRepository {
     [[nodiscard]] std::filesystem::path path() const { return settings_.repository_dir; }
 
     bool for_each_header(const HeaderSnapshot::Walker& fn);
+    bool for_each_header(const HeaderSnapshot::HashedWalker& fn, thread_pool& workers);
     bool for_each_body(const BodySnapshot::Walker& fn);
 
     [[nodiscard]] std::size_t header_snapshots_count() const { return header_segments_.size(); }
@@ -78,6 +83,14 @@ class SnapshotRepository {
     ViewResult view_body_segment(BlockNum number, const BodySnapshotWalker& walker);
     ViewResult view_tx_segment(BlockNum number, const TransactionSnapshotWalker& walker);
 
+    //! \brief Returns the segment of given type containing the specified block number, nullptr if missing
+    [[nodiscard]] const HeaderSnapshot* find_header_segment(BlockNum number) const;
+    [[nodiscard]] const BodySnapshot* find_body_segment(BlockNum number) const;
+    [[nodiscard]] const TransactionSnapshot* find_tx_segment(BlockNum number) const;
+
+    //! \brief Reads the header having the given hash searching all header segments, most recent first
+    [[nodiscard]] std::optional<BlockHeader> find_header_by_hash(const evmc::bytes32& block_hash) const;
+
     [[nodiscard]] BlockNum segment_max_block() const { return segment_max_block_; }
     [[nodiscard]] BlockNum idx_max_block() const { return idx_max_block_; }
 
@@ -91,10 +104,16 @@ class SnapshotRepository {
     void close_segments_not_in_list(const SnapshotPathList& segment_files);
 
     template <ConcreteSnapshot T>
-    static ViewResult view(const SnapshotsByPath<T>& segments, BlockNum number, const SnapshotWalker<T>& walker);
+    static ViewResult view(const SnapshotsByBlock<T>& segments, BlockNum number, const SnapshotWalker<T>& walker);
+
+    template <ConcreteSnapshot T>
+    static const T* find_segment(const SnapshotsByBlock<T>& segments, BlockNum number);
+
+    template <ConcreteSnapshot T>
+    static BlockNum max_idx_available(const SnapshotsByBlock<T>& segments);
 
     template <ConcreteSnapshot T>
-    static bool reopen(SnapshotsByPath<T>& segments, const SnapshotPath& seg_file);
+    static bool reopen(SnapshotsByBlock<T>& segments, const SnapshotPath& seg_file);
 
     [[nodiscard]] SnapshotPathList get_segment_files() const {
         return get_files(kSegmentExtension);
@@ -118,13 +137,13 @@ class SnapshotRepository {
     BlockNum idx_max_block_{0};
 
     //! The snapshots containing the block Headers
-    SnapshotsByPath<HeaderSnapshot> header_segments_;
+    SnapshotsByBlock<HeaderSnapshot> header_segments_;
 
     //! The snapshots containing the block Bodies
-    SnapshotsByPath<BodySnapshot> body_segments_;
+    SnapshotsByBlock<BodySnapshot> body_segments_;
 
     //! The snapshots containing the Transactions
-    SnapshotsByPath<TransactionSnapshot> tx_segments_;
+    SnapshotsByBlock<TransactionSnapshot> tx_segments_;
 };
 
 }  // namespace silkworm
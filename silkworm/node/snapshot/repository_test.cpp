@@ -93,6 +93,60 @@ TEST_CASE("SnapshotRepository::view", "[silkworm][snapshot][snapshot]") {
     }
 }
 
+TEST_CASE("SnapshotRepository::find_segment", "[silkworm][snapshot][snapshot]") {
+    test::SetLogVerbosityGuard guard{log::Level::kNone};
+    const auto tmp_dir = TemporaryDirectory::get_unique_temporary_path();
+    std::filesystem::create_directories(tmp_dir);
+    SnapshotSettings settings{tmp_dir};
+    SnapshotRepository repository{settings};
+
+    SECTION("no snapshots") {
+        repository.reopen_folder();
+
+        CHECK(repository.find_header_segment(14'500'000) == nullptr);
+        CHECK(repository.find_body_segment(11'500'000) == nullptr);
+        CHECK(repository.find_tx_segment(15'000'000) == nullptr);
+        CHECK_FALSE(repository.find_header_by_hash(evmc::bytes32{}));
+    }
+
+    SECTION("non-empty snapshots without indexes") {
+        test::HelloWorldSnapshotFile tmp_snapshot_1{tmp_dir, "v1-014500-015000-headers.seg"};
+        test::HelloWorldSnapshotFile tmp_snapshot_2{tmp_dir, "v1-011500-012000-bodies.seg"};
+        test::HelloWorldSnapshotFile tmp_snapshot_3{tmp_dir, "v1-015000-015500-transactions.seg"};
+        repository.reopen_folder();
+
+        const auto* header_segment{repository.find_header_segment(14'500'000)};
+        REQUIRE(header_segment != nullptr);
+        CHECK(header_segment->path() == tmp_snapshot_1.path());
+        CHECK_FALSE(header_segment->has_index());
+        CHECK(repository.find_header_segment(15'000'000) == nullptr);
+
+        CHECK(repository.find_body_segment(11'999'999) != nullptr);
+        CHECK(repository.find_body_segment(12'000'000) == nullptr);
+
+        CHECK(repository.find_tx_segment(15'000'000) != nullptr);
+        CHECK(repository.find_tx_segment(14'999'999) == nullptr);
+
+        CHECK_FALSE(repository.find_header_by_hash(evmc::bytes32{}));
+        CHECK(repository.max_block_available() == 0);
+    }
+
+    SECTION("adjacent segments") {
+        test::HelloWorldSnapshotFile tmp_snapshot_1{tmp_dir, "v1-014000-014500-headers.seg"};
+        test::HelloWorldSnapshotFile tmp_snapshot_2{tmp_dir, "v1-014500-015000-headers.seg"};
+        test::HelloWorldSnapshotFile tmp_snapshot_3{tmp_dir, "v1-015500-016000-headers.seg"};
+        repository.reopen_folder();
+
+        CHECK(repository.find_header_segment(13'999'999) == nullptr);
+        CHECK(repository.find_header_segment(14'000'000)->path() == tmp_snapshot_1.path());
+        CHECK(repository.find_header_segment(14'499'999)->path() == tmp_snapshot_1.path());
+        CHECK(repository.find_header_segment(14'500'000)->path() == tmp_snapshot_2.path());
+        CHECK(repository.find_header_segment(15'000'000) == nullptr);
+        CHECK(repository.find_header_segment(15'750'000)->path() == tmp_snapshot_3.path());
+        CHECK(repository.find_header_segment(16'000'000) == nullptr);
+    }
+}
+
 TEST_CASE("SnapshotRepository::missing_block_ranges", "[silkworm][snapshot][snapshot]") {
     test::SetLogVerbosityGuard guard{log::Level::kNone};
     const auto tmp_dir = TemporaryDirectory::get_unique_temporary_path();
@@ -16,15 +16,52 @@
 
 #include "snapshot.hpp"
 
+#include <algorithm>
+#include <stdexcept>
+
 #include <magic_enum.hpp>
 
+#include <silkworm/core/common/cast.hpp>
 #include <silkworm/core/common/util.hpp>
+#include <silkworm/node/common/decoding_exception.hpp>
 #include <silkworm/node/common/log.hpp>
 
 namespace silkworm {
 
 namespace fs = std::filesystem;
 
+//! Transaction words start with the first byte of the transaction hash followed by the sender address
+constexpr std::size_t kTxRlpDataOffset{1 + kAddressLength};
+
+//! Decoded headers take much more space than words, so keep ranges short to limit the headers decoded ahead
+constexpr uint64_t kHeaderCheckpointStep{1'024};
+
+//! Compute the hash of a transaction stored in snapshots (EIP-2718 typed transactions wrapped into RLP string)
+static evmc::bytes32 compute_txn_hash(ByteView txn_rlp) {
+    ByteView envelope{txn_rlp};
+    rlp::Header header;
+    Transaction::Type type{Transaction::Type::kLegacy};
+    success_or_throw(rlp::decode_transaction_header_and_type(envelope, header, type));
+    const std::size_t payload_offset = type == Transaction::Type::kLegacy ? 0 : txn_rlp.length() - header.payload_length;
+    const auto h256{keccak256(txn_rlp.substr(payload_offset))};
+    evmc::bytes32 txn_hash;
+    std::copy(std::begin(h256.bytes), std::end(h256.bytes), std::begin(txn_hash.bytes));
+    return txn_hash;
+}
+
+static Transaction decode_txn_word(ByteView word, bool read_senders) {
+    if (word.length() < kTxRlpDataOffset) {
+        throw std::runtime_error{"invalid transaction word length: " + std::to_string(word.length())};
+    }
+    ByteView txn_rlp{word.substr(kTxRlpDataOffset)};
+    Transaction txn;
+    success_or_throw(rlp::decode_transaction(txn_rlp, txn, rlp::Eip2718Wrapping::kBoth));
+    if (read_senders) {
+        txn.from = to_evmc_address(word.substr(1, kAddressLength));
+    }
+    return txn;
+}
+
 Snapshot::Snapshot(std::filesystem::path path, BlockNum block_from, BlockNum block_to)
     : path_(std::move(path)), block_from_(block_from), block_to_(block_to), decoder_{path_} {
     if (block_to < block_from) {
@@ -59,6 +96,41 @@ bool Snapshot::for_each_item(const Snapshot::WordItemFunc& fn) {
     });
 }
 
+std::unique_ptr<succinct::RecSplit8> Snapshot::open_index(SnapshotType type) const {
+    const auto segment_path{SnapshotPath::parse(path_)};
+    if (!segment_path) {
+        throw std::runtime_error{"invalid segment path: " + path_.string()};
+    }
+    const auto index_file{segment_path->index_file_for_type(type)};
+    if (!fs::exists(index_file.path())) {
+        return nullptr;
+    }
+    return std::make_unique<succinct::RecSplit8>(index_file.path());
+}
+
+std::optional<uint64_t> Snapshot::read_word_by_ordinal(const succinct::RecSplit8& index, uint64_t ordinal,
+                                                       Bytes& word) const {
+    if (ordinal >= index.size()) {
+        return std::nullopt;
+    }
+    return decoder_.read_word(index.ordinal_lookup(ordinal), word);
+}
+
+std::vector<uint64_t> Snapshot::make_checkpoints(uint64_t step, const succinct::RecSplit8* index) const {
+    if (index == nullptr || !index->double_enum_index() || index->size() != item_count()) {
+        return decoder_.make_checkpoints(step);
+    }
+    if (step == 0) {
+        throw std::invalid_argument{"invalid zero checkpoint step"};
+    }
+    std::vector<uint64_t> checkpoints;
+    checkpoints.reserve((item_count() + step - 1) / step);
+    for (uint64_t ordinal{0}; ordinal < item_count(); ordinal += step) {
+        checkpoints.push_back(index->ordinal_lookup(ordinal));
+    }
+    return checkpoints;
+}
+
 void Snapshot::close() {
     close_segment();
     close_index();
@@ -84,12 +156,78 @@ bool HeaderSnapshot::for_each_header(const Walker& walker) {
     });
 }
 
+bool HeaderSnapshot::for_each_header(const HashedWalker& walker, thread_pool& workers) {
+    using Headers = std::optional<std::vector<std::pair<BlockHeader, evmc::bytes32>>>;
+    auto decode_headers = [](uint64_t /*first_word*/, uint64_t word_count, Decompressor::Iterator it) -> Headers {
+        std::vector<std::pair<BlockHeader, evmc::bytes32>> headers;
+        headers.reserve(word_count);
+        Bytes word{};
+        word.reserve(kPageSize);
+        for (uint64_t i{0}; i < word_count; ++i) {
+            it.next(word);
+            ByteView encoded_header{word.data() + 1, word.length() - 1};
+            auto& [header, hash] = headers.emplace_back();
+            hash = bit_cast<evmc_bytes32>(keccak256(encoded_header));  // Same as header.hash() without encoding again
+            const auto decode_result = rlp::decode(encoded_header, header);
+            if (!decode_result) {
+                SILK_DEBUG << "for_each_header decode_result error: " << magic_enum::enum_name(decode_result.error());
+                return std::nullopt;
+            }
+            word.clear();
+        }
+        return headers;
+    };
+    auto walk_headers = [&](Headers&& headers) -> bool {
+        if (!headers) return false;
+        return std::all_of(headers->cbegin(), headers->cend(), [&](const auto& hashed_header) {
+            return walker(&hashed_header.first, hashed_header.second);
+        });
+    };
+    const auto checkpoints = make_checkpoints(kHeaderCheckpointStep, idx_header_hash_.get());
+    return decoder_.read_ahead_parallel(checkpoints, kHeaderCheckpointStep, workers, decode_headers, walk_headers);
+}
+
+std::optional<BlockHeader> HeaderSnapshot::header_by_hash(const evmc::bytes32& block_hash) const {
+    if (!idx_header_hash_ || idx_header_hash_->size() == 0) {
+        return std::nullopt;
+    }
+    // The index maps any key to some ordinal, so the header found must be checked against the requested hash
+    const auto ordinal = idx_header_hash_->lookup(ByteView{block_hash.bytes, kHashLength});
+    Bytes word;
+    if (!read_word_by_ordinal(*idx_header_hash_, ordinal, word) || word.empty() || word[0] != block_hash.bytes[0]) {
+        return std::nullopt;
+    }
+    ByteView encoded_header{word.data() + 1, word.length() - 1};
+    BlockHeader header;
+    success_or_throw(rlp::decode(encoded_header, header));
+    if (header.hash() != block_hash) {
+        return std::nullopt;
+    }
+    return header;
+}
+
+std::optional<BlockHeader> HeaderSnapshot::header_by_number(BlockNum block_height) const {
+    if (!idx_header_hash_ || block_height < idx_header_hash_->base_data_id()) {
+        return std::nullopt;
+    }
+    Bytes word;
+    const auto ordinal = block_height - idx_header_hash_->base_data_id();
+    if (!read_word_by_ordinal(*idx_header_hash_, ordinal, word) || word.empty()) {
+        return std::nullopt;
+    }
+    ByteView encoded_header{word.data() + 1, word.length() - 1};
+    BlockHeader header;
+    success_or_throw(rlp::decode(encoded_header, header));
+    return header;
+}
+
 void HeaderSnapshot::reopen_index() {
-    // TODO(canepat): implement
+    close_index();
+    idx_header_hash_ = open_index(SnapshotType::headers);
 }
 
 void HeaderSnapshot::close_index() {
-    // TODO(canepat): implement
+    idx_header_hash_.reset();
 }
 
 bool BodySnapshot::for_each_body(const Walker& walker) {
@@ -124,20 +262,96 @@ std::pair<uint64_t, uint64_t> BodySnapshot::compute_txs_amount() {
     return {first_tx_id, last_tx_id + last_txs_amount - first_tx_id};
 }
 
+std::optional<db::detail::BlockBodyForStorage> BodySnapshot::body_by_number(BlockNum block_height) const {
+    if (!idx_body_number_ || block_height < idx_body_number_->base_data_id()) {
+        return std::nullopt;
+    }
+    Bytes word;
+    const auto ordinal = block_height - idx_body_number_->base_data_id();
+    if (!read_word_by_ordinal(*idx_body_number_, ordinal, word)) {
+        return std::nullopt;
+    }
+    ByteView body_rlp{word};
+    db::detail::BlockBodyForStorage body;
+    success_or_throw(db::detail::decode_stored_block_body(body_rlp, body));
+    return body;
+}
+
 void BodySnapshot::reopen_index() {
-    // TODO(canepat): implement
+    close_index();
+    idx_body_number_ = open_index(SnapshotType::bodies);
 }
 
 void BodySnapshot::close_index() {
-    // TODO(canepat): implement
+    idx_body_number_.reset();
+}
+
+uint64_t TransactionSnapshot::first_txn_id() const {
+    if (!idx_txn_hash_) {
+        throw std::logic_error{"missing index for: " + path_.string()};
+    }
+    return idx_txn_hash_->base_data_id();
+}
+
+std::optional<Transaction> TransactionSnapshot::txn_by_hash(const evmc::bytes32& txn_hash) const {
+    if (!idx_txn_hash_ || idx_txn_hash_->size() == 0) {
+        return std::nullopt;
+    }
+    // The index maps any key to some ordinal, so the transaction found must be checked against the requested hash
+    const auto ordinal = idx_txn_hash_->lookup(ByteView{txn_hash.bytes, kHashLength});
+    Bytes word;
+    if (!read_word_by_ordinal(*idx_txn_hash_, ordinal, word) || word.length() < kTxRlpDataOffset ||
+        word[0] != txn_hash.bytes[0]) {
+        return std::nullopt;
+    }
+    if (compute_txn_hash(ByteView{word}.substr(kTxRlpDataOffset)) != txn_hash) {
+        return std::nullopt;
+    }
+    return decode_txn_word(word, /*read_senders=*/true);
+}
+
+std::optional<BlockNum> TransactionSnapshot::block_num_by_txn_hash(const evmc::bytes32& txn_hash) const {
+    if (!idx_txn_hash_2_block_ || !txn_by_hash(txn_hash)) {
+        return std::nullopt;
+    }
+    return idx_txn_hash_2_block_->lookup(ByteView{txn_hash.bytes, kHashLength});
+}
+
+std::vector<Transaction> TransactionSnapshot::txn_range(uint64_t base_txn_id, uint64_t txn_count,
+                                                        bool read_senders) const {
+    std::vector<Transaction> transactions;
+    if (txn_count == 0) {
+        return transactions;
+    }
+    const auto first_id = first_txn_id();
+    if (base_txn_id < first_id || base_txn_id + txn_count > first_id + idx_txn_hash_->size()) {
+        throw std::out_of_range{"transactions [" + std::to_string(base_txn_id) + ", " +
+                                std::to_string(base_txn_id + txn_count) + ") not in: " + path_.string()};
+    }
+    transactions.reserve(txn_count);
+
+    // Look up the first transaction only, the following ones are stored right after it
+    Bytes word;
+    word.reserve(kPageSize);
+    uint64_t offset{idx_txn_hash_->ordinal_lookup(base_txn_id - first_id)};
+    for (uint64_t i{0}; i < txn_count; ++i) {
+        offset = decoder_.read_word(offset, word);
+        // System transactions are stored as empty words
+        if (word.empty()) continue;
+        transactions.push_back(decode_txn_word(word, read_senders));
+    }
+    return transactions;
 }
 
 void TransactionSnapshot::reopen_index() {
-    // TODO(canepat): implement
+    close_index();
+    idx_txn_hash_ = open_index(SnapshotType::transactions);
+    idx_txn_hash_2_block_ = open_index(SnapshotType::transactions2block);
 }
 
 void TransactionSnapshot::close_index() {
-    // TODO(canepat): implement
+    idx_txn_hash_.reset();
+    idx_txn_hash_2_block_.reset();
 }
 
 }  // namespace silkworm
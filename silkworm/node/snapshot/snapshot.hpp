@@ -20,13 +20,18 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <silkworm/core/common/base.hpp>
 #include <silkworm/core/types/block.hpp>
+#include <silkworm/node/concurrency/thread_pool.hpp>
 #include <silkworm/node/db/util.hpp>
 #include <silkworm/node/huffman/decompressor.hpp>
+#include <silkworm/node/recsplit/rec_split.hpp>
+#include <silkworm/node/snapshot/path.hpp>
 
 namespace silkworm {
 
@@ -66,6 +71,18 @@ class Snapshot {
     void close_segment();
     virtual void close_index() = 0;
 
+    //! \brief Opens the index of given type for this segment, if its file exists
+    [[nodiscard]] std::unique_ptr<succinct::RecSplit8> open_index(SnapshotType type) const;
+
+    //! \brief Decodes the word having the given ordinal position in this segment using the specified index
+    //! \return the offset of the next word, or std::nullopt if the ordinal is out of the index range
+    //! \remarks Point reads are thread-safe, so many threads can read concurrently from the same segment
+    std::optional<uint64_t> read_word_by_ordinal(const succinct::RecSplit8& index, uint64_t ordinal, Bytes& word) const;
+
+    //! \brief Computes the offsets of words 0, step, 2*step... in this segment, splitting it in independent ranges
+    //! \details Offsets are read from the given index if it supports ordinal lookups, otherwise all words are skipped
+    [[nodiscard]] std::vector<uint64_t> make_checkpoints(uint64_t step, const succinct::RecSplit8* index) const;
+
     std::filesystem::path path_;
     BlockNum block_from_{0};
     BlockNum block_to_{0};
@@ -81,6 +98,19 @@ class HeaderSnapshot : public Snapshot {
     using Walker = std::function<bool(const BlockHeader* header)>;
     bool for_each_header(const Walker& walker);
 
+    using HashedWalker = std::function<bool(const BlockHeader* header, const evmc::bytes32& hash)>;
+
+    //! \brief Walks the headers decoding and hashing them on the given workers, still calling walker in block order
+    bool for_each_header(const HashedWalker& walker, thread_pool& workers);
+
+    //! \brief Reads the header having the given hash, if present in this segment
+    [[nodiscard]] std::optional<BlockHeader> header_by_hash(const evmc::bytes32& block_hash) const;
+
+    //! \brief Reads the header having the given number, if present in this segment
+    [[nodiscard]] std::optional<BlockHeader> header_by_number(BlockNum block_height) const;
+
+    [[nodiscard]] bool has_index() const { return idx_header_hash_ != nullptr; }
+
     void reopen_index() override;
 
   protected:
@@ -88,7 +118,7 @@ class HeaderSnapshot : public Snapshot {
 
   private:
     //! Index header_hash -> headers_segment_offset
-    // uint64_t* idx_header_hash_{nullptr}; // TODO(canepat) recsplit.Index
+    std::unique_ptr<succinct::RecSplit8> idx_header_hash_;
 };
 
 class BodySnapshot : public Snapshot {
@@ -102,6 +132,12 @@ class BodySnapshot : public Snapshot {
 
     std::pair<uint64_t, uint64_t> compute_txs_amount();
 
+    //! \brief Reads the stored body having the given block number, if present in this segment
+    //! \remarks Transaction id range may include system transactions, stored as empty words in transaction segment
+    [[nodiscard]] std::optional<db::detail::BlockBodyForStorage> body_by_number(BlockNum block_height) const;
+
+    [[nodiscard]] bool has_index() const { return idx_body_number_ != nullptr; }
+
     void reopen_index() override;
 
   protected:
@@ -109,7 +145,7 @@ class BodySnapshot : public Snapshot {
 
   private:
     //! Index block_num_u64 -> bodies_segment_offset
-    // uint64_t* idx_body_number_{nullptr}; // TODO(canepat) recsplit.Index
+    std::unique_ptr<succinct::RecSplit8> idx_body_number_;
 };
 
 class TransactionSnapshot : public Snapshot {
@@ -118,6 +154,25 @@ class TransactionSnapshot : public Snapshot {
         : Snapshot(std::move(path), block_from, block_to) {}
     ~TransactionSnapshot() override { close(); }
 
+    //! \brief Returns the id of the first transaction in this segment (requires index)
+    [[nodiscard]] uint64_t first_txn_id() const;
+
+    //! \brief Reads the transaction having the given hash, if present in this segment
+    [[nodiscard]] std::optional<Transaction> txn_by_hash(const evmc::bytes32& txn_hash) const;
+
+    //! \brief Reads the number of the block including the transaction having the given hash, if present in this segment
+    [[nodiscard]] std::optional<BlockNum> block_num_by_txn_hash(const evmc::bytes32& txn_hash) const;
+
+    //! \brief Reads the transactions having consecutive ids starting from the given one
+    //! \param [in] base_txn_id : the id of the first transaction to read
+    //! \param [in] txn_count : the number of transactions to read
+    //! \param [in] read_senders : whether to fill in the sender address stored along each transaction
+    //! \throws std::out_of_range if the requested ids are not all in this segment
+    //! \remarks System transactions (i.e. empty words) are skipped
+    [[nodiscard]] std::vector<Transaction> txn_range(uint64_t base_txn_id, uint64_t txn_count, bool read_senders) const;
+
+    [[nodiscard]] bool has_index() const { return idx_txn_hash_ != nullptr && idx_txn_hash_2_block_ != nullptr; }
+
     void reopen_index() override;
 
   protected:
@@ -125,10 +180,10 @@ class TransactionSnapshot : public Snapshot {
 
   private:
     //! Index transaction_hash -> transactions_segment_offset
-    // uint64_t* idx_txn_hash_{nullptr}; // TODO(canepat) recsplit.Index
+    std::unique_ptr<succinct::RecSplit8> idx_txn_hash_;
 
     //! Index transaction_hash -> block_number
-    // uint64_t* idx_txn_hash_2_block_{nullptr}; // TODO(canepat) recsplit.Index
+    std::unique_ptr<succinct::RecSplit8> idx_txn_hash_2_block_;
 };
 
 }  // namespace silkworm
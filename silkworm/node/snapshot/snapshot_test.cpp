@@ -20,10 +20,12 @@
 #include <vector>
 
 #include <catch2/catch.hpp>
+#include <gsl/util>
 
 #include <silkworm/core/common/endian.hpp>
 #include <silkworm/node/common/directories.hpp>
 #include <silkworm/node/common/log.hpp>
+#include <silkworm/node/snapshot/index.hpp>
 #include <silkworm/node/test/log.hpp>
 #include <silkworm/node/test/snapshots.hpp>
 
@@ -90,4 +92,33 @@ TEST_CASE("Snapshot::close", "[silkworm][snapshot][snapshot]") {
     CHECK_NOTHROW(tmp_snapshot.close());
 }
 
+TEST_CASE("BodySnapshot::body_by_number", "[silkworm][snapshot][snapshot]") {
+    test::SetLogVerbosityGuard guard{log::Level::kNone};
+    test::SampleBodySnapshotFile sample_bodies_snapshot{};
+    const auto bodies_snapshot_path{*SnapshotPath::parse(sample_bodies_snapshot.path())};
+    BodyIndex body_index{bodies_snapshot_path};
+    REQUIRE_NOTHROW(body_index.build());
+    auto _ = gsl::finally([&]() { std::filesystem::remove(bodies_snapshot_path.index_file().path()); });
+
+    BodySnapshot body_snapshot{bodies_snapshot_path.path(), 1'500'000, 1'500'014};
+    CHECK_FALSE(body_snapshot.body_by_number(1'500'000));
+    body_snapshot.reopen_segment();
+    body_snapshot.reopen_index();
+    REQUIRE(body_snapshot.has_index());
+
+    const auto first_body{body_snapshot.body_by_number(1'500'000)};
+    REQUIRE(first_body);
+    CHECK(first_body->base_txn_id == 7'341'273);
+    CHECK(first_body->txn_count == 0);
+    CHECK(first_body->ommers.empty());
+
+    const auto last_body{body_snapshot.body_by_number(1'500'013)};
+    REQUIRE(last_body);
+    CHECK(last_body->base_txn_id == 7'341'273);
+    CHECK(last_body->txn_count == 1);
+
+    CHECK_FALSE(body_snapshot.body_by_number(1'499'999));
+    CHECK_FALSE(body_snapshot.body_by_number(1'500'014));
+}
+
 }  // namespace silkworm
@@ -20,6 +20,7 @@
 
 #include <silkworm/core/types/hash.hpp>
 #include <silkworm/node/common/log.hpp>
+#include <silkworm/node/concurrency/thread_pool.hpp>
 #include <silkworm/node/db/stages.hpp>
 #include <silkworm/node/etl/collector.hpp>
 #include <silkworm/node/snapshot/config.hpp>
@@ -113,10 +114,11 @@ bool SnapshotSync::index_snapshots(db::RWTxn& txn, const std::vector<std::string
         // Iterate on block header snapshots and write header-related tables
         etl::Collector hash2bn_collector{};
         intx::uint256 total_difficulty{0};
-        repository_.for_each_header([&](const BlockHeader* header) -> bool {
-            SILK_DEBUG << "Header number: " << header->number << " hash: " << to_hex(header->hash());
+        // Headers are decoded and hashed on many threads, while tables are written following the block order
+        thread_pool header_decoders;
+        auto write_header = [&](const BlockHeader* header, const evmc::bytes32& block_hash) -> bool {
+            SILK_DEBUG << "Header number: " << header->number << " hash: " << to_hex(block_hash);
             const auto block_number = header->number;
-            const auto block_hash = header->hash();
 
             // Write block header into kDifficulty table
             total_difficulty += header->difficulty;
@@ -130,19 +132,20 @@ bool SnapshotSync::index_snapshots(db::RWTxn& txn, const std::vector<std::string
             endian::store_big_u64(encoded_block_number.data(), block_number);
             hash2bn_collector.collect({block_hash.bytes, encoded_block_number});
             return true;
-        });
+        };
+        repository_.for_each_header(write_header, header_decoders);
         db::PooledCursor header_numbers_cursor{txn, db::table::kHeaderNumbers};
         hash2bn_collector.load(header_numbers_cursor);
 
         // Reset sequence for kBlockTransactions table
-        const auto view_result = repository_.view_tx_segment(max_block_available, [&](const auto* tx_sn) {
-            // TODO(canepat) implement recsplit.Index
-            const auto last_tx_id = /*tx_sn->idx_txn_hash()->base_data_id() +*/ tx_sn->item_count();
+        const BlockNum last_block_available = max_block_available > 0 ? max_block_available - 1 : 0;
+        const auto view_result = repository_.view_tx_segment(last_block_available, [&](const auto* tx_sn) {
+            const auto last_tx_id = tx_sn->first_txn_id() + tx_sn->item_count();
             db::reset_map_sequence(txn, db::table::kBlockTransactions.name, last_tx_id + 1);
             return true;
         });
         if (view_result != SnapshotRepository::ViewResult::kWalkSuccess) {
-            log::Error() << "snapshot not found for block: " << max_block_available;
+            log::Error() << "snapshot not found for block: " << last_block_available;
             return false;
         }
 
@@ -15,6 +15,7 @@
 */
 
 #include <catch2/catch.hpp>
+#include <gsl/util>
 
 #include <silkworm/core/chain/genesis.hpp>
 #include <silkworm/core/common/endian.hpp>
@@ -22,6 +23,7 @@
 #include <silkworm/core/execution/address.hpp>
 #include <silkworm/core/execution/execution.hpp>
 #include <silkworm/core/trie/vector_root.hpp>
+#include <silkworm/node/common/test_context.hpp>
 #include <silkworm/node/db/access_layer.hpp>
 #include <silkworm/node/db/buffer.hpp>
 #include <silkworm/node/db/genesis.hpp>
@@ -30,6 +32,7 @@
 #include <silkworm/node/stagedsync/stage_hashstate.hpp>
 #include <silkworm/node/stagedsync/stage_senders.hpp>
 #include <silkworm/node/test/log.hpp>
+#include <silkworm/node/test/snapshots.hpp>
 
 using namespace silkworm;
 using namespace evmc::literals;
@@ -479,3 +482,84 @@ TEST_CASE("Sync Stages") {
         }
     }
 }
+
+TEST_CASE("Execution with ancestors frozen in snapshots") {
+    test::SetLogVerbosityGuard log_guard{log::Level::kNone};
+    test::Context context;
+    auto& txn{context.rw_txn()};
+
+    // ---------------------------------------
+    // Freeze blocks [0, 1000) in snapshots only: each block has just the two system transactions
+    // ---------------------------------------
+    constexpr BlockNum kFrozenBlocks{1'000};
+    std::vector<Bytes> header_words, body_words, tx_words;
+    std::vector<evmc::bytes32> block_hashes;
+    for (BlockNum block_number{0}; block_number < kFrozenBlocks; ++block_number) {
+        BlockHeader header;
+        header.number = block_number;
+        header.gas_limit = 100'000;
+        if (block_number > 0) {
+            header.parent_hash = block_hashes.back();
+        }
+        block_hashes.push_back(header.hash());
+        Bytes header_word{block_hashes.back().bytes[0]};
+        rlp::encode(header_word, header);
+        header_words.push_back(std::move(header_word));
+
+        db::detail::BlockBodyForStorage body;
+        body.base_txn_id = 2 * block_number;
+        body.txn_count = 2;
+        body_words.push_back(body.encode());
+        tx_words.insert(tx_words.end(), 2, Bytes{});
+    }
+
+    TemporaryDirectory snapshot_dir;
+    test::UncompressedSnapshotFile header_snapshot{snapshot_dir.path(), "v1-000000-000001-headers.seg", header_words};
+    test::UncompressedSnapshotFile body_snapshot{snapshot_dir.path(), "v1-000000-000001-bodies.seg", body_words};
+    test::UncompressedSnapshotFile tx_snapshot{snapshot_dir.path(), "v1-000000-000001-transactions.seg", tx_words};
+
+    SnapshotRepository repository{SnapshotSettings{snapshot_dir.path()}};
+    repository.build_missing_indexes();
+    repository.reopen_folder();
+    REQUIRE(repository.max_block_available() == kFrozenBlocks);
+
+    db::DataModel::set_snapshot_repository(&repository);
+    auto _ = gsl::finally([]() { db::DataModel::set_snapshot_repository(nullptr); });
+
+    // Frozen headers are not in db
+    REQUIRE_FALSE(db::read_header(txn, kFrozenBlocks - 1, block_hashes.back()));
+
+    // ---------------------------------------
+    // Execute the first block after the frozen ones
+    // ---------------------------------------
+    Block block{};
+    block.header.number = kFrozenBlocks;
+    block.header.parent_hash = block_hashes.back();
+    block.header.gas_limit = 100'000;
+    block.header.gas_used = 41'442;
+
+    // This contract stores the hash of block 990 into its 0th storage
+    Bytes deployment_code{*from_hex("6103de4060005500")};
+
+    block.transactions.resize(1);
+    block.transactions[0].data = deployment_code;
+    block.transactions[0].gas_limit = block.header.gas_limit;
+    block.transactions[0].type = Transaction::Type::kLegacy;
+
+    auto sender{0xb685342b8c54347aad148e1f22eff3eb3eb29391_address};
+    block.transactions[0].r = 1;  // dummy
+    block.transactions[0].s = 1;  // dummy
+    block.transactions[0].from = sender;
+
+    db::Buffer buffer{txn, 0};
+    Account sender_account{};
+    sender_account.balance = kEther;
+    buffer.update_account(sender, std::nullopt, sender_account);
+
+    auto expected_validation_result{magic_enum::enum_name(ValidationResult::kOk)};
+    auto actual_validation_result{magic_enum::enum_name(execute_block(block, buffer, test::kFrontierConfig))};
+    REQUIRE(expected_validation_result == actual_validation_result);
+
+    const auto contract_address{create_address(sender, /*nonce=*/0)};
+    CHECK(buffer.read_storage(contract_address, kDefaultIncarnation, evmc::bytes32{}) == block_hashes[990]);
+}
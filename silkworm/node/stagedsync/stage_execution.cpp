@@ -16,10 +16,10 @@
 
 #include "stage_execution.hpp"
 
-#include <span>
 #include <stdexcept>
 
 #include <silkworm/core/common/endian.hpp>
+#include <silkworm/core/common/util.hpp>
 #include <silkworm/core/execution/processor.hpp>
 #include <silkworm/node/common/decoding_exception.hpp>
 #include <silkworm/node/common/stopwatch.hpp>
@@ -87,11 +87,28 @@ Stage::Result Execution::forward(db::RWTxn& txn) {
             prune_receipts = std::min(prune_receipts, hashstate_stage_progress - 1);
         }
 
-        static constexpr size_t kCacheSize{5'000};
-        BaselineAnalysisCache analysis_cache{kCacheSize};
+        // Analyses are shared process-wide so that hot contracts are not analyzed again on every stage cycle
+        BaselineAnalysisCache& analysis_cache{BaselineAnalysisCache::shared()};
         ObjectPool<EvmoneExecutionState> state_pool;
 
+        // Transactions of a block are executed in parallel only if requested
+        std::unique_ptr<PooledTaskRunner> task_runner;
+        if (node_settings_->execution_workers) {
+            task_runner = std::make_unique<PooledTaskRunner>(node_settings_->execution_workers);
+        }
+
         prefetched_blocks_.clear();
+        prefetched_blocks_size_ = 0;
+        if (segment_width > db::stages::kSmallBlockSegmentWidth && BlockPrefetcher::is_visible(txn, max_block_num)) {
+            block_prefetcher_ = std::make_unique<BlockPrefetcher>(txn->env(), kMaxPrefetchedBlocks);
+            block_prefetcher_->start(block_num_, max_block_num);
+        }
+        if (segment_width > db::stages::kSmallBlockSegmentWidth) {
+            state_prefetcher_ = std::make_unique<StatePrefetcher>(txn->env(), node_settings_->chain_config.value(),
+                                                                  &analysis_cache);
+            state_prefetcher_->start();
+            state_prefetch_progress_ = 0;
+        }
 
         while (block_num_ <= max_block_num) {
             throw_if_stopping();
@@ -99,6 +116,7 @@ Stage::Result Execution::forward(db::RWTxn& txn) {
                                                       max_block_num,
                                                       analysis_cache,
                                                       state_pool,
+                                                      task_runner.get(),
                                                       prune_history,
                                                       prune_receipts)};
 
@@ -118,7 +136,10 @@ Stage::Result Execution::forward(db::RWTxn& txn) {
             (void)commit_stopwatch.start(/*with_reset=*/true);
             txn.commit();
             auto [_, duration]{commit_stopwatch.stop()};
-            log::Info(log_prefix_ + " commit", {"batch time", StopWatch::format(duration)});
+            batch_size_controller_.on_commit(batch_flush_time_ + duration);
+            log::Info(log_prefix_ + " commit", {"batch time", StopWatch::format(duration),
+                                                "flush time", StopWatch::format(batch_flush_time_),
+                                                "batch scale", std::to_string(batch_size_controller_.scale())});
 
             // If an invalid block returned now can throw
             if (execution_result == Stage::Result::kInvalidBlock) {
@@ -146,6 +167,8 @@ Stage::Result Execution::forward(db::RWTxn& txn) {
         ret = Stage::Result::kUnexpectedError;
     }
 
+    state_prefetcher_.reset();
+    block_prefetcher_.reset();
     operation_ = OperationType::None;
     return ret;
 }
@@ -161,6 +184,9 @@ void Execution::prefetch_blocks(db::RWTxn& txn, const BlockNum from, const Block
     const size_t count{std::min(static_cast<size_t>(to - from + 1), kMaxPrefetchedBlocks)};
     size_t num_read{0};
 
+    // Frozen blocks are read from snapshots, the others from db
+    const db::DataModel data_model{txn};
+
     db::PooledCursor canonicals(txn, db::table::kCanonicalHashes);
     Bytes starting_key{db::block_key(from)};
     if (canonicals.seek(db::to_slice(starting_key))) {
@@ -177,10 +203,9 @@ void Execution::prefetch_blocks(db::RWTxn& txn, const BlockNum from, const Block
                                          " got=" + std::to_string(value.length()));
             }
 
-            const auto hash_ptr{value.data()};
             prefetched_blocks_.push_back();
-            if (!db::read_block(txn, std::span<const uint8_t, kHashLength>{hash_ptr, kHashLength}, block_num,
-                                /*read_senders=*/true, prefetched_blocks_.back())) {
+            if (!data_model.read_block(block_num, to_bytes32(value), /*read_senders=*/true,
+                                       prefetched_blocks_.back())) {
                 throw std::runtime_error("Unable to read block " + std::to_string(block_num));
             }
             ++block_num;
@@ -198,22 +223,53 @@ void Execution::prefetch_blocks(db::RWTxn& txn, const BlockNum from, const Block
     }
 }
 
+BatchSizeController::MemoryUsage Execution::memory_usage(const db::Buffer& buffer,
+                                                         const BaselineAnalysisCache& analysis_cache,
+                                                         bool with_resident) const {
+    BatchSizeController::MemoryUsage usage{
+        .state_buffer = buffer.current_batch_state_size(),
+        .history_buffer = buffer.current_batch_history_size(),
+        .prefetched_blocks = prefetched_blocks_size_,
+        .analysis_cache = analysis_cache.bytes(),
+        .resident = with_resident ? BatchSizeController::resident_memory() : 0,
+    };
+    // Blocks still queued by the prefetcher are assumed to be as large as the ones prefetched already
+    if (block_prefetcher_ && !prefetched_blocks_.empty()) {
+        usage.prefetched_blocks += block_prefetcher_->size() * (prefetched_blocks_size_ / prefetched_blocks_.size());
+    }
+    return usage;
+}
+
+void Execution::prefetch_state() {
+    state_prefetcher_->set_progress(block_num_);
+    for (const auto& block : prefetched_blocks_) {
+        const BlockNum block_num{block.header.number};
+        if (block_num >= block_num_ + kStatePrefetchDistance) {
+            break;
+        }
+        if (block_num <= state_prefetch_progress_) {
+            continue;
+        }
+        if (!state_prefetcher_->push(block)) {
+            break;  // Retry on next block
+        }
+        state_prefetch_progress_ = block_num;
+    }
+}
+
 Stage::Result Execution::execute_batch(db::RWTxn& txn, BlockNum max_block_num, BaselineAnalysisCache& analysis_cache,
-                                       ObjectPool<EvmoneExecutionState>& state_pool, BlockNum prune_history_threshold,
-                                       BlockNum prune_receipts_threshold) {
+                                       ObjectPool<EvmoneExecutionState>& state_pool, PooledTaskRunner* task_runner,
+                                       BlockNum prune_history_threshold, BlockNum prune_receipts_threshold) {
     Stage::Result ret{Stage::Result::kSuccess};
     using namespace std::chrono_literals;
     auto log_time{std::chrono::steady_clock::now()};
+    batch_flush_time_ = std::chrono::nanoseconds{0};  // Not flushed yet, e.g. if batch ends on an invalid block
 
     try {
         db::Buffer buffer(txn, prune_history_threshold);
         std::vector<Receipt> receipts;
 
-        // Transform batch_size limit into Ggas
-        size_t gas_max_history_size{node_settings_->batch_size * 1_Kibi / 2};  // 512MB -> 256Ggas roughly
-        size_t gas_max_batch_size{gas_max_history_size * 20};                  // 256Ggas -> 5Tgas roughly
-        size_t gas_history_size{0};
-        size_t gas_batch_size{0};
+        size_t blocks_since_resident_check{0};
 
         {
             std::unique_lock progress_lock(progress_mtx_);
@@ -223,11 +279,22 @@ Stage::Result Execution::execute_batch(db::RWTxn& txn, BlockNum max_block_num, B
         while (true) {
             if (prefetched_blocks_.empty()) {
                 throw_if_stopping();
-                prefetch_blocks(txn, block_num_, max_block_num);
+                if (block_prefetcher_) {
+                    (void)block_prefetcher_->pop(prefetched_blocks_, BlockPrefetcher::kDefaultChunkSize);
+                } else {
+                    prefetch_blocks(txn, block_num_, max_block_num);
+                }
+                prefetched_blocks_size_ = 0;
+                for (const auto& prefetched_block : prefetched_blocks_) {
+                    prefetched_blocks_size_ += BatchSizeController::estimated_size(prefetched_block);
+                }
             }
 
             const Block& block{prefetched_blocks_.front()};
             check_block_sequence(block.header.number, block_num_);
+            if (state_prefetcher_) {
+                prefetch_state();
+            }
 
             // Log and abort check
             if (const auto now{std::chrono::steady_clock::now()}; log_time <= now) {
@@ -238,16 +305,22 @@ Stage::Result Execution::execute_batch(db::RWTxn& txn, BlockNum max_block_num, B
             ExecutionProcessor processor(block, *consensus_engine_, buffer, node_settings_->chain_config.value());
             processor.evm().baseline_analysis_cache = &analysis_cache;
             processor.evm().state_pool = &state_pool;
+            processor.enable_parallel_execution(task_runner);
 
             // TODO Add Tracer and collect call traces
 
-            if (const auto res{processor.execute_and_write_block(receipts)}; res != ValidationResult::kOk) {
+            const auto res{processor.execute_and_write_block(receipts)};
+            if (task_runner) {
+                task_runner->rethrow_if_failed();
+            }
+            if (res != ValidationResult::kOk) {
                 // Persist work done so far
                 if (block_num_ >= prune_receipts_threshold) {
                     buffer.insert_receipts(block_num_, receipts);
                 }
                 buffer.write_to_db();
                 prefetched_blocks_.clear();
+                prefetched_blocks_size_ = 0;
 
                 // Notify sync_loop we need to unwind
                 sync_context_->unwind_point.emplace(block_num_ - 1u);
@@ -270,22 +343,33 @@ Stage::Result Execution::execute_batch(db::RWTxn& txn, BlockNum max_block_num, B
             ++processed_blocks_;
             processed_transactions_ += block.transactions.size();
             processed_gas_ += block.header.gas_used;
-            gas_batch_size += block.header.gas_used;
-            gas_history_size += block.header.gas_used;
             progress_lock.unlock();
 
+            const size_t block_size{BatchSizeController::estimated_size(block)};
+            prefetched_blocks_size_ -= std::min(block_size, prefetched_blocks_size_);
             prefetched_blocks_.pop_front();
 
+            // Resident memory is read once in a while as it's not for free
+            const bool with_resident{++blocks_since_resident_check == kResidentMemoryCheckInterval};
+            if (with_resident) {
+                blocks_since_resident_check = 0;
+            }
+            const auto flush{block_num_ >= max_block_num
+                                 ? BatchSizeController::Flush::kAll
+                                 : batch_size_controller_.flush_needed(memory_usage(buffer, analysis_cache, with_resident))};
+
             // Flush whole buffer if time to
-            if (gas_batch_size >= gas_max_batch_size || block_num_ >= max_block_num) {
+            if (flush == BatchSizeController::Flush::kAll) {
                 log::Trace(log_prefix_, {"buffer", "state", "size", human_size(buffer.current_batch_state_size())});
+                StopWatch flush_stopwatch{/*auto_start=*/true};
                 buffer.write_to_db();
+                batch_flush_time_ = flush_stopwatch.stop().second;
                 break;
-            } else if (gas_history_size >= gas_max_history_size) {
+            } else if (flush == BatchSizeController::Flush::kHistory) {
                 // or flush history only if needed
-                log::Trace(log_prefix_, {"buffer", "history", "size", human_size(buffer.current_batch_state_size())});
+                log::Trace(log_prefix_,
+                           {"buffer", "history", "size", human_size(buffer.current_batch_history_size())});
                 buffer.write_history_to_db();
-                gas_history_size = 0;
             }
 
             ++block_num_;
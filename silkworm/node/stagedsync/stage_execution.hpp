@@ -21,7 +21,12 @@
 #include <silkworm/core/consensus/engine.hpp>
 #include <silkworm/core/execution/analysis_cache.hpp>
 #include <silkworm/core/execution/evm.hpp>
+#include <silkworm/node/db/buffer.hpp>
 #include <silkworm/node/stagedsync/stage.hpp>
+#include <silkworm/node/stagedsync/stage_execution/batch_size_controller.hpp>
+#include <silkworm/node/stagedsync/stage_execution/block_prefetcher.hpp>
+#include <silkworm/node/stagedsync/stage_execution/pooled_task_runner.hpp>
+#include <silkworm/node/stagedsync/stage_execution/state_prefetcher.hpp>
 
 namespace silkworm::stagedsync {
 
@@ -29,7 +34,8 @@ class Execution final : public Stage {
   public:
     explicit Execution(NodeSettings* node_settings, SyncContext* sync_context)
         : Stage(sync_context, db::stages::kExecutionKey, node_settings),
-          consensus_engine_{consensus::engine_factory(node_settings->chain_config.value())} {}
+          consensus_engine_{consensus::engine_factory(node_settings->chain_config.value())},
+          batch_size_controller_{node_settings->execution_memory_budget} {}
 
     ~Execution() override = default;
 
@@ -40,23 +46,40 @@ class Execution final : public Stage {
 
   private:
     static constexpr size_t kMaxPrefetchedBlocks{10240};
+    static constexpr BlockNum kStatePrefetchDistance{32};       // Number of blocks whose state is warmed up ahead
+    static constexpr size_t kResidentMemoryCheckInterval{128};  // Number of blocks between reads of resident memory
 
     std::unique_ptr<consensus::IEngine> consensus_engine_;
     BlockNum block_num_{0};
     boost::circular_buffer<Block> prefetched_blocks_{/*buffer_capacity=*/kMaxPrefetchedBlocks};
-
-    //! \brief Prefetches blocks for processing
+    size_t prefetched_blocks_size_{0};                   // Estimated memory taken by prefetched_blocks_
+    std::unique_ptr<BlockPrefetcher> block_prefetcher_;  // Valued when blocks are read ahead on a separate thread
+    std::unique_ptr<StatePrefetcher> state_prefetcher_;  // Valued when state is warmed up ahead on a separate thread
+    BlockNum state_prefetch_progress_{0};                // Last block whose state has been requested to be warmed up
+    BatchSizeController batch_size_controller_;          // Tells when batches are to be flushed
+    std::chrono::nanoseconds batch_flush_time_{0};       // Time taken to write last batch to db (commit excluded)
+
+    //! \brief Prefetches blocks for processing synchronously within the stage transaction
     //! \param [in] from: the first block to prefetch (inclusive)
     //! \param [in] to: the last block to prefetch (inclusive)
     //! \remarks The amount of blocks to be fetched is determined by the upper block number (to)
-    //! or kMaxPrefetchedBlocks collected, whichever comes first
+    //! or kMaxPrefetchedBlocks collected, whichever comes first.
+    //! Used when blocks to process are not yet committed hence not visible to block_prefetcher_
     void prefetch_blocks(db::RWTxn& txn, BlockNum from, BlockNum to);
 
+    //! \brief Requests the state touched by the next kStatePrefetchDistance prefetched blocks to be warmed up
+    void prefetch_state();
+
+    //! \brief Memory currently taken by the components of a batch
+    BatchSizeController::MemoryUsage memory_usage(const db::Buffer& buffer, const BaselineAnalysisCache& analysis_cache,
+                                                  bool with_resident) const;
+
     //! \brief Executes a batch of blocks
+    //! \param [in] task_runner : the runner executing the transactions of a block in parallel (if any)
     //! \remarks A batch completes when either max block is reached or buffer dimensions overflow
     Stage::Result execute_batch(db::RWTxn& txn, BlockNum max_block_num, BaselineAnalysisCache& analysis_cache,
-                                ObjectPool<EvmoneExecutionState>& state_pool, BlockNum prune_history_threshold,
-                                BlockNum prune_receipts_threshold);
+                                ObjectPool<EvmoneExecutionState>& state_pool, PooledTaskRunner* task_runner,
+                                BlockNum prune_history_threshold, BlockNum prune_receipts_threshold);
 
     //! \brief For given changeset cursor/bucket it reverts the changes on states buckets
     static void unwind_state_from_changeset(mdbx::cursor& source_changeset, mdbx::cursor& plain_state_table,
@@ -0,0 +1,119 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "batch_size_controller.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <fstream>
+
+namespace silkworm::stagedsync {
+
+// Budget taken when physical memory is unknown
+static constexpr size_t kFallbackMemoryBudget{2_Gibi};
+
+// Min amount of memory left to buffers, so that batches are never too small to be worth a commit
+static constexpr size_t kMinBuffersLimit{64_Mebi};
+
+BatchSizeController::BatchSizeController(size_t memory_budget, std::chrono::milliseconds target_commit_time)
+    : memory_budget_{memory_budget}, target_commit_time_{target_commit_time} {
+    if (!memory_budget_) {
+        const size_t physical{physical_memory()};
+        memory_budget_ = physical ? physical / 4 : kFallbackMemoryBudget;
+    }
+    memory_budget_ = std::max(memory_budget_, kMinBuffersLimit);
+}
+
+size_t BatchSizeController::buffers_limit(const MemoryUsage& usage) const noexcept {
+    const size_t others{usage.prefetched_blocks + usage.analysis_cache};
+    const size_t available{memory_budget_ > others ? memory_budget_ - others : 0};
+    return std::max(static_cast<size_t>(static_cast<double>(available) * scale_), kMinBuffersLimit);
+}
+
+BatchSizeController::Flush BatchSizeController::flush_needed(const MemoryUsage& usage) const noexcept {
+    const size_t limit{buffers_limit(usage)};
+    const size_t buffers{usage.state_buffer + usage.history_buffer};
+    if (buffers >= limit) {
+        return Flush::kAll;
+    }
+    // Memory not accounted for is piling up: release what we can unless buffers are still small
+    if (usage.resident > memory_budget_ && buffers >= limit / kHistoryShare) {
+        return Flush::kAll;
+    }
+    if (usage.history_buffer >= limit / kHistoryShare) {
+        return Flush::kHistory;
+    }
+    return Flush::kNone;
+}
+
+void BatchSizeController::on_commit(std::chrono::nanoseconds duration) noexcept {
+    if (duration > target_commit_time_) {
+        // Shrink proportionally: commit time is roughly linear with the amount of data written
+        const double ratio{static_cast<double>(target_commit_time_.count()) / static_cast<double>(duration.count())};
+        scale_ = std::max(scale_ * ratio, kMinScale);
+    } else if (duration < target_commit_time_ / 2) {
+        scale_ = std::min(scale_ * 1.25, 1.0);
+    }
+}
+
+size_t BatchSizeController::estimated_size(const Block& block) noexcept {
+    size_t size{sizeof(Block) + block.header.extra_data.capacity()};
+    size += block.ommers.capacity() * sizeof(BlockHeader);
+    size += block.transactions.capacity() * sizeof(Transaction);
+    for (const auto& txn : block.transactions) {
+        size += txn.data.capacity() + txn.access_list.capacity() * sizeof(AccessListEntry);
+        for (const auto& entry : txn.access_list) {
+            size += entry.storage_keys.capacity() * kHashLength;
+        }
+    }
+    if (block.withdrawals) {
+        size += block.withdrawals->capacity() * sizeof(Withdrawal);
+    }
+    return size;
+}
+
+size_t BatchSizeController::resident_memory() noexcept {
+#ifdef __linux__
+    // Resident pages not backed by files, i.e. excluding the pages of memory mapped databases and snapshots
+    std::ifstream statm{"/proc/self/statm"};
+    size_t total_pages{0}, resident_pages{0}, shared_pages{0};
+    if (!(statm >> total_pages >> resident_pages >> shared_pages) || resident_pages < shared_pages) {
+        return 0;
+    }
+    return (resident_pages - shared_pages) * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+    return 0;
+#endif
+}
+
+size_t BatchSizeController::physical_memory() noexcept {
+#ifdef _WIN32
+    MEMORYSTATUSEX status{};
+    status.dwLength = sizeof(status);
+    return GlobalMemoryStatusEx(&status) ? static_cast<size_t>(status.ullTotalPhys) : 0;
+#else
+    const long pages{sysconf(_SC_PHYS_PAGES)};
+    const long page_size{sysconf(_SC_PAGESIZE)};
+    return pages > 0 && page_size > 0 ? static_cast<size_t>(pages) * static_cast<size_t>(page_size) : 0;
+#endif
+}
+
+}  // namespace silkworm::stagedsync
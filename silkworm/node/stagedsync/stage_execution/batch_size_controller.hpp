@@ -0,0 +1,86 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+#include <silkworm/core/types/block.hpp>
+
+namespace silkworm::stagedsync {
+
+//! \brief Tells when the Execution stage has to flush its buffers, keeping the memory taken by a batch within a
+//! budget and the time taken to write and commit it around a target.
+//! \remarks The share of the budget left to buffers is what remains once blocks read ahead and code analyses are
+//! accounted for. Such share is further scaled down when commits take longer than targeted and back up when they are
+//! quick. Process anonymous resident memory, when available, acts as a hard ceiling for what is not accounted for
+//! (e.g. IntraBlockState and allocator fragmentation).
+class BatchSizeController {
+  public:
+    static constexpr std::chrono::seconds kDefaultTargetCommitTime{20};
+
+    //! \brief Memory taken by the components of a batch in bytes
+    struct MemoryUsage {
+        size_t state_buffer{0};       // State accrued in db::Buffer
+        size_t history_buffer{0};     // History accrued in db::Buffer
+        size_t prefetched_blocks{0};  // Blocks read ahead waiting to be executed
+        size_t analysis_cache{0};     // Code analyses shared by EVMs
+        size_t resident{0};           // Anonymous resident memory of the process (0 if unknown)
+    };
+
+    enum class Flush {
+        kNone,     // Keep on executing
+        kHistory,  // Flush history only
+        kAll,      // Flush all data and commit
+    };
+
+    //! \param [in] memory_budget : the max amount of memory a batch can take (0 for a share of physical memory)
+    //! \param [in] target_commit_time : the time writing and committing a batch should take
+    explicit BatchSizeController(size_t memory_budget,
+                                 std::chrono::milliseconds target_commit_time = kDefaultTargetCommitTime);
+
+    //! \brief Tells what has to be flushed given current memory usage
+    [[nodiscard]] Flush flush_needed(const MemoryUsage& usage) const noexcept;
+
+    //! \brief Adapts batch size to the time taken to write and commit last batch
+    void on_commit(std::chrono::nanoseconds duration) noexcept;
+
+    //! \brief The amount of memory buffers can take given the memory taken by other components
+    [[nodiscard]] size_t buffers_limit(const MemoryUsage& usage) const noexcept;
+
+    [[nodiscard]] size_t memory_budget() const noexcept { return memory_budget_; }
+    [[nodiscard]] double scale() const noexcept { return scale_; }
+
+    //! \brief Estimated memory taken by a block
+    static size_t estimated_size(const Block& block) noexcept;
+
+    //! \brief Anonymous resident memory of this process in bytes (0 if unknown)
+    static size_t resident_memory() noexcept;
+
+    //! \brief Physical memory of this host in bytes (0 if unknown)
+    static size_t physical_memory() noexcept;
+
+  private:
+    static constexpr double kMinScale{1.0 / 16};
+    static constexpr size_t kHistoryShare{4};  // History alone is flushed when it takes this fraction of the limit
+
+    size_t memory_budget_;
+    std::chrono::nanoseconds target_commit_time_;
+    double scale_{1.0};
+};
+
+}  // namespace silkworm::stagedsync
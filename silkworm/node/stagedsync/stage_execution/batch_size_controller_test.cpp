@@ -0,0 +1,121 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "batch_size_controller.hpp"
+
+#include <algorithm>
+
+#include <catch2/catch.hpp>
+
+namespace silkworm::stagedsync {
+
+using namespace std::chrono_literals;
+
+TEST_CASE("BatchSizeController flush decisions") {
+    BatchSizeController controller{1_Gibi, 20s};
+    CHECK(controller.memory_budget() == 1_Gibi);
+
+    SECTION("buffers within limit") {
+        BatchSizeController::MemoryUsage usage;
+        usage.state_buffer = 100_Mebi;
+        usage.history_buffer = 100_Mebi;
+        CHECK(controller.flush_needed(usage) == BatchSizeController::Flush::kNone);
+    }
+
+    SECTION("buffers exceeding limit") {
+        BatchSizeController::MemoryUsage usage;
+        usage.state_buffer = 800_Mebi;
+        usage.history_buffer = 224_Mebi;
+        CHECK(controller.flush_needed(usage) == BatchSizeController::Flush::kAll);
+    }
+
+    SECTION("other components shrink buffers limit") {
+        BatchSizeController::MemoryUsage usage;
+        usage.state_buffer = 400_Mebi;
+        usage.prefetched_blocks = 256_Mebi;
+        usage.analysis_cache = 512_Mebi;
+        CHECK(controller.buffers_limit(usage) == 256_Mebi);
+        CHECK(controller.flush_needed(usage) == BatchSizeController::Flush::kAll);
+    }
+
+    SECTION("buffers limit has a floor") {
+        BatchSizeController::MemoryUsage usage;
+        usage.prefetched_blocks = 2_Gibi;
+        CHECK(controller.buffers_limit(usage) == 64_Mebi);
+    }
+
+    SECTION("history alone") {
+        BatchSizeController::MemoryUsage usage;
+        usage.state_buffer = 100_Mebi;
+        usage.history_buffer = 300_Mebi;
+        CHECK(controller.flush_needed(usage) == BatchSizeController::Flush::kHistory);
+    }
+
+    SECTION("resident memory over budget") {
+        BatchSizeController::MemoryUsage usage;
+        usage.state_buffer = 300_Mebi;
+        usage.resident = 2_Gibi;
+        CHECK(controller.flush_needed(usage) == BatchSizeController::Flush::kAll);
+        usage.state_buffer = 10_Mebi;
+        CHECK(controller.flush_needed(usage) == BatchSizeController::Flush::kNone);
+    }
+}
+
+TEST_CASE("BatchSizeController adapts to commit time") {
+    BatchSizeController controller{1_Gibi, 20s};
+    const BatchSizeController::MemoryUsage usage{};
+    CHECK(controller.buffers_limit(usage) == 1_Gibi);
+
+    controller.on_commit(40s);
+    CHECK(controller.scale() == 0.5);
+    CHECK(controller.buffers_limit(usage) == 512_Mebi);
+
+    controller.on_commit(15s);  // within target: unchanged
+    CHECK(controller.scale() == 0.5);
+
+    controller.on_commit(5s);
+    CHECK(controller.scale() == 0.625);
+
+    for (int i{0}; i < 10; ++i) {
+        controller.on_commit(1s);
+    }
+    CHECK(controller.scale() == 1.0);
+
+    for (int i{0}; i < 10; ++i) {
+        controller.on_commit(10min);
+    }
+    CHECK(controller.scale() == 1.0 / 16);
+}
+
+TEST_CASE("BatchSizeController default budget") {
+    BatchSizeController controller{0};
+    CHECK(controller.memory_budget() >= 64_Mebi);
+    if (const size_t physical{BatchSizeController::physical_memory()}; physical) {
+        CHECK(controller.memory_budget() == std::max(physical / 4, size_t{64_Mebi}));
+    }
+}
+
+TEST_CASE("BatchSizeController block size estimate") {
+    Block block;
+    const size_t empty_size{BatchSizeController::estimated_size(block)};
+    CHECK(empty_size >= sizeof(Block));
+
+    block.transactions.resize(2);
+    block.transactions[0].data = Bytes(1000, 0x01);
+    CHECK(BatchSizeController::estimated_size(block) >= empty_size + 2 * sizeof(Transaction) + 1000);
+}
+
+}  // namespace silkworm::stagedsync
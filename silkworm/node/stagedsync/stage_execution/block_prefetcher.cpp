@@ -0,0 +1,170 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "block_prefetcher.hpp"
+
+#include <algorithm>
+#include <future>
+#include <stdexcept>
+
+#include <silkworm/core/common/endian.hpp>
+#include <silkworm/core/common/util.hpp>
+#include <silkworm/node/db/access_layer.hpp>
+#include <silkworm/node/db/stages.hpp>
+
+namespace silkworm::stagedsync {
+
+BlockPrefetcher::BlockPrefetcher(mdbx::env env, size_t capacity, size_t chunk_size)
+    : env_{std::move(env)}, capacity_{capacity ? capacity : 1}, chunk_size_{chunk_size ? chunk_size : 1} {}
+
+BlockPrefetcher::~BlockPrefetcher() { stop(); }
+
+void BlockPrefetcher::start(BlockNum from, BlockNum to) {
+    stop();
+    {
+        std::unique_lock lock{mutex_};
+        queue_.clear();
+        exception_ = nullptr;
+        stopping_ = false;
+        completed_ = from > to;
+    }
+    if (from <= to) {
+        producer_ = std::thread([this, from, to]() { run(from, to); });
+    }
+}
+
+void BlockPrefetcher::stop() {
+    {
+        std::unique_lock lock{mutex_};
+        stopping_ = true;
+    }
+    not_full_.notify_all();
+    if (producer_.joinable()) {
+        producer_.join();
+    }
+}
+
+size_t BlockPrefetcher::pop(boost::circular_buffer<Block>& out, size_t max_count) {
+    std::unique_lock lock{mutex_};
+    not_empty_.wait(lock, [this] { return !queue_.empty() || exception_ || completed_; });
+    if (queue_.empty()) {
+        if (exception_) {
+            std::rethrow_exception(exception_);
+        }
+        throw std::runtime_error("Block prefetcher has no more blocks to provide");
+    }
+
+    size_t count{std::min({queue_.size(), max_count, out.capacity() - out.size()})};
+    for (size_t i{0}; i < count; ++i) {
+        out.push_back(std::move(queue_.front()));
+        queue_.pop_front();
+    }
+    lock.unlock();
+    not_full_.notify_one();
+    return count;
+}
+
+size_t BlockPrefetcher::size() const {
+    std::unique_lock lock{mutex_};
+    return queue_.size();
+}
+
+bool BlockPrefetcher::is_visible(db::ROTxn& txn, BlockNum to) {
+    const auto canonical_hash{db::read_canonical_hash(txn, to)};
+    if (!canonical_hash) {
+        return false;
+    }
+
+    // MDBX does not allow a read-only transaction to overlap a read-write one on the same thread
+    mdbx::env env{txn->env()};
+    auto visible{std::async(std::launch::async, [&env, &canonical_hash, to]() {
+        db::ROTxn ro_txn{env};
+        // Canonical hash at the upper bound pins the whole chain segment below it
+        return db::stages::read_stage_progress(ro_txn, db::stages::kSendersKey) >= to &&
+               db::read_canonical_hash(ro_txn, to) == canonical_hash;
+    })};
+    return visible.get();
+}
+
+void BlockPrefetcher::run(BlockNum from, BlockNum to) {
+    try {
+        std::vector<Block> blocks;
+        blocks.reserve(chunk_size_);
+        for (BlockNum block_num{from}; block_num <= to;) {
+            const size_t count{std::min(static_cast<size_t>(to - block_num + 1), chunk_size_)};
+            read_chunk(block_num, count, blocks);
+            block_num += count;
+
+            for (auto& block : blocks) {
+                std::unique_lock lock{mutex_};
+                not_full_.wait(lock, [this] { return queue_.size() < capacity_ || stopping_; });
+                if (stopping_) {
+                    return;
+                }
+                queue_.push_back(std::move(block));
+                lock.unlock();
+                not_empty_.notify_one();
+            }
+            blocks.clear();
+        }
+        std::unique_lock lock{mutex_};
+        completed_ = true;
+    } catch (...) {
+        std::unique_lock lock{mutex_};
+        exception_ = std::current_exception();
+    }
+    not_empty_.notify_all();
+}
+
+void BlockPrefetcher::read_chunk(BlockNum from, size_t count, std::vector<Block>& blocks) {
+    // A new transaction for each chunk avoids to retain old snapshots while consumer commits
+    db::ROTxn txn{env_};
+
+    // Frozen blocks are read from snapshots, the others from db
+    const db::DataModel data_model{txn};
+
+    db::PooledCursor canonicals(txn, db::table::kCanonicalHashes);
+    const Bytes starting_key{db::block_key(from)};
+    size_t num_read{0};
+    if (canonicals.seek(db::to_slice(starting_key))) {
+        BlockNum block_num{from};
+        auto walk_function{[&](ByteView key, ByteView value) {
+            BlockNum reached_block_num{endian::load_big_u64(key.data())};
+            if (reached_block_num != block_num) {
+                throw std::runtime_error("Bad canonical header sequence: expected " + std::to_string(block_num) +
+                                         " got " + std::to_string(reached_block_num));
+            } else if (value.length() != kHashLength) {
+                throw std::runtime_error("Invalid value for hash in " +
+                                         std::string(db::table::kCanonicalHashes.name) +
+                                         " expected=" + std::to_string(kHashLength) +
+                                         " got=" + std::to_string(value.length()));
+            }
+
+            auto& block{blocks.emplace_back()};
+            if (!data_model.read_block(block_num, to_bytes32(value), /*read_senders=*/true, block)) {
+                throw std::runtime_error("Unable to read block " + std::to_string(block_num));
+            }
+            ++block_num;
+        }};
+        num_read = db::cursor_for_count(canonicals, walk_function, count);
+    }
+
+    if (num_read != count) {
+        throw std::runtime_error("Missing block " + std::to_string(from + num_read));
+    }
+}
+
+}  // namespace silkworm::stagedsync
@@ -0,0 +1,88 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include <boost/circular_buffer.hpp>
+
+#include <silkworm/core/types/block.hpp>
+#include <silkworm/node/db/mdbx.hpp>
+
+namespace silkworm::stagedsync {
+
+//! \brief Reads and decodes canonical blocks (with senders) ahead of execution on a dedicated thread.
+//! \remarks Blocks are read through a read-only transaction of its own, renewed at every chunk so that no old
+//! MVCC snapshot is kept alive while the consumer commits. Hence the producer can only see data which has been
+//! committed: callers must verify the range to prefetch is visible to a read-only transaction (see is_visible).
+class BlockPrefetcher {
+  public:
+    static constexpr size_t kDefaultChunkSize{1024};
+
+    //! \param [in] env : the database environment to open read-only transactions on
+    //! \param [in] capacity : the max number of decoded blocks kept in queue waiting to be consumed
+    //! \param [in] chunk_size : the max number of blocks read within the same read-only transaction
+    explicit BlockPrefetcher(mdbx::env env, size_t capacity, size_t chunk_size = kDefaultChunkSize);
+    ~BlockPrefetcher();
+
+    // Not copyable nor movable
+    BlockPrefetcher(const BlockPrefetcher&) = delete;
+    BlockPrefetcher& operator=(const BlockPrefetcher&) = delete;
+
+    //! \brief Starts the producer thread which prefetches blocks in range [from, to]
+    void start(BlockNum from, BlockNum to);
+
+    //! \brief Requests the producer thread to stop and waits for it
+    void stop();
+
+    //! \brief Moves into out (at most max_count) the blocks already prefetched, waiting for at least one to be available
+    //! \return The number of blocks moved into out
+    //! \remarks Rethrows any exception occurred on the producer side. Throws if the range has been fully consumed
+    size_t pop(boost::circular_buffer<Block>& out, size_t max_count);
+
+    //! \brief Returns the number of blocks prefetched and waiting to be consumed
+    [[nodiscard]] size_t size() const;
+
+    //! \brief Whether the canonical chain in range [.., to] as seen by txn is visible to a read-only transaction
+    //! i.e. whether all required data has been committed
+    static bool is_visible(db::ROTxn& txn, BlockNum to);
+
+  private:
+    void run(BlockNum from, BlockNum to);
+
+    //! \brief Reads canonical blocks in range [from, from + count) within a new read-only transaction
+    void read_chunk(BlockNum from, size_t count, std::vector<Block>& blocks);
+
+    mdbx::env env_;
+    const size_t capacity_;
+    const size_t chunk_size_;
+
+    std::thread producer_;
+    mutable std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    std::deque<Block> queue_;
+    std::exception_ptr exception_;
+    bool stopping_{false};
+    bool completed_{false};
+};
+
+}  // namespace silkworm::stagedsync
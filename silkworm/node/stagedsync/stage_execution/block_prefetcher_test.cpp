@@ -0,0 +1,97 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "block_prefetcher.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/node/common/test_context.hpp>
+#include <silkworm/node/db/access_layer.hpp>
+#include <silkworm/node/db/stages.hpp>
+
+namespace silkworm::stagedsync {
+
+static void write_blocks(db::RWTxn& txn, BlockNum from, BlockNum to) {
+    for (BlockNum block_num{from}; block_num <= to; ++block_num) {
+        BlockHeader header;
+        header.number = block_num;
+        header.gas_limit = 5'000;
+        const auto hash{header.hash()};
+        db::write_header(txn, header, /*with_header_numbers=*/true);
+        db::write_canonical_header(txn, header);
+        db::write_body(txn, BlockBody{}, hash, block_num);
+    }
+}
+
+TEST_CASE("BlockPrefetcher") {
+    test::Context context;
+    db::RWTxn& txn{context.rw_txn()};
+
+    static constexpr BlockNum kMaxBlock{100};
+    write_blocks(txn, 1, kMaxBlock);
+    db::stages::write_stage_progress(txn, db::stages::kSendersKey, kMaxBlock);
+
+    SECTION("uncommitted blocks are not visible") {
+        CHECK_FALSE(BlockPrefetcher::is_visible(txn, kMaxBlock));
+    }
+
+    SECTION("committed blocks are prefetched in order") {
+        context.commit_and_renew_txn();
+        REQUIRE(BlockPrefetcher::is_visible(txn, kMaxBlock));
+        CHECK_FALSE(BlockPrefetcher::is_visible(txn, kMaxBlock + 1));
+
+        BlockPrefetcher prefetcher{txn->env(), /*capacity=*/16, /*chunk_size=*/7};
+        prefetcher.start(1, kMaxBlock);
+
+        boost::circular_buffer<Block> blocks{/*buffer_capacity=*/10};
+        BlockNum expected_block_num{1};
+        while (expected_block_num <= kMaxBlock) {
+            REQUIRE(prefetcher.pop(blocks, 5) > 0);
+            CHECK(blocks.size() <= 5);
+            while (!blocks.empty()) {
+                CHECK(blocks.front().header.number == expected_block_num);
+                blocks.pop_front();
+                ++expected_block_num;
+            }
+        }
+        CHECK(prefetcher.size() == 0);
+        CHECK_THROWS(prefetcher.pop(blocks, 5));
+    }
+
+    SECTION("missing blocks are reported to consumer") {
+        context.commit_and_renew_txn();
+
+        BlockPrefetcher prefetcher{txn->env(), /*capacity=*/16};
+        prefetcher.start(kMaxBlock + 1, kMaxBlock + 10);
+
+        boost::circular_buffer<Block> blocks{/*buffer_capacity=*/10};
+        CHECK_THROWS_AS(prefetcher.pop(blocks, 10), std::runtime_error);
+    }
+
+    SECTION("stop while producer is waiting") {
+        context.commit_and_renew_txn();
+
+        BlockPrefetcher prefetcher{txn->env(), /*capacity=*/4, /*chunk_size=*/2};
+        prefetcher.start(1, kMaxBlock);
+
+        boost::circular_buffer<Block> blocks{/*buffer_capacity=*/1};
+        REQUIRE(prefetcher.pop(blocks, 1) == 1);
+        CHECK(blocks.front().header.number == 1);
+        CHECK_NOTHROW(prefetcher.stop());
+    }
+}
+
+}  // namespace silkworm::stagedsync
@@ -0,0 +1,95 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "pooled_task_runner.hpp"
+
+namespace silkworm::stagedsync {
+
+bool PooledTaskRunner::run(const std::vector<std::function<void()>>& tasks) noexcept {
+    std::unique_lock lock{mutex_};
+    completed_tasks_ = 0;
+    exception_ = nullptr;
+    lock.unlock();
+
+    size_t posted_tasks{0};
+    try {
+        for (const auto& task : tasks) {
+            workers_.push_task([this, &task]() {
+                try {
+                    task();
+                } catch (...) {
+                    fail(std::current_exception());
+                }
+                task_completed();
+            });
+            ++posted_tasks;
+        }
+    } catch (...) {
+        fail(std::current_exception());
+    }
+
+    // Serve reads until all posted tasks have completed
+    lock.lock();
+    while (true) {
+        requests_cv_.wait(lock, [&]() { return !requests_.empty() || completed_tasks_ == posted_tasks; });
+        if (requests_.empty()) {
+            break;
+        }
+        ReadRequest* request{requests_.front()};
+        requests_.pop_front();
+        lock.unlock();
+        try {
+            (*request->read)();
+        } catch (...) {
+            fail(std::current_exception());
+        }
+        request->served.set_value();  // The request may be gone from now on
+        lock.lock();
+    }
+    return !exception_;
+}
+
+void PooledTaskRunner::read_db(const std::function<void()>& read) noexcept {
+    ReadRequest request{&read, {}};
+    std::future<void> served{request.served.get_future()};
+    {
+        std::unique_lock lock{mutex_};
+        requests_.push_back(&request);
+        requests_cv_.notify_one();
+    }
+    served.wait();
+}
+
+void PooledTaskRunner::rethrow_if_failed() const {
+    if (exception_) {
+        std::rethrow_exception(exception_);
+    }
+}
+
+void PooledTaskRunner::task_completed() noexcept {
+    std::unique_lock lock{mutex_};
+    ++completed_tasks_;
+    requests_cv_.notify_one();
+}
+
+void PooledTaskRunner::fail(std::exception_ptr exception) noexcept {
+    std::unique_lock lock{mutex_};
+    if (!exception_) {
+        exception_ = std::move(exception);
+    }
+}
+
+}  // namespace silkworm::stagedsync
@@ -0,0 +1,74 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <vector>
+
+#include <silkworm/core/execution/processor.hpp>
+#include <silkworm/node/concurrency/thread_pool.hpp>
+
+namespace silkworm::stagedsync {
+
+//! \brief Runs the speculative executions of the transactions of a block on a pool of worker threads.
+//! \remarks Tasks and reads never let exceptions escape: the first one is kept and the run fails, so that no task is
+//! left waiting and the block is executed again sequentially. The exception is then rethrown on the block thread by
+//! rethrow_if_failed.
+class PooledTaskRunner final : public ExecutionProcessor::TaskRunner {
+  public:
+    //! \param [in] workers : the number of worker threads
+    explicit PooledTaskRunner(uint32_t workers) : workers_{workers} {}
+
+    // Not copyable nor movable
+    PooledTaskRunner(const PooledTaskRunner&) = delete;
+    PooledTaskRunner& operator=(const PooledTaskRunner&) = delete;
+
+    bool run(const std::vector<std::function<void()>>& tasks) noexcept override;
+    void read_db(const std::function<void()>& read) noexcept override;
+
+    //! \brief Rethrows the first exception thrown by the tasks or reads of the last run, if any
+    //! \remarks Must not be called while a run is ongoing
+    void rethrow_if_failed() const;
+
+  private:
+    struct ReadRequest {
+        const std::function<void()>* read;
+        std::promise<void> served;  // Wakes up only the task which issued the read
+    };
+
+    //! \brief Signals that a task will issue no more reads
+    void task_completed() noexcept;
+
+    //! \brief Keeps the given exception, unless another one has been kept already in the current run
+    void fail(std::exception_ptr exception) noexcept;
+
+    thread_pool workers_;
+
+    std::mutex mutex_;
+    std::condition_variable requests_cv_;
+    std::deque<ReadRequest*> requests_;
+    size_t completed_tasks_{0};
+    std::exception_ptr exception_;
+};
+
+}  // namespace silkworm::stagedsync
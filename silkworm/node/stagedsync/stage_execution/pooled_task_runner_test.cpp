@@ -0,0 +1,73 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "pooled_task_runner.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+#include <catch2/catch.hpp>
+
+namespace silkworm::stagedsync {
+
+TEST_CASE("PooledTaskRunner") {
+    PooledTaskRunner task_runner{4};
+    const auto calling_thread{std::this_thread::get_id()};
+    std::atomic_size_t reads_on_calling_thread{0};
+
+    const auto read_task{[&]() {
+        for (int i{0}; i < 10; ++i) {
+            task_runner.read_db([&]() {
+                if (std::this_thread::get_id() == calling_thread) {
+                    ++reads_on_calling_thread;
+                }
+            });
+        }
+    }};
+
+    SECTION("reads are run on the calling thread") {
+        const std::vector<std::function<void()>> tasks(8, read_task);
+        CHECK(task_runner.run(tasks));
+        CHECK(reads_on_calling_thread == 80);
+        CHECK_NOTHROW(task_runner.rethrow_if_failed());
+    }
+
+    SECTION("throwing task") {
+        std::vector<std::function<void()>> tasks(8, read_task);
+        tasks[3] = [&]() {
+            read_task();
+            throw std::runtime_error{"task failed"};
+        };
+        CHECK_FALSE(task_runner.run(tasks));
+        CHECK(reads_on_calling_thread == 80);
+        CHECK_THROWS_AS(task_runner.rethrow_if_failed(), std::runtime_error);
+    }
+
+    SECTION("throwing read") {
+        std::vector<std::function<void()>> tasks(8, read_task);
+        tasks[5] = [&]() { task_runner.read_db([]() { throw std::runtime_error{"read failed"}; }); };
+        CHECK_FALSE(task_runner.run(tasks));
+        CHECK(reads_on_calling_thread == 70);
+        CHECK_THROWS_AS(task_runner.rethrow_if_failed(), std::runtime_error);
+
+        // Failures of a run are not carried over to the next one
+        CHECK(task_runner.run(std::vector<std::function<void()>>(2, read_task)));
+        CHECK_NOTHROW(task_runner.rethrow_if_failed());
+    }
+}
+
+}  // namespace silkworm::stagedsync
@@ -0,0 +1,150 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "state_prefetcher.hpp"
+
+#include <exception>
+#include <string>
+
+#include <silkworm/node/common/log.hpp>
+#include <silkworm/node/db/access_layer.hpp>
+
+namespace silkworm::stagedsync {
+
+StatePrefetcher::StatePrefetcher(mdbx::env env, const ChainConfig& config, BaselineAnalysisCache* analysis_cache,
+                                 size_t capacity)
+    : env_{std::move(env)}, config_{config}, analysis_cache_{analysis_cache}, capacity_{capacity ? capacity : 1} {}
+
+StatePrefetcher::~StatePrefetcher() { stop(); }
+
+void StatePrefetcher::start() {
+    stop();
+    {
+        std::unique_lock lock{mutex_};
+        stopping_ = false;
+    }
+    worker_ = std::thread([this]() { run(); });
+}
+
+void StatePrefetcher::stop() {
+    {
+        std::unique_lock lock{mutex_};
+        stopping_ = true;
+    }
+    not_empty_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+bool StatePrefetcher::push(const Block& block) {
+    Request request{
+        .block_num = block.header.number,
+        .revision = config_.revision(block.header.number, block.header.timestamp),
+    };
+    request.accounts.push_back(block.header.beneficiary);
+    for (const auto& txn : block.transactions) {
+        if (txn.from) {
+            request.accounts.push_back(*txn.from);
+        }
+        if (txn.to) {
+            request.accounts.push_back(*txn.to);
+        }
+        for (const auto& entry : txn.access_list) {
+            request.accounts.push_back(entry.account);
+            for (const auto& location : entry.storage_keys) {
+                request.locations.emplace_back(entry.account, location);
+            }
+        }
+    }
+
+    std::unique_lock lock{mutex_};
+    if (queue_.size() >= capacity_ || stopping_) {
+        return false;
+    }
+    queue_.push_back(std::move(request));
+    lock.unlock();
+    not_empty_.notify_one();
+    return true;
+}
+
+size_t StatePrefetcher::size() const {
+    std::unique_lock lock{mutex_};
+    return queue_.size();
+}
+
+void StatePrefetcher::run() {
+    std::vector<Request> requests;
+    try {
+        while (true) {
+            {
+                std::unique_lock lock{mutex_};
+                not_empty_.wait(lock, [this] { return !queue_.empty() || stopping_; });
+                if (stopping_) {
+                    return;
+                }
+                // Blocks already reached by execution need no more warming up
+                const BlockNum progress{progress_.load(std::memory_order_relaxed)};
+                while (!queue_.empty()) {
+                    if (queue_.front().block_num >= progress) {
+                        requests.push_back(std::move(queue_.front()));
+                    }
+                    queue_.pop_front();
+                }
+            }
+            prefetch(requests);
+            requests.clear();
+        }
+    } catch (const std::exception& ex) {
+        log::Warning("State prefetcher stopped", {"exception", std::string(ex.what())});
+    }
+}
+
+void StatePrefetcher::prefetch(const std::vector<Request>& requests) {
+    if (requests.empty()) {
+        return;
+    }
+
+    // A new transaction for each round avoids to retain old snapshots while consumer commits
+    db::ROTxn txn{env_};
+    for (const auto& request : requests) {
+        if (request.block_num < progress_.load(std::memory_order_relaxed)) {
+            continue;  // Too late
+        }
+
+        for (const auto& address : request.accounts) {
+            const auto account{db::read_account(txn, address)};
+            if (!account || account->code_hash == kEmptyHash) {
+                continue;
+            }
+            const auto code{db::read_code(txn, account->code_hash)};
+            if (!code || code->empty() || !analysis_cache_ || analysis_cache_->get(account->code_hash)) {
+                continue;
+            }
+            auto analysis{std::make_shared<evmone::baseline::CodeAnalysis>(
+                evmone::baseline::analyze(request.revision, *code))};
+            analysis_cache_->put(account->code_hash, analysis, code->size());
+        }
+
+        for (const auto& [address, location] : request.locations) {
+            if (const auto account{db::read_account(txn, address)}; account) {
+                (void)db::read_storage(txn, address, account->incarnation, location);
+            }
+        }
+    }
+}
+
+}  // namespace silkworm::stagedsync
@@ -0,0 +1,98 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <silkworm/core/chain/config.hpp>
+#include <silkworm/core/execution/analysis_cache.hpp>
+#include <silkworm/core/types/block.hpp>
+#include <silkworm/node/db/mdbx.hpp>
+
+namespace silkworm::stagedsync {
+
+//! \brief Warms up the state touched by blocks about to be executed on a dedicated thread.
+//! \remarks Sender, recipient and beneficiary accounts, their code and the storage locations declared in access lists
+//! are read through a read-only transaction of its own, so that cold pages of PlainState and Code are faulted in while
+//! the consumer keeps executing previous blocks. Read values are discarded, as they may be outdated by changes not yet
+//! committed, except for code analyses: code is immutable hence its analysis is put into the shared analysis cache.
+//! Prefetching is best effort: requests are dropped when they can't be served in time.
+class StatePrefetcher {
+  public:
+    static constexpr size_t kDefaultCapacity{64};
+
+    //! \param [in] env : the database environment to open read-only transactions on
+    //! \param [in] config : the chain config, to tell the revision code is analyzed for
+    //! \param [in] analysis_cache : the cache to put code analyses into (if any)
+    //! \param [in] capacity : the max number of blocks waiting to be prefetched
+    StatePrefetcher(mdbx::env env, const ChainConfig& config, BaselineAnalysisCache* analysis_cache,
+                    size_t capacity = kDefaultCapacity);
+    ~StatePrefetcher();
+
+    // Not copyable nor movable
+    StatePrefetcher(const StatePrefetcher&) = delete;
+    StatePrefetcher& operator=(const StatePrefetcher&) = delete;
+
+    //! \brief Starts the thread serving the prefetch requests
+    void start();
+
+    //! \brief Requests the serving thread to stop and waits for it
+    void stop();
+
+    //! \brief Requests the state touched by block to be prefetched: never blocks (request is dropped if queue is full)
+    //! \return Whether the request has been queued
+    bool push(const Block& block);
+
+    //! \brief Signals the number of the block being executed: requests for lower blocks are dropped
+    void set_progress(BlockNum block_num) noexcept { progress_.store(block_num, std::memory_order_relaxed); }
+
+    //! \brief Returns the number of blocks waiting to be prefetched
+    [[nodiscard]] size_t size() const;
+
+  private:
+    struct Request {
+        BlockNum block_num{0};
+        evmc_revision revision{EVMC_FRONTIER};
+        std::vector<evmc::address> accounts;
+        std::vector<std::pair<evmc::address, evmc::bytes32>> locations;
+    };
+
+    void run();
+
+    //! \brief Reads the state touched by the requests within a new read-only transaction
+    void prefetch(const std::vector<Request>& requests);
+
+    mdbx::env env_;
+    const ChainConfig& config_;
+    BaselineAnalysisCache* analysis_cache_;
+    const size_t capacity_;
+
+    std::thread worker_;
+    mutable std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::deque<Request> queue_;
+    std::atomic<BlockNum> progress_{0};
+    bool stopping_{false};
+};
+
+}  // namespace silkworm::stagedsync
@@ -0,0 +1,96 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "state_prefetcher.hpp"
+
+#include <chrono>
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/core/common/cast.hpp>
+#include <silkworm/core/common/util.hpp>
+#include <silkworm/node/common/test_context.hpp>
+#include <silkworm/node/db/buffer.hpp>
+
+namespace silkworm::stagedsync {
+
+using namespace std::chrono_literals;
+
+TEST_CASE("StatePrefetcher") {
+    test::Context context;
+    db::RWTxn& txn{context.rw_txn()};
+    const ChainConfig& config{*context.node_settings().chain_config};
+
+    const auto contract{0x71562b71999873db5b286df957af199ec94617f7_address};
+    const Bytes code{*from_hex("0x600035600055")};
+    const auto code_hash{bit_cast<evmc_bytes32>(keccak256(code))};
+
+    db::Buffer buffer{txn, 0};
+    buffer.begin_block(1);
+    Account account{};
+    account.code_hash = code_hash;
+    account.incarnation = kDefaultIncarnation;
+    buffer.update_account(contract, std::nullopt, account);
+    buffer.update_account_code(contract, kDefaultIncarnation, code_hash, code);
+    buffer.write_to_db();
+    context.commit_and_renew_txn();
+
+    Block block;
+    block.header.number = 2;
+    block.transactions.resize(1);
+    block.transactions[0].to = contract;
+    block.transactions[0].from = 0xb685342b8c54347aad148e1f22eff3eb3eb29391_address;
+    block.transactions[0].access_list = {{contract, {0x01_bytes32}}};
+
+    SECTION("code of touched contracts is analyzed ahead") {
+        BaselineAnalysisCache analysis_cache;
+        StatePrefetcher prefetcher{txn->env(), config, &analysis_cache};
+        prefetcher.start();
+        REQUIRE(prefetcher.push(block));
+
+        const auto deadline{std::chrono::steady_clock::now() + 10s};
+        while (!analysis_cache.get(code_hash) && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(1ms);
+        }
+        CHECK(analysis_cache.size() == 1);
+        CHECK_NOTHROW(prefetcher.stop());
+    }
+
+    SECTION("requests exceeding capacity are dropped") {
+        StatePrefetcher prefetcher{txn->env(), config, /*analysis_cache=*/nullptr, /*capacity=*/2};
+        CHECK(prefetcher.push(block));
+        CHECK(prefetcher.push(block));
+        CHECK_FALSE(prefetcher.push(block));
+        CHECK(prefetcher.size() == 2);
+    }
+
+    SECTION("blocks already executed are skipped") {
+        BaselineAnalysisCache analysis_cache;
+        StatePrefetcher prefetcher{txn->env(), config, &analysis_cache};
+        prefetcher.set_progress(block.header.number + 1);
+        REQUIRE(prefetcher.push(block));
+        prefetcher.start();
+
+        const auto deadline{std::chrono::steady_clock::now() + 10s};
+        while (prefetcher.size() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(1ms);
+        }
+        prefetcher.stop();
+        CHECK(analysis_cache.size() == 0);
+    }
+}
+
+}  // namespace silkworm::stagedsync
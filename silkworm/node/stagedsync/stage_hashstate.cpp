@@ -16,10 +16,12 @@
 
 #include "stage_hashstate.hpp"
 
+#include <atomic>
 #include <stdexcept>
 
 #include <silkworm/core/common/endian.hpp>
 #include <silkworm/node/common/decoding_exception.hpp>
+#include <silkworm/node/concurrency/thread_pool.hpp>
 #include <silkworm/node/db/access_layer.hpp>
 
 namespace silkworm::stagedsync {
@@ -66,11 +68,14 @@ Stage::Result HashState::forward(db::RWTxn& txn) {
             txn->clear_map(db::table::kHashedCodeHash.name);
             txn.commit();
 
-            success_or_throw(hash_from_plainstate(txn));
+            // Source tables are not written by this stage, so workers can read them if they were committed before
+            const bool parallel{db::is_committed(*txn)};
+
+            success_or_throw(hash_from_plainstate(txn, parallel));
             collector_->clear();
             reset_log_progress();
 
-            success_or_throw(hash_from_plaincode(txn));
+            success_or_throw(hash_from_plaincode(txn, parallel));
             collector_->clear();
             reset_log_progress();
 
@@ -169,12 +174,9 @@ Stage::Result HashState::prune(db::RWTxn&) {
     return Stage::Result::kSuccess;
 }
 
-Stage::Result HashState::hash_from_plainstate(db::RWTxn& txn) {
+Stage::Result HashState::hash_from_plainstate(db::RWTxn& txn, bool parallel) {
     Stage::Result ret{Stage::Result::kSuccess};
     try {
-        db::PooledCursor source(txn, db::table::kPlainState);
-        auto data{source.to_first(/*throw_notfound=*/true)};
-
         /*
          * This relies on the assumption previous execution stage has completed correctly,
          * and we do nothing more than hashing keys already present in PlainState either
@@ -182,91 +184,12 @@ Stage::Result HashState::hash_from_plainstate(db::RWTxn& txn) {
          * limit as PlainState holds info up to the highest executed block.
          */
 
-        evmc::address last_address{};
-        ethash_hash256 address_hash{keccak256(last_address.bytes)};  // We might have all zeroed addresses ?
-
         std::unique_lock log_lck(log_mtx_);
         current_source_ = std::string(db::table::kPlainState.name);
-        current_key_ = to_hex(last_address.bytes, /*with_prefix=*/true);
+        current_key_ = to_hex(evmc::address{}.bytes, /*with_prefix=*/true);
         log_lck.unlock();
 
-        // New Hashed Storage Entry Key (72 bytes)
-        // + Address hash  (32 bytes)
-        // + Incarnation   ( 8 bytes)
-        // + Location hash (32 bytes)
-        Bytes etl_storage_entry_key(72, '\0');
-
-        // Hash accounts
-        while (data) {
-            auto data_key_view{db::from_slice(data.key)};
-
-            // We're reading PlainState which keys are ordered by address (always initial 20 bytes of key)
-            // Rehash the address only when changes
-            if (std::memcmp(data_key_view.data(), last_address.bytes, kAddressLength) != 0) {
-                throw_if_stopping();
-                last_address = to_evmc_address(data_key_view);
-                address_hash = keccak256(last_address.bytes);
-                log_lck.lock();
-                current_key_ = to_hex(last_address.bytes, /*with_prefix=*/true);
-                log_lck.unlock();
-            }
-
-            if (data.key.length() == kAddressLength) {
-                // Hash account
-                // data.key == Address
-                // data.value == Account encoded for storage (must exist)
-                if (!data.value.length()) {
-                    const std::string what("Unexpected empty value in PlainState for Account " + current_key_);
-                    throw StageError(Stage::Result::kUnexpectedError, what);
-                }
-
-                etl::Entry entry{Bytes(address_hash.bytes, kHashLength), Bytes{db::from_slice(data.value)}};
-                collector_->collect(std::move(entry));
-
-            } else if (data.key.length() == db::kPlainStoragePrefixLength) {
-                // Hash storage
-                // data.key           == Address + Incarnation
-                // data.value (multi) == Location + zeroless Value
-
-                // See above for allocation
-                std::memcpy(&etl_storage_entry_key[0], address_hash.bytes, kHashLength);
-                std::memcpy(&etl_storage_entry_key[kHashLength], &data_key_view[kAddressLength],
-                            db::kIncarnationLength);
-
-                // Iterate dupkeys only to avoid re-hashing of same address
-                while (data) {
-                    if (!(data.value.length() > kHashLength)) {
-                        const auto incarnation{endian::load_big_u64(&data_key_view[kAddressLength])};
-                        const std::string what("Unexpected empty value in PlainState for Account " + current_key_ +
-                                               " incarnation " + std::to_string(incarnation));
-                        throw StageError(Stage::Result::kUnexpectedError, what);
-                    }
-
-                    /*
-                     * NOTE !
-                     * Destination table kHashedStorage is dup-sorted but as Collector implements sorting only on entry
-                     * key here we have to build the entry key as hashed address + incarnation + hashed storage location
-                     * eventually leaving entry value to only hashed storage value. This ensures entries are collected
-                     * and sorted properly and eventually the loader will move back hashed storage location in the value
-                     * part of the db record. This way we can reliably insert records using MDBX_APPENDDUP
-                     */
-
-                    auto data_value_view{db::from_slice(data.value)};
-                    std::memcpy(&etl_storage_entry_key[kHashLength + db::kIncarnationLength],
-                                keccak256(data_value_view.substr(0, kHashLength)).bytes, kHashLength);
-                    data_value_view.remove_prefix(kHashLength);
-                    etl::Entry entry{etl_storage_entry_key, Bytes{data_value_view}};
-                    collector_->collect(std::move(entry));
-                    data = source.to_current_next_multi(false);
-                }
-
-            } else {
-                std::string what{"Unexpected key length " + std::to_string(data.key.length())};
-                throw StageError(Stage::Result::kUnexpectedError, what);
-            }
-
-            data = source.to_next(/*throw_notfound=*/false);
-        }
+        hash_partitions(txn, db::table::kPlainState, &HashState::hash_plainstate_partition, parallel);
 
         throw_if_stopping();
 
@@ -308,6 +231,7 @@ Stage::Result HashState::hash_from_plainstate(db::RWTxn& txn) {
                 std::string(db::table::kHashedAccounts.name) + "+" + std::string(db::table::kHashedStorage.name);
             loading_ = true;
             log_lck.unlock();
+            collector_->set_merge_partitions(etl::kLargeLoadMergePartitions);
             collector_->load(account_target, load_func, MDBX_put_flags_t::MDBX_APPENDDUP);
         }
 
@@ -332,47 +256,15 @@ Stage::Result HashState::hash_from_plainstate(db::RWTxn& txn) {
     return ret;
 }
 
-Stage::Result HashState::hash_from_plaincode(db::RWTxn& txn) {
+Stage::Result HashState::hash_from_plaincode(db::RWTxn& txn, bool parallel) {
     Stage::Result ret{Stage::Result::kSuccess};
     try {
-        db::PooledCursor source(txn, db::table::kPlainCodeHash);
-        auto data{source.to_first(/*throw_notfound=*/false)};
-
-        evmc::address last_address{};
-        Bytes new_key(db::kHashedStoragePrefixLength, '\0');
-
         std::unique_lock log_lck(log_mtx_);
         current_source_ = std::string(db::table::kPlainCodeHash.name);
-        current_key_ = to_hex(last_address.bytes, /*with_prefix=*/true);
+        current_key_ = to_hex(evmc::address{}.bytes, /*with_prefix=*/true);
         log_lck.unlock();
 
-        while (data) {
-            if (data.key.length() != kAddressLength + db::kIncarnationLength) {
-                std::string what{"Unexpected key len " + std::to_string(data.key.length())};
-                throw StageError(Stage::Result::kUnexpectedError, what);
-            }
-
-            auto data_key_view{db::from_slice(data.key)};
-
-            // We're reading PlainCodeHash which keys are ordered by address (always initial 20 bytes of key)
-            // Rehash the address only when changes
-            if (std::memcmp(data_key_view.data(), last_address.bytes, kAddressLength) != 0) {
-                throw_if_stopping();
-                last_address = to_evmc_address(data_key_view);
-                log_lck.lock();
-                current_key_ = to_hex(last_address.bytes, /*with_prefix=*/true);
-                log_lck.unlock();
-
-                const auto address_hash{keccak256(last_address.bytes)};
-                std::memcpy(&new_key[0], address_hash.bytes, kHashLength);
-            }
-
-            std::memcpy(&new_key[kHashLength], &data_key_view[kAddressLength], db::kIncarnationLength);
-
-            etl::Entry entry{new_key, Bytes{db::from_slice(data.value)}};
-            collector_->collect(std::move(entry));
-            data = source.to_next(/*throw_notfound=*/false);
-        }
+        hash_partitions(txn, db::table::kPlainCodeHash, &HashState::hash_plaincode_partition, parallel);
 
         throw_if_stopping();
 
@@ -385,6 +277,7 @@ Stage::Result HashState::hash_from_plaincode(db::RWTxn& txn) {
             current_target_ = std::string(db::table::kHashedCodeHash.name);
             loading_ = true;
             log_lck.unlock();
+            collector_->set_merge_partitions(etl::kLargeLoadMergePartitions);
             collector_->load(target, nullptr, MDBX_put_flags_t::MDBX_APPEND);
         }
 
@@ -409,6 +302,185 @@ Stage::Result HashState::hash_from_plaincode(db::RWTxn& txn) {
     return ret;
 }
 
+void HashState::hash_partitions(db::RWTxn& txn, const db::MapConfig& source_config, PartitionHasher hasher,
+                                bool parallel) {
+    static constexpr size_t kPartitions{256};  // One per first byte of address
+
+    if (!parallel) {
+        db::PooledCursor source(txn, source_config);
+        for (size_t partition{0}; partition < kPartitions; ++partition) {
+            (this->*hasher)(source, static_cast<uint8_t>(partition), *collector_);
+        }
+        return;
+    }
+
+    // Workers pick partitions in turn so that larger ones (e.g. big contracts) don't hold back the others
+    mdbx::env env{txn->env()};
+    std::atomic_size_t next_partition{0};
+    std::vector<std::unique_ptr<etl::Collector>> collectors;
+    // Declared last so that workers are joined before anything they use is destroyed
+    thread_pool worker_pool{db::max_parallel_readers(env)};
+    const size_t workers{static_cast<size_t>(worker_pool.get_thread_count())};
+
+    std::vector<std::future<bool>> results;
+    for (size_t i{0}; i < workers; ++i) {
+        collectors.push_back(std::make_unique<etl::Collector>(node_settings_->data_directory->etl().path(),
+                                                              node_settings_->etl_buffer_size / workers));
+        results.push_back(worker_pool.submit([&, collector = collectors.back().get()]() {
+            try {
+                db::ROTxn ro_txn{env};
+                db::PooledCursor source(*ro_txn, source_config);
+                for (size_t partition{next_partition++}; partition < kPartitions; partition = next_partition++) {
+                    (this->*hasher)(source, static_cast<uint8_t>(partition), *collector);
+                }
+            } catch (...) {
+                next_partition = kPartitions;  // Stops other workers at their next partition
+                throw;
+            }
+        }));
+    }
+
+    for (auto& result : results) {
+        result.get();
+    }
+    for (auto& collector : collectors) {
+        collector_->absorb(*collector);
+    }
+}
+
+void HashState::hash_plainstate_partition(db::PooledCursor& source, uint8_t address_first_byte,
+                                          etl::Collector& collector) {
+    const Bytes start_key(1, address_first_byte);
+    auto data{source.lower_bound(db::to_slice(start_key), /*throw_notfound=*/false)};
+
+    evmc::address last_address{};
+    ethash_hash256 address_hash{keccak256(last_address.bytes)};  // We might have all zeroed addresses ?
+
+    // New Hashed Storage Entry Key (72 bytes)
+    // + Address hash  (32 bytes)
+    // + Incarnation   ( 8 bytes)
+    // + Location hash (32 bytes)
+    Bytes etl_storage_entry_key(72, '\0');
+
+    // Hash accounts
+    while (data) {
+        auto data_key_view{db::from_slice(data.key)};
+        if (data_key_view[0] != address_first_byte) {
+            break;
+        }
+
+        // We're reading PlainState which keys are ordered by address (always initial 20 bytes of key)
+        // Rehash the address only when changes
+        if (std::memcmp(data_key_view.data(), last_address.bytes, kAddressLength) != 0) {
+            throw_if_stopping();
+            last_address = to_evmc_address(data_key_view);
+            address_hash = keccak256(last_address.bytes);
+            std::unique_lock log_lck(log_mtx_);
+            current_key_ = to_hex(last_address.bytes, /*with_prefix=*/true);
+        }
+
+        if (data.key.length() == kAddressLength) {
+            // Hash account
+            // data.key == Address
+            // data.value == Account encoded for storage (must exist)
+            if (!data.value.length()) {
+                const std::string what("Unexpected empty value in PlainState for Account " +
+                                       to_hex(last_address.bytes, /*with_prefix=*/true));
+                throw StageError(Stage::Result::kUnexpectedError, what);
+            }
+
+            etl::Entry entry{Bytes(address_hash.bytes, kHashLength), Bytes{db::from_slice(data.value)}};
+            collector.collect(std::move(entry));
+
+        } else if (data.key.length() == db::kPlainStoragePrefixLength) {
+            // Hash storage
+            // data.key           == Address + Incarnation
+            // data.value (multi) == Location + zeroless Value
+
+            // See above for allocation
+            std::memcpy(&etl_storage_entry_key[0], address_hash.bytes, kHashLength);
+            std::memcpy(&etl_storage_entry_key[kHashLength], &data_key_view[kAddressLength],
+                        db::kIncarnationLength);
+
+            // Iterate dupkeys only to avoid re-hashing of same address
+            while (data) {
+                if (!(data.value.length() > kHashLength)) {
+                    const auto incarnation{endian::load_big_u64(&data_key_view[kAddressLength])};
+                    const std::string what("Unexpected empty value in PlainState for Account " +
+                                           to_hex(last_address.bytes, /*with_prefix=*/true) +
+                                           " incarnation " + std::to_string(incarnation));
+                    throw StageError(Stage::Result::kUnexpectedError, what);
+                }
+
+                /*
+                 * NOTE !
+                 * Destination table kHashedStorage is dup-sorted but as Collector implements sorting only on entry
+                 * key here we have to build the entry key as hashed address + incarnation + hashed storage location
+                 * eventually leaving entry value to only hashed storage value. This ensures entries are collected
+                 * and sorted properly and eventually the loader will move back hashed storage location in the value
+                 * part of the db record. This way we can reliably insert records using MDBX_APPENDDUP
+                 */
+
+                auto data_value_view{db::from_slice(data.value)};
+                std::memcpy(&etl_storage_entry_key[kHashLength + db::kIncarnationLength],
+                            keccak256(data_value_view.substr(0, kHashLength)).bytes, kHashLength);
+                data_value_view.remove_prefix(kHashLength);
+                etl::Entry entry{etl_storage_entry_key, Bytes{data_value_view}};
+                collector.collect(std::move(entry));
+                data = source.to_current_next_multi(false);
+            }
+
+        } else {
+            std::string what{"Unexpected key length " + std::to_string(data.key.length())};
+            throw StageError(Stage::Result::kUnexpectedError, what);
+        }
+
+        data = source.to_next(/*throw_notfound=*/false);
+    }
+}
+
+void HashState::hash_plaincode_partition(db::PooledCursor& source, uint8_t address_first_byte,
+                                         etl::Collector& collector) {
+    const Bytes start_key(1, address_first_byte);
+    auto data{source.lower_bound(db::to_slice(start_key), /*throw_notfound=*/false)};
+
+    evmc::address last_address{};
+    Bytes new_key(db::kHashedStoragePrefixLength, '\0');
+    std::memcpy(&new_key[0], keccak256(last_address.bytes).bytes, kHashLength);
+
+    while (data) {
+        if (data.key.length() != kAddressLength + db::kIncarnationLength) {
+            std::string what{"Unexpected key len " + std::to_string(data.key.length())};
+            throw StageError(Stage::Result::kUnexpectedError, what);
+        }
+
+        auto data_key_view{db::from_slice(data.key)};
+        if (data_key_view[0] != address_first_byte) {
+            break;
+        }
+
+        // We're reading PlainCodeHash which keys are ordered by address (always initial 20 bytes of key)
+        // Rehash the address only when changes
+        if (std::memcmp(data_key_view.data(), last_address.bytes, kAddressLength) != 0) {
+            throw_if_stopping();
+            last_address = to_evmc_address(data_key_view);
+            {
+                std::unique_lock log_lck(log_mtx_);
+                current_key_ = to_hex(last_address.bytes, /*with_prefix=*/true);
+            }
+
+            const auto address_hash{keccak256(last_address.bytes)};
+            std::memcpy(&new_key[0], address_hash.bytes, kHashLength);
+        }
+
+        std::memcpy(&new_key[kHashLength], &data_key_view[kAddressLength], db::kIncarnationLength);
+
+        etl::Entry entry{new_key, Bytes{db::from_slice(data.value)}};
+        collector.collect(std::move(entry));
+        data = source.to_next(/*throw_notfound=*/false);
+    }
+}
+
 Stage::Result HashState::hash_from_account_changeset(db::RWTxn& txn, BlockNum previous_progress, BlockNum to) {
     Stage::Result ret{Stage::Result::kSuccess};
     try {
@@ -39,11 +39,29 @@ class HashState final : public Stage {
     //! \brief Transforms PlainState into HashedAccounts and HashedStorage respectively in one single read pass over
     //! PlainState \remarks To be used only if this is very first time HashState stage runs forward (i.e. forwarding
     //! from 0)
-    Stage::Result hash_from_plainstate(db::RWTxn& txn);
+    //! \param [in] parallel : whether PlainState is committed, hence can be read by workers
+    Stage::Result hash_from_plainstate(db::RWTxn& txn, bool parallel);
 
     //! \brief Transforms PlainCodeHash into HashedCodeHash in one single read pass over PlainCodeHash
     //! \remarks To be used only if this is very first time HashState stage runs forward (i.e. forwarding from 0)
-    Stage::Result hash_from_plaincode(db::RWTxn& txn);
+    //! \param [in] parallel : whether PlainCodeHash is committed, hence can be read by workers
+    Stage::Result hash_from_plaincode(db::RWTxn& txn, bool parallel);
+
+    //! \brief Hashes the records of a source table whose address starts with given byte into collector
+    using PartitionHasher = void (HashState::*)(db::PooledCursor& source, uint8_t address_first_byte,
+                                                etl::Collector& collector);
+
+    //! \brief Runs hasher over the partitions of source table, one per first byte of address, into collector_
+    //! \remarks If parallel, partitions are processed by a pool of workers, each with its own read-only transaction
+    //! and collector which is eventually absorbed by collector_. Read-only transactions only see committed data, so
+    //! the source table must have been committed before the stage started writing.
+    void hash_partitions(db::RWTxn& txn, const db::MapConfig& source_config, PartitionHasher hasher, bool parallel);
+
+    //! \brief Hashes the accounts and storage of a PlainState partition
+    void hash_plainstate_partition(db::PooledCursor& source, uint8_t address_first_byte, etl::Collector& collector);
+
+    //! \brief Hashes the code hashes of a PlainCodeHash partition
+    void hash_plaincode_partition(db::PooledCursor& source, uint8_t address_first_byte, etl::Collector& collector);
 
     //! \brief Detects account changes from AccountChangeSet and hashes the changed keys
     //! \remarks Though it could be used for initial sync only is way slower and builds an index of changed accounts.
@@ -0,0 +1,95 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "stage_hashstate.hpp"
+
+#include <array>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/core/common/cast.hpp>
+#include <silkworm/core/common/util.hpp>
+#include <silkworm/node/common/test_context.hpp>
+#include <silkworm/node/db/buffer.hpp>
+#include <silkworm/node/db/stages.hpp>
+#include <silkworm/node/test/log.hpp>
+
+namespace silkworm {
+
+using TableContents = std::vector<std::pair<Bytes, Bytes>>;
+
+static TableContents read_table(db::ROTxn& txn, const db::MapConfig& config) {
+    TableContents contents;
+    auto cursor{db::open_cursor(txn, config)};
+    db::cursor_for_each(cursor, [&contents](ByteView key, ByteView value) { contents.emplace_back(key, value); });
+    return contents;
+}
+
+TEST_CASE("HashState regeneration in parallel matches sequential one") {
+    test::SetLogVerbosityGuard log_guard{log::Level::kNone};
+
+    const auto regenerate{[](bool parallel) {
+        test::Context context;
+        context.add_genesis_data();
+        db::RWTxn& txn{context.rw_txn()};
+
+        // Contracts spread over the address space, each one with code and some storage
+        db::Buffer buffer{txn, 0};
+        const Bytes code{*from_hex("600035600055")};
+        const auto code_hash{bit_cast<evmc_bytes32>(keccak256(code))};
+        for (uint8_t i{0}; i < 200; ++i) {
+            evmc::address contract{};
+            contract.bytes[0] = static_cast<uint8_t>(i * 37);
+            contract.bytes[kAddressLength - 1] = i;
+            const Account account{.balance = i, .code_hash = code_hash, .incarnation = 1};
+            buffer.update_account(contract, std::nullopt, account);
+            buffer.update_account_code(contract, account.incarnation, account.code_hash, code);
+            for (uint8_t j{1}; j <= 3; ++j) {
+                buffer.update_storage(contract, account.incarnation, to_bytes32(Bytes(1, j)), {},
+                                      to_bytes32(Bytes(1, static_cast<uint8_t>(i + j))));
+            }
+        }
+        buffer.write_to_db();
+        db::stages::write_stage_progress(txn, db::stages::kExecutionKey, 1);
+
+        // Workers read source tables through read-only transactions only when they are committed
+        if (parallel) {
+            txn.commit();
+        } else {
+            txn.disable_commit();
+        }
+
+        stagedsync::SyncContext sync_context{};
+        stagedsync::HashState stage{&context.node_settings(), &sync_context};
+        REQUIRE(stage.forward(txn) == stagedsync::Stage::Result::kSuccess);
+
+        return std::array{read_table(txn, db::table::kHashedAccounts), read_table(txn, db::table::kHashedStorage),
+                          read_table(txn, db::table::kHashedCodeHash)};
+    }};
+
+    const auto sequential{regenerate(/*parallel=*/false)};
+    const auto parallel{regenerate(/*parallel=*/true)};
+    for (const auto& contents : sequential) {
+        CHECK(!contents.empty());
+    }
+    CHECK(parallel[0] == sequential[0]);
+    CHECK(parallel[1] == sequential[1]);
+    CHECK(parallel[2] == sequential[2]);
+}
+
+}  // namespace silkworm
@@ -16,8 +16,12 @@
 
 #include "stage_history_index.hpp"
 
+#include <deque>
+#include <future>
+
 #include <silkworm/core/common/cast.hpp>
 #include <silkworm/core/common/endian.hpp>
+#include <silkworm/node/concurrency/thread_pool.hpp>
 
 namespace silkworm::stagedsync {
 
@@ -248,7 +252,11 @@ Stage::Result HistoryIndex::forward_impl(db::RWTxn& txn, const BlockNum from, co
     log_lck.unlock();
 
     // Into etl
-    collect_bitmaps_from_changeset(txn, source_config, from, to, storage);
+    if (storage) {
+        collect_bitmaps_from_changeset<kAddressLength + kHashLength>(txn, source_config, from, to);
+    } else {
+        collect_bitmaps_from_changeset<kAddressLength>(txn, source_config, from, to);
+    }
 
     if (!collector_->empty()) {
         log_lck.lock();
@@ -329,19 +337,48 @@ Stage::Result HistoryIndex::prune_impl(db::RWTxn& txn, const BlockNum threshold,
     return Stage::Result::kSuccess;
 }
 
+template <size_t KeySize>
 void HistoryIndex::collect_bitmaps_from_changeset(db::RWTxn& txn, const db::MapConfig& source_config,
-                                                  const BlockNum from, const BlockNum to, bool storage) {
+                                                  const BlockNum from, const BlockNum to) {
     using namespace std::chrono_literals;
     auto log_time{std::chrono::steady_clock::now()};
 
-    absl::btree_map<Bytes, roaring::Roaring64Map> bitmaps;
-    auto bitmaps_it{bitmaps.begin()};
-    Bytes bitmaps_key{};
+    constexpr bool storage{KeySize != kAddressLength};
+    using Shard = db::bitmap::KeyedBlockNums<KeySize>;
+
+    db::bitmap::KeyedBitmaps<KeySize> bitmaps;
     size_t bitmaps_size{0};   // To account flushing threshold
     uint16_t flush_count{0};  // To account number of flushings
 
+    // Shards being built by workers, in order of block numbers
+    thread_pool worker_pool;
+    const size_t max_pending_shards{2 * static_cast<size_t>(worker_pool.get_thread_count())};
+    std::deque<std::future<db::bitmap::KeyedBitmaps<KeySize>>> pending_shards;
+    auto shard{std::make_shared<Shard>()};
+    shard->reserve(kShardSize);
+
+    const auto merge_shard{[&]() {
+        bitmaps_size += db::bitmap::merge(bitmaps, pending_shards.front().get());
+        pending_shards.pop_front();
+
+        // Flush bitmaps to etl if necessary
+        if (bitmaps_size >= node_settings_->batch_size) {
+            db::bitmap::IndexLoader::flush_bitmaps_to_etl(bitmaps, collector_.get(), flush_count++);
+            bitmaps_size = 0;
+        }
+    }};
+    const auto dispatch_shard{[&]() {
+        if (pending_shards.size() == max_pending_shards) {
+            merge_shard();
+        }
+        pending_shards.push_back(worker_pool.submit([shard]() { return db::bitmap::build(*shard); }));
+        shard = std::make_shared<Shard>();
+        shard->reserve(kShardSize);
+    }};
+
     const BlockNum max_block_number{to};
     BlockNum reached_block_number{0};
+    std::array<uint8_t, KeySize> bitmaps_key{};
 
     auto start_key{db::block_key(from + 1)};
     db::PooledCursor source(txn, source_config);
@@ -365,40 +402,36 @@ void HistoryIndex::collect_bitmaps_from_changeset(db::RWTxn& txn, const db::MapC
 
         while (source_data) {
             const auto source_data_value_view{db::from_slice(source_data.value)};
-            if (storage) {
+            if constexpr (storage) {
                 // Contract address + location
-                bitmaps_key.assign(source_data_key_view.substr(0, kAddressLength))
-                    .append(source_data_value_view.substr(0, kHashLength));
+                std::memcpy(bitmaps_key.data(), source_data_key_view.data(), kAddressLength);
+                std::memcpy(bitmaps_key.data() + kAddressLength, source_data_value_view.data(), kHashLength);
             } else {
                 // Only address for accounts
-                bitmaps_key.assign(source_data_value_view.substr(0, kAddressLength));
+                std::memcpy(bitmaps_key.data(), source_data_value_view.data(), kAddressLength);
             }
-
-            bitmaps_it = bitmaps.find(bitmaps_key);
-            if (bitmaps_it == bitmaps.end()) {
-                bitmaps_it = bitmaps.emplace(bitmaps_key, roaring::Roaring64Map()).first;
-                bitmaps_size += bitmaps_key.size();
-                bitmaps_size += sizeof(uint64_t);  // see Roaring64Map()::getSizeInBytes()
-            }
-            bitmaps_it->second.add(reached_block_number);
-            bitmaps_size += sizeof(uint32_t);  // All blocks <= UINT32_MAX
-                                               // Is there a chain exceeding that height ?
+            shard->emplace_back(bitmaps_key, reached_block_number);
 
             source_data = source.to_current_next_multi(false);
         }
 
-        // Flush bitmaps to etl if necessary
-        if (bitmaps_size >= node_settings_->batch_size) {
-            db::bitmap::IndexLoader::flush_bitmaps_to_etl(bitmaps, collector_.get(), flush_count++);
-            bitmaps_size = 0;
+        // Shards never split the changes of a block
+        if (shard->size() >= kShardSize) {
+            dispatch_shard();
         }
 
         source_data = source.to_next(false);
     }
 
-    if (bitmaps_size) {
+    if (!shard->empty()) {
+        dispatch_shard();
+    }
+    while (!pending_shards.empty()) {
+        merge_shard();
+    }
+
+    if (!bitmaps.empty()) {
         db::bitmap::IndexLoader::flush_bitmaps_to_etl(bitmaps, collector_.get(), flush_count++);
-        bitmaps_size = 0;
     }
 }
 
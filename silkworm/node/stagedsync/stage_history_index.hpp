@@ -45,10 +45,13 @@ class HistoryIndex : public Stage {
     Stage::Result unwind_impl(db::RWTxn& txn, BlockNum from, BlockNum to, bool storage);
     Stage::Result prune_impl(db::RWTxn& txn, BlockNum threshold, BlockNum to, bool storage);
 
-    //! \brief Collects bitmaps of block numbers changes for each account within provided
+    static constexpr size_t kShardSize{1u << 16};  // Number of changes each worker builds bitmaps of
+
+    //! \brief Collects bitmaps of block numbers changes for each account (or storage location) within provided
     //! changeset boundaries
-    void collect_bitmaps_from_changeset(db::RWTxn& txn, const db::MapConfig& source_config, BlockNum from, BlockNum to,
-                                        bool storage);
+    //! \remarks Changes are read in shards of consecutive blocks whose bitmaps are built by workers and merged in order
+    template <size_t KeySize>
+    void collect_bitmaps_from_changeset(db::RWTxn& txn, const db::MapConfig& source_config, BlockNum from, BlockNum to);
 
     //! \brief Collects unique keys touched by changesets within provided boundaries
     std::map<Bytes, bool> collect_unique_keys_from_changeset(
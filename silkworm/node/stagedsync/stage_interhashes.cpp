@@ -68,8 +68,8 @@ Stage::Result InterHashes::forward(db::RWTxn& txn) {
             throw std::runtime_error("Could not find hash for canonical header " +
                                      std::to_string(hashstate_stage_progress));
         }
-        auto header{db::read_header(txn, hashstate_stage_progress, header_hash->bytes)};
-        if (!header_hash.has_value()) {
+        auto header{db::DataModel{txn}.read_header(hashstate_stage_progress, *header_hash)};
+        if (!header.has_value()) {
             throw std::runtime_error("Could not find canonical header number " +
                                      std::to_string(hashstate_stage_progress) +
                                      " hash " + to_hex(header_hash->bytes, true));
@@ -144,15 +144,14 @@ Stage::Result InterHashes::unwind(db::RWTxn& txn) {
                        "span", std::to_string(segment_width)});
         }
 
-        // Retrieve header's state_root at target block to be compared with the one computed here
         // Retrieve header's state_root at target block to be compared with the one computed here
         auto header_hash{db::read_canonical_header_hash(txn, to)};
         if (!header_hash.has_value()) {
             throw std::runtime_error("Could not find hash for canonical header " +
                                      std::to_string(to));
         }
-        auto header{db::read_header(txn, to, header_hash->bytes)};
-        if (!header_hash.has_value()) {
+        auto header{db::DataModel{txn}.read_header(to, *header_hash)};
+        if (!header.has_value()) {
             throw std::runtime_error("Could not find canonical header number " +
                                      std::to_string(to) +
                                      " hash " + to_hex(header_hash->bytes, true));
@@ -336,13 +336,17 @@ static Bytes nibbles_from_hex(std::string_view s) {
     return unpacked;
 }
 
-static evmc::bytes32 increment_intermediate_hashes(mdbx::txn& txn, std::filesystem::path etl_path,
-                                                   PrefixSet* account_changes, PrefixSet* storage_changes) {
+static evmc::bytes32 increment_intermediate_hashes(
+    mdbx::txn& txn, std::filesystem::path etl_path, PrefixSet* account_changes, PrefixSet* storage_changes,
+    size_t min_accounts_for_parallel_root = TrieLoader::kMinAccountsForParallelRoot,
+    size_t storage_roots_window = TrieLoader::kStorageRootsWindow) {
     etl::Collector account_trie_node_collector{etl_path};
     etl::Collector storage_trie_node_collector{etl_path};
 
     TrieLoader trie_loader(txn, account_changes, storage_changes, &account_trie_node_collector,
                            &storage_trie_node_collector);
+    trie_loader.set_min_accounts_for_parallel_root(min_accounts_for_parallel_root);
+    trie_loader.set_storage_roots_window(storage_roots_window);
 
     auto computed_root{trie_loader.calculate_root()};
 
@@ -358,8 +362,12 @@ static evmc::bytes32 increment_intermediate_hashes(mdbx::txn& txn, std::filesyst
     return computed_root;
 }
 
-static evmc::bytes32 regenerate_intermediate_hashes(mdbx::txn& txn, std::filesystem::path etl_path) {
-    return increment_intermediate_hashes(txn, etl_path, nullptr, nullptr);
+static evmc::bytes32 regenerate_intermediate_hashes(
+    mdbx::txn& txn, std::filesystem::path etl_path,
+    size_t min_accounts_for_parallel_root = TrieLoader::kMinAccountsForParallelRoot,
+    size_t storage_roots_window = TrieLoader::kStorageRootsWindow) {
+    return increment_intermediate_hashes(txn, etl_path, nullptr, nullptr, min_accounts_for_parallel_root,
+                                         storage_roots_window);
 }
 
 TEST_CASE("Account and storage trie") {
@@ -869,4 +877,126 @@ TEST_CASE("Trie Storage : incremental vs regeneration") {
     REQUIRE(fused_nodes == incremental_nodes);
 }
 
+TEST_CASE("Trie Accounts : parallel vs sequential regeneration") {
+    test::Context context;
+    auto& txn{context.txn()};
+
+    static constexpr size_t n{10'000};
+
+    // Accounts holding 1 ETH and a contract with some storage
+    {
+        auto hashed_accounts{db::open_cursor(txn, db::table::kHashedAccounts)};
+        static constexpr Account one_eth{0, 1 * kEther};
+        for (size_t i{0}; i < n; ++i) {
+            const evmc::address address{int_to_address(i)};
+            const auto hash{keccak256(address)};
+            hashed_accounts.upsert(db::to_slice(hash.bytes), db::to_slice(one_eth.encode_for_storage()));
+        }
+
+        const auto hash{keccak256(int_to_address(n))};
+        const auto code_hash{0x5be74cad16203c4905c068b012a2e9fb6d19d036c410f16fd177f337541440dd_bytes32};
+        const Account contract{0, 2 * kEther, code_hash, kDefaultIncarnation};
+        hashed_accounts.upsert(db::to_slice(hash.bytes), db::to_slice(contract.encode_for_storage()));
+        (void)setup_storage(txn, db::storage_prefix(hash.bytes, kDefaultIncarnation));
+    }
+
+    auto read_trie_nodes{[&txn](const db::MapConfig& map) {
+        auto cursor{db::open_cursor(txn, map)};
+        return read_all_nodes(cursor);
+    }};
+
+    // Sub-tries are built through other transactions: uncommitted data is not visible to them
+    context.commit_and_renew_txn();
+    const auto sequential_root{regenerate_intermediate_hashes(txn, context.dir().etl().path())};
+    const std::map<Bytes, Node> sequential_account_nodes{read_trie_nodes(db::table::kTrieOfAccounts)};
+    const std::map<Bytes, Node> sequential_storage_nodes{read_trie_nodes(db::table::kTrieOfStorage)};
+    REQUIRE(sequential_account_nodes.size() > 1);
+
+    txn.clear_map(db::open_map(txn, db::table::kTrieOfAccounts));
+    txn.clear_map(db::open_map(txn, db::table::kTrieOfStorage));
+    context.commit_and_renew_txn();
+    const auto parallel_root{regenerate_intermediate_hashes(txn, context.dir().etl().path(),
+                                                            /*min_accounts_for_parallel_root=*/0)};
+    const std::map<Bytes, Node> parallel_account_nodes{read_trie_nodes(db::table::kTrieOfAccounts)};
+    const std::map<Bytes, Node> parallel_storage_nodes{read_trie_nodes(db::table::kTrieOfStorage)};
+
+    REQUIRE(to_hex(parallel_root.bytes, true) == to_hex(sequential_root.bytes, true));
+    REQUIRE(parallel_account_nodes == sequential_account_nodes);
+    REQUIRE(parallel_storage_nodes == sequential_storage_nodes);
+}
+
+TEST_CASE("Trie Storage : parallel vs sequential storage roots") {
+    test::Context context;
+    auto& txn{context.txn()};
+
+    static constexpr size_t kContracts{32};
+    static constexpr size_t kLocations{300};
+    static const auto code_hash{0x5e3c5ae99a1c6785210d0d233641562557ad763e18907cca3a8d42bd0a0b4ecb_bytes32};
+    static const Account contract{0, 1 * kEther, code_hash, kDefaultIncarnation};
+    static const Account eoa{0, 1 * kEther};
+
+    const auto storage_prefix{[](size_t i) {
+        return db::storage_prefix(keccak256(int_to_address(i)).bytes, kDefaultIncarnation);
+    }};
+    const auto upsert_storage{[&](size_t i, size_t j, ByteView value) {
+        auto hashed_storage{db::open_cursor(txn, db::table::kHashedStorage)};
+        db::upsert_storage_value(hashed_storage, storage_prefix(i), keccak256(int_to_bytes32(j)).bytes, value);
+    }};
+    const auto read_storage_nodes{[&txn]() {
+        auto storage_trie{db::open_cursor(txn, db::table::kTrieOfStorage)};
+        return read_all_nodes(storage_trie);
+    }};
+
+    // Contracts with storage interleaved with externally owned accounts
+    {
+        auto hashed_accounts{db::open_cursor(txn, db::table::kHashedAccounts)};
+        for (size_t i{0}; i < 2 * kContracts; ++i) {
+            const Account& account{i % 2 ? eoa : contract};
+            hashed_accounts.upsert(db::to_slice(keccak256(int_to_address(i)).bytes),
+                                   db::to_slice(account.encode_for_storage()));
+        }
+    }
+    static const Bytes value_x{*from_hex("42")};
+    for (size_t i{0}; i < 2 * kContracts; i += 2) {
+        for (size_t j{0}; j < kLocations; ++j) {
+            upsert_storage(i, j, value_x);
+        }
+    }
+
+    // Storage roots are calculated in parallel only when data is visible to other transactions
+    context.commit_and_renew_txn();
+    (void)regenerate_intermediate_hashes(txn, context.dir().etl().path());
+    context.commit_and_renew_txn();
+
+    // Change, delete and add some storage of each contract
+    PrefixSet account_changes;
+    PrefixSet storage_changes;
+    static const Bytes value_y{*from_hex("71f602b294119bf452f1923814f5c6de768221254d3056b1bd63e72dc3142a29")};
+    for (size_t i{0}; i < 2 * kContracts; i += 2) {
+        const Bytes prefix{storage_prefix(i)};
+        for (size_t j{0}; j < kLocations + 50; j += 3) {
+            const bool created{j >= kLocations};
+            upsert_storage(i, j, j % 2 && !created ? ByteView{} : ByteView{value_y});
+            storage_changes.insert(Bytes{prefix + unpack_nibbles(keccak256(int_to_bytes32(j)).bytes)}, created);
+        }
+        account_changes.insert(unpack_nibbles(keccak256(int_to_address(i)).bytes));
+    }
+    context.commit_and_renew_txn();
+
+    const auto incremental_root{
+        increment_intermediate_hashes(txn, context.dir().etl().path(), &account_changes, &storage_changes)};
+    const std::map<Bytes, Node> incremental_nodes{read_storage_nodes()};
+
+    txn.clear_map(db::open_map(txn, db::table::kTrieOfAccounts));
+    txn.clear_map(db::open_map(txn, db::table::kTrieOfStorage));
+    const auto fused_root{regenerate_intermediate_hashes(txn, context.dir().etl().path(),
+                                                         TrieLoader::kMinAccountsForParallelRoot,
+                                                         /*storage_roots_window=*/0)};
+    const std::map<Bytes, Node> fused_nodes{read_storage_nodes()};
+
+    REQUIRE(!fused_nodes.empty());
+    REQUIRE(to_hex(fused_root.bytes, true) == to_hex(incremental_root.bytes, true));
+    REQUIRE(fused_nodes == incremental_nodes);
+}
+
 }  // namespace silkworm::trie
@@ -70,8 +70,9 @@ void SubNode::parse(ByteView k, ByteView v) {
     deleted = false;
 }
 
-TrieCursor::TrieCursor(mdbx::cursor& db_cursor, PrefixSet* changed, etl::Collector* collector)
-    : db_cursor_(db_cursor), changed_list_{changed}, collector_{collector} {
+TrieCursor::TrieCursor(mdbx::cursor& db_cursor, PrefixSet* changed, etl::Collector* collector,
+                       std::mutex* collector_mtx)
+    : db_cursor_(db_cursor), changed_list_{changed}, collector_{collector}, collector_mtx_{collector_mtx} {
     curr_key_.reserve(64);
     prev_key_.reserve(64);
     prefix_.reserve(64);
@@ -241,6 +242,10 @@ bool TrieCursor::db_seek(ByteView seek_key) {
 void TrieCursor::db_delete(SubNode& node) {
     if (!node.deleted && collector_) {
         buffer_.assign(prefix_).append(node.key);
+        std::unique_lock<std::mutex> lock;
+        if (collector_mtx_) {
+            lock = std::unique_lock{*collector_mtx_};
+        }
         collector_->collect({buffer_, Bytes{}});
         node.deleted = true;
     }
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include <silkworm/core/trie/node.hpp>
 #include <silkworm/core/trie/prefix_set.hpp>
 #include <silkworm/node/db/mdbx.hpp>
@@ -71,7 +73,10 @@ class SubNode : public Node {
 
 class TrieCursor {
   public:
-    explicit TrieCursor(mdbx::cursor& db_cursor, PrefixSet* changed, etl::Collector* collector = nullptr);
+    //! \param [in] collector_mtx : when provided serializes collection of deletions into a collector shared with
+    //! other threads
+    explicit TrieCursor(mdbx::cursor& db_cursor, PrefixSet* changed, etl::Collector* collector = nullptr,
+                        std::mutex* collector_mtx = nullptr);
 
     // Not copyable nor movable
     TrieCursor(const TrieCursor&) = delete;
@@ -106,6 +111,7 @@ class TrieCursor {
     PrefixSet* changed_list_;    // The collection of changed nibbled keys
     ByteView next_created_{};    // The next created account/location in changed list
     etl::Collector* collector_;  // Pointer to a collector for deletion of obsolete keys
+    std::mutex* collector_mtx_;  // Guards collector_ when shared (if any)
 
     bool db_seek(ByteView seek_key);  // Seeks lowerbound of provided key using db_cursor_
     void db_delete(SubNode& node);    // Collects deletion of node being rebuilt or no longer needed
@@ -16,16 +16,99 @@
 
 #include "trie_loader.hpp"
 
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <future>
 #include <stdexcept>
+#include <thread>
 
 #include <silkworm/core/trie/nibbles.hpp>
 #include <silkworm/core/types/account.hpp>
 #include <silkworm/node/common/decoding_exception.hpp>
 #include <silkworm/node/concurrency/signal_handler.hpp>
+#include <silkworm/node/concurrency/thread_pool.hpp>
 #include <silkworm/node/db/tables.hpp>
 
 namespace silkworm::trie {
 
+class TrieLoader::StorageRootWorkers {
+  public:
+    StorageRootWorkers(mdbx::env env, etl::Collector* collector)
+        : env_{std::move(env)}, collector_{collector}, workers_{db::max_parallel_readers(env_)} {}
+
+    // Not copyable nor movable
+    StorageRootWorkers(const StorageRootWorkers&) = delete;
+    StorageRootWorkers& operator=(const StorageRootWorkers&) = delete;
+
+    //! \brief Schedules the calculation of the storage root of the contract identified by storage_prefix
+    //! \param [in] storage_changes : the changed storage locations of all contracts (nullptr on full regeneration).
+    //! Must be provided in increasing order of storage_prefix
+    std::future<evmc::bytes32> submit(Bytes storage_prefix, PrefixSet* storage_changes) {
+        // Each job owns the changes of its contract as PrefixSet lookups are not thread safe
+        std::shared_ptr<PrefixSet> changes;
+        if (storage_changes) {
+            changes = std::make_shared<PrefixSet>(storage_changes->subset(storage_prefix));
+        }
+        return workers_.submit([this, storage_prefix = std::move(storage_prefix), changes]() {
+            return calculate(storage_prefix, changes.get());
+        });
+    }
+
+  private:
+    //! \brief Read-only transaction and builders reused by subsequent jobs
+    struct Context {
+        explicit Context(mdbx::env& env)
+            : txn{env},
+              hashed_storage{txn, db::table::kHashedStorage},
+              trie_storage{txn, db::table::kTrieOfStorage} {}
+
+        db::ROTxn txn;
+        db::PooledCursor hashed_storage;
+        db::PooledCursor trie_storage;
+        HashBuilder hash_builder;
+    };
+
+    evmc::bytes32 calculate(const Bytes& storage_prefix, PrefixSet* changes) {
+        std::unique_ptr<Context> context{acquire_context()};
+        context->hash_builder.node_collector = [&](ByteView nibbled_key, const trie::Node& node) {
+            Bytes key{storage_prefix};
+            key.append(nibbled_key);
+            Bytes value{node.state_mask() ? node.encode_for_storage() : Bytes{}};  // Node with no state should be deleted
+            std::unique_lock lock{collector_mtx_};
+            collector_->collect({key, value});
+        };
+
+        TrieCursor trie_storage_cursor(context->trie_storage, changes, collector_, &collector_mtx_);
+        const auto storage_root{calculate_storage_root(trie_storage_cursor, context->hash_builder,
+                                                       context->hashed_storage, storage_prefix)};
+
+        context->hash_builder.node_collector = nullptr;  // Refers to locals
+        std::unique_lock lock{contexts_mtx_};
+        contexts_.push_back(std::move(context));
+        return storage_root;
+    }
+
+    std::unique_ptr<Context> acquire_context() {
+        std::unique_lock lock{contexts_mtx_};
+        if (contexts_.empty()) {
+            return std::make_unique<Context>(env_);
+        }
+        std::unique_ptr<Context> context{std::move(contexts_.back())};
+        contexts_.pop_back();
+        return context;
+    }
+
+    mdbx::env env_;
+    etl::Collector* collector_;
+    std::mutex collector_mtx_;                        // Serializes collection from workers
+    std::vector<std::unique_ptr<Context>> contexts_;  // Idle contexts
+    std::mutex contexts_mtx_;
+    // Declared last so pending jobs are completed before anything else is destroyed
+    // Each worker keeps its own read-only transaction, hence they are capped to leave reader slots free
+    thread_pool workers_;
+};
+
 TrieLoader::TrieLoader(mdbx::txn& txn, PrefixSet* account_changes, PrefixSet* storage_changes,
                        etl::Collector* account_trie_node_collector, etl::Collector* storage_trie_node_collector)
     : txn_{txn},
@@ -58,6 +141,9 @@ evmc::bytes32 TrieLoader::calculate_root() {
                                     std::string(db::table::kTrieOfAccounts.name) + " or " +
                                     std::string(db::table::kTrieOfStorage.name) + " aren't empty");
         }
+        if (const auto nibbles{parallel_subtries(hashed_accounts)}; !nibbles.empty()) {
+            return calculate_root_in_parallel(nibbles);
+        }
     }
 
     Bytes storage_prefix_buffer{};
@@ -81,6 +167,21 @@ evmc::bytes32 TrieLoader::calculate_root() {
     TrieCursor trie_account_cursor(trie_accounts, account_changes_, account_trie_node_collector_);
     TrieCursor trie_storage_cursor(trie_storage, storage_changes_, storage_trie_node_collector_);
 
+    // Storage roots are calculated in parallel by workers reading through their own transactions
+    std::unique_ptr<StorageRootWorkers> storage_root_workers;
+    if (storage_roots_window_ && db::is_committed(txn_)) {
+        storage_root_workers = std::make_unique<StorageRootWorkers>(txn_.env(), storage_trie_node_collector_);
+    }
+    std::deque<PendingAccount> pending_accounts;
+    auto add_pending_accounts{[&](size_t max_pending) {
+        while (pending_accounts.size() > max_pending) {
+            auto& pending{pending_accounts.front()};
+            const evmc::bytes32 storage_root{pending.storage_root.valid() ? pending.storage_root.get() : kEmptyRoot};
+            account_hash_builder.add_leaf(std::move(pending.nibbled_key), pending.account.rlp(storage_root));
+            pending_accounts.pop_front();
+        }
+    }};
+
     // Begin loop on accounts
     auto trie_account_data{trie_account_cursor.to_prefix({})};
     while (true) {
@@ -109,6 +210,19 @@ evmc::bytes32 TrieLoader::calculate_root() {
                 const auto account{Account::from_encoded_storage(db::from_slice(hashed_account_data.value))};
                 success_or_throw(account);
 
+                if (storage_root_workers) {
+                    // Walk ahead while storage roots are calculated: leaves are added in order when window is full
+                    auto& pending{pending_accounts.emplace_back(
+                        PendingAccount{std::move(hashed_account_data_key_nibbled), *account, {}})};
+                    if (account->incarnation) {
+                        pending.storage_root = storage_root_workers->submit(
+                            db::storage_prefix(hashed_account_data_key_view, account->incarnation), storage_changes_);
+                    }
+                    add_pending_accounts(storage_roots_window_ - 1);
+                    hashed_account_data = hashed_accounts.to_next(false);
+                    continue;
+                }
+
                 evmc::bytes32 storage_root{kEmptyRoot};
                 if (account->incarnation) {
                     // Calc storage root
@@ -120,6 +234,9 @@ evmc::bytes32 TrieLoader::calculate_root() {
                 account_hash_builder.add_leaf(hashed_account_data_key_nibbled, account->rlp(storage_root));
                 hashed_account_data = hashed_accounts.to_next(false);
             }
+
+            // Leaves must precede the next branch node
+            add_pending_accounts(0);
         }
 
         // Interrupt loop when no more keys to process
@@ -143,12 +260,143 @@ evmc::bytes32 TrieLoader::calculate_root() {
     return root_hash;
 }
 
+std::vector<uint8_t> TrieLoader::parallel_subtries(db::PooledCursor& hashed_accounts) const {
+    std::vector<uint8_t> nibbles;
+
+    // Workers read through their own transactions hence all changes to hashed state must have been committed
+    if (hashed_accounts.size() < min_accounts_for_parallel_root_ || !db::is_committed(txn_)) {
+        return nibbles;
+    }
+
+    auto hashed_account_data{hashed_accounts.to_first(false)};
+    while (hashed_account_data) {
+        const auto nibble{static_cast<uint8_t>(db::from_slice(hashed_account_data.key)[0] >> 4)};
+        nibbles.push_back(nibble);
+        if (nibble == 0xf) {
+            break;
+        }
+        const Bytes next_subtrie_key(1, static_cast<uint8_t>((nibble + 1) << 4));
+        hashed_account_data = hashed_accounts.lower_bound(db::to_slice(next_subtrie_key), false);
+    }
+
+    // Sub-tries can be stitched only as children of a branch node
+    if (nibbles.size() < 2) {
+        nibbles.clear();
+    }
+    return nibbles;
+}
+
+evmc::bytes32 TrieLoader::calculate_root_in_parallel(const std::vector<uint8_t>& nibbles) {
+    mdbx::env env{txn_.env()};
+    std::mutex collectors_mtx;  // Collectors are shared among workers
+    std::atomic_bool stopping{false};
+    std::array<HashBuilder, 16> subtries;
+    std::vector<std::future<bool>> results;
+    results.reserve(nibbles.size());
+    {
+        const auto thread_count{std::clamp<size_t>(std::thread::hardware_concurrency(), 1, nibbles.size())};
+        thread_pool workers{static_cast<uint32_t>(thread_count)};
+        for (const auto nibble : nibbles) {
+            results.push_back(workers.submit([&, nibble]() {
+                try {
+                    calculate_subtrie(env, nibble, subtries[nibble], collectors_mtx, stopping);
+                } catch (...) {
+                    stopping = true;  // No need for other workers to go on
+                    throw;
+                }
+            }));
+        }
+    }  // Waits for all workers to complete
+    for (auto& result : results) {
+        result.get();  // Rethrows the exception of failed worker (if any)
+    }
+
+    HashBuilder account_hash_builder;
+    account_hash_builder.node_collector = [&](ByteView nibbled_key, const trie::Node& node) {
+        Bytes value{node.state_mask() ? node.encode_for_storage() : Bytes{}};  // Node with no state should be deleted
+        account_trie_node_collector_->collect({Bytes{nibbled_key}, value});
+    };
+    for (const auto nibble : nibbles) {
+        account_hash_builder.add_subtrie(subtries[nibble]);
+    }
+
+    auto root_hash{account_hash_builder.root_hash()};
+    account_hash_builder.reset();
+    return root_hash;
+}
+
+void TrieLoader::calculate_subtrie(mdbx::env env, uint8_t nibble, HashBuilder& account_hash_builder,
+                                   std::mutex& collectors_mtx, const std::atomic_bool& stopping) {
+    using namespace std::chrono_literals;
+    auto log_time{std::chrono::steady_clock::now()};
+
+    db::ROTxn txn{env};
+    db::PooledCursor hashed_accounts(txn, db::table::kHashedAccounts);
+    db::PooledCursor hashed_storage(txn, db::table::kHashedStorage);
+    db::PooledCursor trie_storage(txn, db::table::kTrieOfStorage);
+
+    Bytes storage_prefix_buffer{};
+    storage_prefix_buffer.reserve(db::kHashedStoragePrefixLength);
+
+    account_hash_builder.node_collector = [&](ByteView nibbled_key, const trie::Node& node) {
+        Bytes value{node.state_mask() ? node.encode_for_storage() : Bytes{}};  // Node with no state should be deleted
+        std::unique_lock lock{collectors_mtx};
+        account_trie_node_collector_->collect({Bytes{nibbled_key}, value});
+    };
+
+    HashBuilder storage_hash_builder;
+    storage_hash_builder.node_collector = [&](ByteView nibbled_key, const trie::Node& node) {
+        Bytes key{storage_prefix_buffer};
+        key.append(nibbled_key);
+        Bytes value{node.state_mask() ? node.encode_for_storage() : Bytes{}};  // Node with no state should be deleted
+        std::unique_lock lock{collectors_mtx};
+        storage_trie_node_collector_->collect({key, value});
+    };
+
+    // Storage trie is empty on full regeneration: cursor has nothing to collect
+    TrieCursor trie_storage_cursor(trie_storage, nullptr, nullptr);
+
+    const Bytes subtrie_key(1, static_cast<uint8_t>(nibble << 4));
+    auto hashed_account_data{hashed_accounts.lower_bound(db::to_slice(subtrie_key), false)};
+    while (hashed_account_data && !stopping) {
+        const auto hashed_account_data_key_view{db::from_slice(hashed_account_data.key)};
+        if (hashed_account_data_key_view[0] >> 4 != nibble) {
+            break;
+        }
+
+        if (const auto now{std::chrono::steady_clock::now()}; log_time <= now) {
+            SignalHandler::throw_if_signalled();
+            std::unique_lock log_lck(log_mtx_);
+            log_key_ = to_hex(hashed_account_data_key_view, true);
+            log_time = now + 2s;
+        }
+
+        // Retrieve account data
+        const auto account{Account::from_encoded_storage(db::from_slice(hashed_account_data.value))};
+        success_or_throw(account);
+
+        evmc::bytes32 storage_root{kEmptyRoot};
+        if (account->incarnation) {
+            // Calc storage root
+            storage_prefix_buffer.assign(db::storage_prefix(hashed_account_data_key_view, account->incarnation));
+            storage_root = calculate_storage_root(trie_storage_cursor, storage_hash_builder, hashed_storage,
+                                                  storage_prefix_buffer);
+        }
+
+        account_hash_builder.add_leaf(unpack_nibbles(hashed_account_data_key_view), account->rlp(storage_root));
+        hashed_account_data = hashed_accounts.to_next(false);
+    }
+
+    account_hash_builder.finalize_subtrie();
+    account_hash_builder.node_collector = nullptr;  // Refers to locals
+}
+
 evmc::bytes32 TrieLoader::calculate_storage_root(TrieCursor& trie_storage_cursor, HashBuilder& storage_hash_builder,
                                                  db::PooledCursor& hashed_storage, const Bytes& db_storage_prefix) {
     using namespace std::chrono_literals;
     auto log_time{std::chrono::steady_clock::now()};
 
-    static Bytes rlp_buffer{};
+    thread_local Bytes rlp_buffer{};
 
     const auto db_storage_prefix_slice{db::to_slice(db_storage_prefix)};
     auto trie_storage_data{trie_storage_cursor.to_prefix(db_storage_prefix)};
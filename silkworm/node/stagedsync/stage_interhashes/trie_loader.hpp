@@ -16,8 +16,15 @@
 
 #pragma once
 
+#include <atomic>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include <silkworm/core/trie/hash_builder.hpp>
 #include <silkworm/core/trie/prefix_set.hpp>
+#include <silkworm/core/types/account.hpp>
 #include <silkworm/node/db/mdbx.hpp>
 #include <silkworm/node/etl/collector.hpp>
 #include <silkworm/node/stagedsync/stage_interhashes/trie_cursor.hpp>
@@ -26,6 +33,13 @@ namespace silkworm::trie {
 
 class TrieLoader {
   public:
+    //! \brief Minimum amount of hashed accounts for a full regeneration to build the sub-tries in parallel
+    static constexpr size_t kMinAccountsForParallelRoot{100'000};
+
+    //! \brief Maximum amount of accounts walked ahead of the one being added to the trie while their storage roots are
+    //! calculated in parallel
+    static constexpr size_t kStorageRootsWindow{1'024};
+
     explicit TrieLoader(mdbx::txn& txn, PrefixSet* account_changes, PrefixSet* storage_changes,
                         etl::Collector* account_trie_node_collector, etl::Collector* storage_trie_node_collector);
 
@@ -41,6 +55,13 @@ class TrieLoader {
         return log_key_;
     }
 
+    //! \brief Overrides kMinAccountsForParallelRoot
+    void set_min_accounts_for_parallel_root(size_t min_accounts) { min_accounts_for_parallel_root_ = min_accounts; }
+
+    //! \brief Overrides kStorageRootsWindow
+    //! \remarks A zero window disables parallel calculation of storage roots
+    void set_storage_roots_window(size_t window) { storage_roots_window_ = window; }
+
   private:
     mdbx::txn& txn_;
     PrefixSet* account_changes_;
@@ -50,6 +71,33 @@ class TrieLoader {
 
     std::string log_key_{};         // To export logging key
     mutable std::mutex log_mtx_{};  // Guards async logging
+    size_t min_accounts_for_parallel_root_{kMinAccountsForParallelRoot};
+    size_t storage_roots_window_{kStorageRootsWindow};
+
+    //! \brief Calculates storage roots on a pool of workers each one reading through its own transaction
+    class StorageRootWorkers;
+
+    //! \brief An account walked ahead waiting for its storage root to be added to the trie
+    struct PendingAccount {
+        Bytes nibbled_key;
+        Account account;
+        std::future<evmc::bytes32> storage_root;  // Not valid for accounts with no storage
+    };
+
+    //! \brief Returns the first nibbles of hashed accounts whose sub-tries can be built in parallel
+    //! \return An empty vector if root must be calculated sequentially
+    [[nodiscard]] std::vector<uint8_t> parallel_subtries(db::PooledCursor& hashed_accounts) const;
+
+    //! \brief Calculates root hash on full regeneration building the account sub-tries of each nibble on a separate
+    //! worker and stitching them together as children of root branch node
+    //! \remark May throw
+    [[nodiscard]] evmc::bytes32 calculate_root_in_parallel(const std::vector<uint8_t>& nibbles);
+
+    //! \brief Builds the sub-trie of accounts whose hashed key begins with nibble on behalf of a new read-only
+    //! transaction. Computed nodes are collected under collectors_mtx
+    //! \remark May throw
+    void calculate_subtrie(mdbx::env env, uint8_t nibble, HashBuilder& account_hash_builder, std::mutex& collectors_mtx,
+                           const std::atomic_bool& stopping);
 
     //! \brief (re)calculates storage root hash on behalf of collected hashed changes and existing data in
     //! TrieOfStorage bucket
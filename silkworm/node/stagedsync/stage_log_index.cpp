@@ -16,6 +16,11 @@
 
 #include "stage_log_index.hpp"
 
+#include <deque>
+#include <future>
+
+#include <silkworm/node/concurrency/thread_pool.hpp>
+
 namespace silkworm::stagedsync {
 
 Stage::Result LogIndex::forward(db::RWTxn& txn) {
@@ -296,48 +301,54 @@ void LogIndex::collect_bitmaps_from_logs(db::RWTxn& txn,
     using namespace std::chrono_literals;
     auto log_time{std::chrono::steady_clock::now()};
 
+    // Log records are referenced straight in db pages: nothing is written to db until all shards are merged
+    using Shard = std::vector<std::pair<BlockNum, ByteView>>;
+
     const BlockNum max_block_number{to};
     BlockNum reached_block_number{0};
 
-    absl::btree_map<Bytes, roaring::Roaring64Map> topics_bitmaps;
-    absl::btree_map<Bytes, roaring::Roaring64Map> addresses_bitmaps;
+    LogBitmaps bitmaps;
     size_t topics_bitmaps_size{0};
     size_t addresses_bitmaps_size{0};
     uint16_t topics_flush_count{0};
     uint16_t addresses_flush_count{0};
 
-    // The function we use to collect decoded data into bitmaps
-    cbor_function on_log_bytes{[&topics_bitmaps,
-                                &topics_bitmaps_size,
-                                &addresses_bitmaps,
-                                &addresses_bitmaps_size,
-                                &reached_block_number](unsigned char* data, int size) -> void {
-        // We need either a hash or an address
-        auto s{static_cast<size_t>(size)};
-        if (s != kHashLength && s != kAddressLength) return;
+    // Shards being built by workers, in order of block numbers
+    thread_pool worker_pool;
+    const size_t max_pending_shards{2 * static_cast<size_t>(worker_pool.get_thread_count())};
+    std::deque<std::future<LogBitmaps>> pending_shards;
+    auto shard{std::make_shared<Shard>()};
+    shard->reserve(kShardSize);
 
-        Bytes key(data, s);
-        if (key.size() == kHashLength) {
-            auto it{topics_bitmaps.find(key)};
-            if (it == topics_bitmaps.end()) {
-                it = topics_bitmaps.emplace(key, roaring::Roaring64Map()).first;
-                topics_bitmaps_size += key.size() + sizeof(BlockNum);
-            }
-            it->second.add(reached_block_number);
-            topics_bitmaps_size += sizeof(uint32_t);
-        } else {
-            auto it{addresses_bitmaps.find(key)};
-            if (it == addresses_bitmaps.end()) {
-                it = addresses_bitmaps.emplace(key, roaring::Roaring64Map()).first;
-                addresses_bitmaps_size += key.size() + sizeof(BlockNum);
-            }
-            it->second.add(reached_block_number);
-            addresses_bitmaps_size += sizeof(uint32_t);
+    const auto merge_shard{[&]() {
+        LogBitmaps shard_bitmaps{pending_shards.front().get()};
+        pending_shards.pop_front();
+        topics_bitmaps_size += db::bitmap::merge(bitmaps.topics, std::move(shard_bitmaps.topics));
+        addresses_bitmaps_size += db::bitmap::merge(bitmaps.addresses, std::move(shard_bitmaps.addresses));
+
+        // Flushes
+        if (topics_bitmaps_size > node_settings_->batch_size) {
+            db::bitmap::IndexLoader::flush_bitmaps_to_etl(bitmaps.topics,
+                                                          topics_collector_.get(),
+                                                          topics_flush_count++);
+            topics_bitmaps_size = 0;
         }
-    }};
 
-    // Listener to CBOR decoder
-    CborListener listener{on_log_bytes};
+        if (addresses_bitmaps_size > node_settings_->batch_size) {
+            db::bitmap::IndexLoader::flush_bitmaps_to_etl(bitmaps.addresses,
+                                                          addresses_collector_.get(),
+                                                          addresses_flush_count++);
+            addresses_bitmaps_size = 0;
+        }
+    }};
+    const auto dispatch_shard{[&]() {
+        if (pending_shards.size() == max_pending_shards) {
+            merge_shard();
+        }
+        pending_shards.push_back(worker_pool.submit([shard]() { return build_bitmaps_from_logs(*shard); }));
+        shard = std::make_shared<Shard>();
+        shard->reserve(kShardSize);
+    }};
 
     auto start_key{db::block_key(from + 1)};
     db::PooledCursor source(txn, source_config);
@@ -354,28 +365,62 @@ void LogIndex::collect_bitmaps_from_logs(db::RWTxn& txn,
             log_time = now + 5s;
         }
 
-        // Decode CBOR value content and distribute it to the 2 bitmaps
-        cbor::input input(source_data.value.data(), static_cast<int>(source_data.value.length()));
-        cbor::decoder decoder(input, listener);
-        decoder.run();
-
-        // Flushes
-        if (topics_bitmaps_size > node_settings_->batch_size) {
-            db::bitmap::IndexLoader::flush_bitmaps_to_etl(topics_bitmaps,
-                                                          topics_collector_.get(),
-                                                          topics_flush_count++);
-            topics_bitmaps_size = 0;
+        shard->emplace_back(reached_block_number, db::from_slice(source_data.value));
+        if (shard->size() >= kShardSize) {
+            dispatch_shard();
         }
 
-        if (addresses_bitmaps_size > node_settings_->batch_size) {
-            db::bitmap::IndexLoader::flush_bitmaps_to_etl(addresses_bitmaps,
-                                                          addresses_collector_.get(),
-                                                          addresses_flush_count++);
-            addresses_bitmaps_size = 0;
+        source_data = source.to_next(/*throw_notfound=*/false);
+    }
+
+    if (!shard->empty()) {
+        dispatch_shard();
+    }
+    while (!pending_shards.empty()) {
+        merge_shard();
+    }
+
+    if (!bitmaps.topics.empty()) {
+        db::bitmap::IndexLoader::flush_bitmaps_to_etl(bitmaps.topics, topics_collector_.get(), topics_flush_count++);
+    }
+    if (!bitmaps.addresses.empty()) {
+        db::bitmap::IndexLoader::flush_bitmaps_to_etl(bitmaps.addresses, addresses_collector_.get(),
+                                                      addresses_flush_count++);
+    }
+}
+
+LogIndex::LogBitmaps LogIndex::build_bitmaps_from_logs(const std::vector<std::pair<BlockNum, ByteView>>& logs) {
+    db::bitmap::KeyedBlockNums<kHashLength> topics;
+    db::bitmap::KeyedBlockNums<kAddressLength> addresses;
+    BlockNum block_number{0};
+
+    // The function we use to collect decoded data into bitmaps
+    cbor_function on_log_bytes{[&topics, &addresses, &block_number](unsigned char* data, int size) -> void {
+        // We need either a hash or an address
+        auto s{static_cast<size_t>(size)};
+        if (s == kHashLength) {
+            auto& [key, number]{topics.emplace_back()};
+            std::memcpy(key.data(), data, kHashLength);
+            number = block_number;
+        } else if (s == kAddressLength) {
+            auto& [key, number]{addresses.emplace_back()};
+            std::memcpy(key.data(), data, kAddressLength);
+            number = block_number;
         }
+    }};
 
-        source_data = source.to_next(/*throw_notfound=*/false);
+    // Listener to CBOR decoder
+    CborListener listener{on_log_bytes};
+
+    for (const auto& [number, value] : logs) {
+        block_number = number;
+        // Decode CBOR value content and distribute it to the 2 bitmaps
+        cbor::input input(const_cast<uint8_t*>(value.data()), static_cast<int>(value.length()));
+        cbor::decoder decoder(input, listener);
+        decoder.run();
     }
+
+    return {db::bitmap::build(topics), db::bitmap::build(addresses)};
 }
 
 void LogIndex::collect_unique_keys_from_logs(db::RWTxn& txn,
@@ -50,9 +50,22 @@ class LogIndex : public Stage {
     void unwind_impl(db::RWTxn& txn, BlockNum from, BlockNum to);
     void prune_impl(db::RWTxn& txn, BlockNum threshold, const db::MapConfig& target);
 
+    static constexpr size_t kShardSize{1u << 12};  // Number of log records each worker builds bitmaps of
+
+    //! \brief The bitmaps built out of a shard of log records
+    struct LogBitmaps {
+        db::bitmap::KeyedBitmaps<kHashLength> topics;
+        db::bitmap::KeyedBitmaps<kAddressLength> addresses;
+    };
+
     //! \brief Collects bitmaps of block numbers for each log entry
+    //! \remarks Log records are read in shards of consecutive blocks whose bitmaps are built by workers and merged in
+    //! order
     void collect_bitmaps_from_logs(db::RWTxn& txn, const db::MapConfig& source_config, BlockNum from, BlockNum to);
 
+    //! \brief Decodes a shard of CBOR encoded log records and builds the bitmaps of their topics and addresses
+    static LogBitmaps build_bitmaps_from_logs(const std::vector<std::pair<BlockNum, ByteView>>& logs);
+
     //! \brief Collects unique keys for log entries within provided boundaries
     void collect_unique_keys_from_logs(
         db::RWTxn& txn,
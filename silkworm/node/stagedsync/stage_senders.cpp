@@ -20,10 +20,11 @@
 #include <stdexcept>
 #include <thread>
 
-#include <gsl/util>
+#include <silkpre/ecdsa.h>
 #include <silkpre/secp256k1n.hpp>
 
 #include <silkworm/core/common/assert.hpp>
+#include <silkworm/node/common/secp256k1_context.hpp>
 #include <silkworm/node/common/stopwatch.hpp>
 #include <silkworm/node/db/access_layer.hpp>
 
@@ -32,10 +33,10 @@ namespace silkworm::stagedsync {
 Senders::Senders(NodeSettings* node_settings, SyncContext* sync_context)
     : Stage(sync_context, db::stages::kSendersKey, node_settings),
       max_batch_size_{node_settings->batch_size / std::thread::hardware_concurrency() / sizeof(AddressRecovery)},
-      batch_{std::make_shared<std::vector<AddressRecovery>>()},
+      batch_{std::make_shared<AddressRecoveryBatch>()},
       collector_{node_settings} {
     // Reserve space for max batch in advance
-    batch_->reserve(max_batch_size_);
+    batch_->recoveries.reserve(max_batch_size_);
 }
 
 Stage::Result Senders::forward(db::RWTxn& txn) {
@@ -255,11 +256,11 @@ Stage::Result Senders::parallel_recover(db::RWTxn& txn) {
         log::Info(log_prefix_, {"op", "parallel_recover",
                                 "num_threads", std::to_string(std::thread::hardware_concurrency()), "max_batch_size", std::to_string(max_batch_size_)});
 
-        secp256k1_context* context = secp256k1_context_create(SILKPRE_SECP256K1_CONTEXT_FLAGS);
-        if (!context) throw std::runtime_error("Could not create elliptic curve context");
-        auto _ = gsl::finally([&]() { if (context) std::free(context); });
-
         BlockNum from{previous_progress + 1u};
+        collected_senders_ = 0;
+        pending_batches_ = 0;
+        completed_batches_.clear();
+        recovery_error_ = nullptr;
 
         // Load canonical headers from db
         log::Trace(log_prefix_, {"op", "read canonical hashes", "from", std::to_string(from), "to", std::to_string(target_progress)});
@@ -312,15 +313,14 @@ Stage::Result Senders::parallel_recover(db::RWTxn& txn) {
             auto body_rlp{db::from_slice(body_data.value)};
             auto block_body{db::detail::decode_stored_block_body(body_rlp)};
             if (block_body.txn_count) {
-                std::vector<Transaction> transactions;
-                db::read_transactions(transactions_cursor, block_body.base_txn_id, block_body.txn_count, transactions);
-                total_collected_senders += transactions.size();
-                success_or_throw(add_to_batch(reached_block_num, std::move(transactions)));
+                total_collected_senders += block_body.txn_count;
+                success_or_throw(add_to_batch(reached_block_num, transactions_cursor, block_body.base_txn_id,
+                                              block_body.txn_count));
 
                 // Process batch in parallel if max size has been reached
-                if (batch_->size() >= max_batch_size_) {
-                    increment_total_collected_transactions(batch_->size());
-                    recover_batch(worker_pool, context, from);
+                if (batch_->recoveries.size() >= max_batch_size_) {
+                    increment_total_collected_transactions(batch_->recoveries.size());
+                    recover_batch(worker_pool, from);
                 }
             }
 
@@ -334,16 +334,14 @@ Stage::Result Senders::parallel_recover(db::RWTxn& txn) {
         }
 
         // Recover last incomplete batch [likely]
-        if (!batch_->empty()) {
-            increment_total_collected_transactions(batch_->size());
-            recover_batch(worker_pool, context, from);
+        if (!batch_->recoveries.empty()) {
+            increment_total_collected_transactions(batch_->recoveries.size());
+            recover_batch(worker_pool, from);
         }
 
         // Wait for all senders to be recovered and collected in ETL
-        while (collected_senders_ != total_collected_senders) {
-            collect_senders(from);
-            std::this_thread::sleep_for(std::chrono::seconds(1));
-        }
+        collect_senders(from, /*max_pending_batches=*/0);
+        SILKWORM_ASSERT(collected_senders_ == total_collected_senders);
 
         // Store all recovered senders into db
         log::Trace(log_prefix_, {"op", "store senders", "reached_block_num", std::to_string(reached_block_num)});
@@ -443,7 +441,8 @@ Stage::Result Senders::read_canonical_hashes(db::ROTxn& txn, BlockNum from, Bloc
     }
 }
 
-Stage::Result Senders::add_to_batch(BlockNum block_num, std::vector<Transaction>&& transactions) {
+Stage::Result Senders::add_to_batch(BlockNum block_num, mdbx::cursor& transactions, uint64_t base_txn_id,
+                                    uint64_t txn_count) {
     if (is_stopping()) {
         return Stage::Result::kAborted;
     }
@@ -455,8 +454,19 @@ Stage::Result Senders::add_to_batch(BlockNum block_num, std::vector<Transaction>
     const bool has_berlin{rev >= EVMC_BERLIN};
     const bool has_london{rev >= EVMC_LONDON};
 
+    // Signing payloads are taken straight from stored transactions, with no need to decode them fully
+    const auto key{db::block_key(base_txn_id)};
     uint32_t tx_id{0};
-    for (const auto& transaction : transactions) {
+    for (auto data{transactions.find(db::to_slice(key), /*throw_notfound=*/false)}; data.done && tx_id < txn_count;
+         data = transactions.to_next(/*throw_notfound=*/false)) {
+        AddressRecovery recovery;
+        recovery.block_num = block_num;
+        recovery.payload_offset = batch_->payloads.size();
+        TransactionSignature transaction;
+        success_or_throw(rlp::decode_transaction_signature(db::from_slice(data.value), transaction, batch_->payloads,
+                                                           rlp::Eip2718Wrapping::kString));
+        recovery.payload_length = batch_->payloads.size() - recovery.payload_offset;
+
         switch (transaction.type) {
             case Transaction::Type::kLegacy:
                 break;
@@ -492,52 +502,59 @@ Stage::Result Senders::add_to_batch(BlockNum block_num, std::vector<Transaction>
             }
         }
 
-        Bytes rlp{};
-        rlp::encode(rlp, transaction, /*for_signing=*/true, /*wrap_eip2718_into_string=*/false);
-
-        batch_->push_back(AddressRecovery{block_num, transaction.odd_y_parity});
-        intx::be::unsafe::store(batch_->back().tx_signature, transaction.r);
-        intx::be::unsafe::store(batch_->back().tx_signature + kHashLength, transaction.s);
-        batch_->back().rlp = std::move(rlp);
+        recovery.odd_y_parity = transaction.odd_y_parity;
+        intx::be::unsafe::store(recovery.tx_signature, transaction.r);
+        intx::be::unsafe::store(recovery.tx_signature + kHashLength, transaction.s);
+        batch_->recoveries.push_back(recovery);
 
         ++tx_id;
     }
+    if (tx_id != txn_count) {
+        throw StageError(Stage::Result::kBadChainSequence,
+                         "Missing transaction " + std::to_string(base_txn_id + tx_id) + " in block " +
+                             std::to_string(block_num));
+    }
     increment_total_processed_blocks();
 
     return is_stopping() ? Stage::Result::kAborted : Stage::Result::kSuccess;
 }
 
-void Senders::recover_batch(thread_pool& worker_pool, secp256k1_context* context, BlockNum from) {
+void Senders::recover_batch(thread_pool& worker_pool, BlockNum from) {
     // Launch parallel senders recovery
-    log::Trace(log_prefix_, {"op", "recover_batch", "first", std::to_string(batch_->cbegin()->block_num)});
+    log::Trace(log_prefix_, {"op", "recover_batch", "first", std::to_string(batch_->recoveries.front().block_num)});
 
     StopWatch sw;
     const auto start = sw.start();
 
-    // Wait until total unfinished tasks in worker pool falls below 2 * num workers
-    static const auto kMaxUnfinishedTasks{2 * worker_pool.get_thread_count()};
-    while (worker_pool.get_tasks_total() >= kMaxUnfinishedTasks) {
-        std::this_thread::sleep_for(std::chrono::seconds(1));
-    }
+    // Wait until unfinished batches fall below 2 * num workers, collecting the completed ones meanwhile
+    const std::size_t max_pending_batches{2 * static_cast<std::size_t>(worker_pool.get_thread_count())};
+    collect_senders(from, max_pending_batches - 1);
 
     // Swap the waiting batch w/ an empty one and submit a new recovery task to the worker pool
-    std::shared_ptr<std::vector<AddressRecovery>> ready_batch{std::make_shared<std::vector<AddressRecovery>>()};
-    ready_batch->reserve(max_batch_size_);
+    std::shared_ptr<AddressRecoveryBatch> ready_batch{std::make_shared<AddressRecoveryBatch>()};
+    ready_batch->recoveries.reserve(max_batch_size_);
+    ready_batch->payloads.reserve(batch_->payloads.size());  // Next batch likely needs as much room as this one
     ready_batch.swap(batch_);
-    auto batch_result = worker_pool.submit([=]() {
-        std::for_each(ready_batch->begin(), ready_batch->end(), [&](auto& package) {
-            const auto tx_hash{keccak256(package.rlp)};
-            const bool ok = silkpre_recover_address(package.tx_from.bytes, tx_hash.bytes, package.tx_signature, package.odd_y_parity, context);
-            if (!ok) {
-                throw std::runtime_error("Unable to recover from address in block " + std::to_string(package.block_num));
-            }
-        });
-        return ready_batch;
+    {
+        std::unique_lock lock{batches_mutex_};
+        ++pending_batches_;
+    }
+    worker_pool.push_task([this, ready_batch]() {
+        std::exception_ptr error;
+        try {
+            recover_senders(*ready_batch);
+        } catch (...) {
+            error = std::current_exception();
+        }
+        // Notify the completion instead of having the stage thread polling for it
+        std::unique_lock lock{batches_mutex_};
+        if (error) {
+            if (!recovery_error_) recovery_error_ = error;
+        } else {
+            completed_batches_.push_back(ready_batch);
+        }
+        batches_completed_.notify_one();
     });
-    results_.emplace_back(std::move(batch_result));
-
-    // Check completed batch of senders and collect them
-    collect_senders(from);
 
     const auto [end, _] = sw.lap();
     log::Trace(log_prefix_, {"op", "recover_batch", "elapsed", sw.format(end - start)});
@@ -545,18 +562,40 @@ void Senders::recover_batch(thread_pool& worker_pool, secp256k1_context* context
     if (is_stopping()) throw StageError(Stage::Result::kAborted);
 }
 
-void Senders::collect_senders(BlockNum from) {
-    std::erase_if(results_, [&](auto& future_completed_batch) {
-        if (future_completed_batch.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
-            auto completed_batch = future_completed_batch.get();
-            // Put recovered senders into ETL
+void Senders::recover_senders(AddressRecoveryBatch& batch) {
+    // Each worker thread owns its context, created once for the lifetime of the thread
+    thread_local SecP256K1Context context;
+    for (auto& package : batch.recoveries) {
+        const auto tx_hash{keccak256(batch.payload(package))};
+        const bool ok = silkpre_recover_address(package.tx_from.bytes, tx_hash.bytes, package.tx_signature,
+                                                package.odd_y_parity, context.raw());
+        if (!ok) {
+            throw std::runtime_error("Unable to recover from address in block " + std::to_string(package.block_num));
+        }
+    }
+}
+
+void Senders::collect_senders(BlockNum from, std::size_t max_pending_batches) {
+    std::unique_lock lock{batches_mutex_};
+    while (true) {
+        // Put recovered senders into ETL as soon as batches complete
+        while (!completed_batches_.empty()) {
+            auto completed_batch{std::move(completed_batches_.front())};
+            completed_batches_.pop_front();
+            --pending_batches_;
+            lock.unlock();
             collect_senders(from, completed_batch);
-            // Update count of collected senders
-            collected_senders_ += completed_batch->size();
-            return true;
+            collected_senders_ += completed_batch->recoveries.size();
+            lock.lock();
         }
-        return false;
-    });
+        if (recovery_error_) {
+            std::rethrow_exception(recovery_error_);
+        }
+        if (pending_batches_ <= max_pending_batches) {
+            break;
+        }
+        batches_completed_.wait(lock, [&]() { return !completed_batches_.empty() || recovery_error_; });
+    }
 }
 
 void Senders::collect_senders(BlockNum from, std::shared_ptr<AddressRecoveryBatch>& batch) {
@@ -566,7 +605,7 @@ void Senders::collect_senders(BlockNum from, std::shared_ptr<AddressRecoveryBatc
     BlockNum block_num{0};
     Bytes key;
     Bytes value;
-    for (const auto& package : *batch) {
+    for (const auto& package : batch->recoveries) {
         if (package.block_num != block_num) {
             if (!key.empty()) {
                 collector_.collect({key, value});
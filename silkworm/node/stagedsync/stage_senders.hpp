@@ -16,13 +16,14 @@
 
 #pragma once
 
-#include <future>
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <memory>
 #include <mutex>
 #include <vector>
 
 #include <evmc/evmc.h>
-#include <silkpre/ecdsa.h>
 
 #include <silkworm/core/common/base.hpp>
 #include <silkworm/node/concurrency/thread_pool.hpp>
@@ -37,10 +38,19 @@ struct AddressRecovery {
     bool odd_y_parity{false};    // Whether y parity is odd (https://eips.ethereum.org/EIPS/eip-155)
     uint8_t tx_signature[64]{};  // Signature of the transaction
     evmc::address tx_from;       // Recovered sender address
-    Bytes rlp;                   // RLP representation of the transaction
+    size_t payload_offset{0};    // Offset of the signing payload of the transaction in the batch arena
+    size_t payload_length{0};    // Length of the signing payload of the transaction
 };
 
-using AddressRecoveryBatch = std::vector<AddressRecovery>;
+//! \brief A batch of sender recoveries along with the arena holding the signing payloads of its transactions
+struct AddressRecoveryBatch {
+    std::vector<AddressRecovery> recoveries;
+    Bytes payloads;
+
+    [[nodiscard]] ByteView payload(const AddressRecovery& recovery) const {
+        return ByteView{payloads}.substr(recovery.payload_offset, recovery.payload_length);
+    }
+};
 
 class Senders final : public Stage {
   public:
@@ -56,10 +66,13 @@ class Senders final : public Stage {
     Stage::Result parallel_recover(db::RWTxn& txn);
 
     Stage::Result read_canonical_hashes(db::ROTxn& txn, BlockNum from, BlockNum to) noexcept;
-    Stage::Result add_to_batch(BlockNum block_num, std::vector<Transaction>&& transactions);
-    void recover_batch(thread_pool& worker_pool, secp256k1_context* context, BlockNum from);
-    void collect_senders(BlockNum from);
+    Stage::Result add_to_batch(BlockNum block_num, mdbx::cursor& transactions, uint64_t base_txn_id, uint64_t txn_count);
+    void recover_batch(thread_pool& worker_pool, BlockNum from);
+    void collect_senders(BlockNum from, std::size_t max_pending_batches);
     void collect_senders(BlockNum from, std::shared_ptr<AddressRecoveryBatch>& batch);
+
+    //! \brief Recovers the senders of a batch using the elliptic curve context of the calling thread
+    static void recover_senders(AddressRecoveryBatch& batch);
     void store_senders(db::RWTxn& txn);
 
     void increment_total_processed_blocks();
@@ -74,8 +87,18 @@ class Senders final : public Stage {
     //! The current recovery batch being created
     std::shared_ptr<AddressRecoveryBatch> batch_;
 
-    //! The sequence of completed batch futures
-    std::vector<std::future<std::shared_ptr<AddressRecoveryBatch>>> results_;
+    //! The batches submitted for recovery and not collected yet
+    std::size_t pending_batches_{0};
+
+    //! The batches recovered by workers waiting to be collected
+    std::deque<std::shared_ptr<AddressRecoveryBatch>> completed_batches_;
+
+    //! The first error occurred in recovery workers, if any
+    std::exception_ptr recovery_error_;
+
+    //! Protects the batches exchanged with recovery workers and signals their completion
+    std::mutex batches_mutex_;
+    std::condition_variable batches_completed_;
 
     //! The total count of collected senders
     uint64_t collected_senders_{0};
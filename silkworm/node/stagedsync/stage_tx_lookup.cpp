@@ -16,13 +16,18 @@
 
 #include "stage_tx_lookup.hpp"
 
+#include <deque>
 #include <stdexcept>
 
 #include <silkworm/core/common/endian.hpp>
+#include <silkworm/node/concurrency/thread_pool.hpp>
 #include <silkworm/node/db/access_layer.hpp>
 
 namespace silkworm::stagedsync {
 
+//! \brief Transactions rlp, along with their block number, hashed by a worker
+using TransactionShard = std::vector<std::pair<BlockNum, ByteView>>;
+
 Stage::Result TxLookup::forward(db::RWTxn& txn) {
     Stage::Result ret{Stage::Result::kSuccess};
     operation_ = OperationType::Forward;
@@ -219,7 +224,7 @@ void TxLookup::forward_impl(db::RWTxn& txn, const BlockNum from, const BlockNum
     std::unique_lock log_lck(sl_mutex_);
     operation_ = OperationType::Forward;
     loading_ = false;
-    collector_ = std::make_unique<etl::Collector>(node_settings_);
+    make_collector();
     current_source_ = std::string(db::table::kBlockBodies.name);
     current_target_.clear();
     current_key_.clear();
@@ -251,7 +256,7 @@ void TxLookup::unwind_impl(db::RWTxn& txn, BlockNum from, BlockNum to) {
     std::unique_lock log_lck(sl_mutex_);
     operation_ = OperationType::Unwind;
     loading_ = false;
-    collector_ = std::make_unique<etl::Collector>(node_settings_);
+    make_collector();
     current_source_ = std::string(db::table::kBlockBodies.name);
     current_target_.clear();
     current_key_.clear();
@@ -284,7 +289,7 @@ void TxLookup::prune_impl(db::RWTxn& txn, BlockNum from, BlockNum to) {
     std::unique_lock log_lck(sl_mutex_);
     operation_ = OperationType::Prune;
     loading_ = false;
-    collector_ = std::make_unique<etl::Collector>(node_settings_);
+    make_collector();
     current_source_ = std::string(source_config.name);
     current_target_.clear();
     current_key_.clear();
@@ -311,6 +316,28 @@ void TxLookup::prune_impl(db::RWTxn& txn, BlockNum from, BlockNum to) {
     log_lck.unlock();
 }
 
+//! \brief Hashes the transactions of a shard into etl entries mapping each hash to its block number
+//! \remarks An empty value is collected when the entries are meant for deletion
+static std::vector<etl::Entry> hash_transactions(const TransactionShard& shard, bool for_deletion) {
+    std::vector<etl::Entry> entries;
+    entries.reserve(shard.size());
+    for (const auto& [block_number, transaction_rlp] : shard) {
+        const auto transaction_hash{keccak256(transaction_rlp)};
+        auto& entry{entries.emplace_back()};
+        entry.key.assign(transaction_hash.bytes, kHashLength);
+        if (!for_deletion) {
+            const auto block_key{db::block_key(block_number)};
+            entry.value.assign(zeroless_view(block_key));
+        }
+    }
+    return entries;
+}
+
+void TxLookup::make_collector() {
+    collector_ = std::make_unique<etl::Collector>(node_settings_);
+    collector_->set_merge_partitions(etl::kLargeLoadMergePartitions);  // Hashes spread evenly over key ranges
+}
+
 void TxLookup::collect_transaction_hashes_from_canonical_bodies(db::RWTxn& txn,
                                                                 const BlockNum from, const BlockNum to,
                                                                 const bool for_deletion) {
@@ -321,8 +348,31 @@ void TxLookup::collect_transaction_hashes_from_canonical_bodies(db::RWTxn& txn,
     BlockNum expected_block_number{std::min(from, to) + 1};
     BlockNum reached_block_number{0};
 
+    // Shards being hashed by workers, in order of block numbers
+    // Transactions are passed as views on db pages which stay valid as nothing is written meanwhile
+    thread_pool worker_pool;
+    const size_t max_pending_shards{2 * static_cast<size_t>(worker_pool.get_thread_count())};
+    std::deque<std::future<std::vector<etl::Entry>>> pending_shards;
+    auto shard{std::make_shared<TransactionShard>()};
+    shard->reserve(kShardSize);
+
+    const auto collect_shard{[&]() {
+        for (auto& entry : pending_shards.front().get()) {
+            collector_->collect(std::move(entry));
+        }
+        pending_shards.pop_front();
+    }};
+    const auto dispatch_shard{[&]() {
+        if (pending_shards.size() == max_pending_shards) {
+            collect_shard();
+        }
+        pending_shards.push_back(
+            worker_pool.submit([shard, for_deletion]() { return hash_transactions(*shard, for_deletion); }));
+        shard = std::make_shared<TransactionShard>();
+        shard->reserve(kShardSize);
+    }};
+
     auto start_key{db::block_key(expected_block_number)};
-    Bytes etl_value{};
     db::PooledCursor canonicals(txn, db::table::kCanonicalHashes);
     db::PooledCursor bodies(txn, db::table::kBlockBodies);
     db::PooledCursor transactions{txn, db::table::kBlockTransactions};
@@ -357,17 +407,9 @@ void TxLookup::collect_transaction_hashes_from_canonical_bodies(db::RWTxn& txn,
             throw StageError(Stage::Result::kDbError,
                              "Could not load block body " + std::to_string(reached_block_number));
         }
-        auto body_data_key_view{db::from_slice(body_data.key)};
         auto body_data_value_view{db::from_slice(body_data.value)};
         const auto block_body{db::detail::decode_stored_block_body(body_data_value_view)};
         if (block_body.txn_count) {
-            // The same loop is used for forward and for unwind
-            // In the latter two records must be deleted hence we set etl_value only if deletion
-            // is not required
-            if (!for_deletion) {
-                etl_value.assign(zeroless_view(body_data_key_view.substr(0, sizeof(BlockNum))));
-            }
-
             size_t max_transaction_id{block_body.base_txn_id + block_body.txn_count - 1};
             size_t processed_transactions{0};
 
@@ -379,10 +421,8 @@ void TxLookup::collect_transaction_hashes_from_canonical_bodies(db::RWTxn& txn,
                     endian::load_big_u64(static_cast<uint8_t*>(transactions_data.key.data()))};
                 if (reached_transaction_id > max_transaction_id) break;
 
-                // Hash transaction rlp
-                auto transaction_data_value_view{db::from_slice(transactions_data.value)};
-                auto transaction_hash{keccak256(transaction_data_value_view)};
-                collector_->collect({Bytes(transaction_hash.bytes, kHashLength), etl_value});
+                // Transaction rlp is hashed by workers
+                shard->emplace_back(reached_block_number, db::from_slice(transactions_data.value));
 
                 ++processed_transactions;
                 transactions_data = transactions.to_next(/*throw_notfound=*/false);
@@ -395,11 +435,22 @@ void TxLookup::collect_transaction_hashes_from_canonical_bodies(db::RWTxn& txn,
                             "got", std::to_string(processed_transactions)});
                 throw std::runtime_error("Mismatching tx count");
             }
+
+            if (shard->size() >= kShardSize) {
+                dispatch_shard();
+            }
         }
 
         ++expected_block_number;
         canonical_data = canonicals.to_next(/*throw_notfound=*/false);
     }
+
+    if (!shard->empty()) {
+        dispatch_shard();
+    }
+    while (!pending_shards.empty()) {
+        collect_shard();
+    }
 }
 
 std::vector<std::string> TxLookup::get_log_progress() {
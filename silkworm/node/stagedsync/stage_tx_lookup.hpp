@@ -33,6 +33,8 @@ class TxLookup : public Stage {
     std::vector<std::string> get_log_progress() final;
 
   private:
+    static constexpr size_t kShardSize{1u << 12};  // Transactions hashed by each worker task
+
     std::unique_ptr<etl::Collector> collector_{nullptr};
 
     std::atomic_bool loading_{false};  // Whether we're in ETL loading phase
@@ -46,8 +48,12 @@ class TxLookup : public Stage {
 
     void reset_log_progress();  // Clears out all logging vars
 
+    //! \brief Walks canonical bodies in range and hashes their transactions on a pool of workers
     void collect_transaction_hashes_from_canonical_bodies(db::RWTxn& txn,
                                                           BlockNum from, BlockNum to,
                                                           bool for_deletion);
+
+    //! \brief Sets up an empty collector whose key ranges are merged in parallel on load
+    void make_collector();
 };
 }  // namespace silkworm::stagedsync
@@ -16,8 +16,12 @@
 
 #pragma once
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 #include <silkworm/core/common/endian.hpp>
 #include <silkworm/core/common/util.hpp>
@@ -170,6 +174,75 @@ class HelloWorldSnapshotFile : public TemporarySnapshotFile {
     };
 };
 
+//! Uncompressed snapshot file: it contains the given words as they are w/o any patterns
+//! @details Positions just encode the word lengths, so that any word takes one byte for its positions plus its data
+class UncompressedSnapshotFile : public TemporarySnapshotFile {
+  public:
+    UncompressedSnapshotFile(const std::filesystem::path& tmp_dir, const std::string& filename,
+                             const std::vector<Bytes>& words)
+        : TemporarySnapshotFile{tmp_dir, filename, make_header(words), make_body(words)} {}
+
+  private:
+    //! Word length and pattern terminator codes must fit in one byte
+    static constexpr uint64_t kMaxPositionDepth{4};
+
+    //! Position 0 terminates the (missing) patterns, any other position is one plus some word length
+    static std::vector<uint64_t> position_values(const std::vector<Bytes>& words) {
+        std::vector<uint64_t> values{0};
+        for (const auto& word : words) {
+            if (std::find(values.cbegin(), values.cend(), word.size() + 1) == values.cend()) {
+                values.push_back(word.size() + 1);
+            }
+        }
+        return values;
+    }
+
+    //! All positions have the same depth, i.e. the same code length
+    static uint64_t position_depth(std::size_t position_count) {
+        uint64_t depth{1};
+        while ((std::size_t{1} << depth) < position_count) {
+            ++depth;
+        }
+        if (depth > kMaxPositionDepth) {
+            throw std::logic_error{"too many distinct word lengths"};
+        }
+        return depth;
+    }
+
+    static SnapshotHeader make_header(const std::vector<Bytes>& words) {
+        const auto values = position_values(words);
+        const auto depth = position_depth(values.size());
+        std::vector<SnapshotPosition> positions;
+        for (const auto value : values) {
+            positions.push_back({depth, value});
+        }
+        return SnapshotHeader{
+            .words_count = words.size(),
+            .empty_words_count = static_cast<uint64_t>(
+                std::count_if(words.cbegin(), words.cend(), [](const Bytes& w) { return w.empty(); })),
+            .patterns = {},
+            .positions = std::move(positions)};
+    }
+
+    static SnapshotBody make_body(const std::vector<Bytes>& words) {
+        const auto values = position_values(words);
+        const auto depth = position_depth(values.size());
+        Bytes data;
+        for (const auto& word : words) {
+            // Codes are assigned in position order and read starting from the least significant bit
+            const auto index = static_cast<uint64_t>(std::find(values.cbegin(), values.cend(), word.size() + 1) - values.cbegin());
+            uint8_t code{0};
+            for (uint64_t bit{0}; bit < depth; ++bit) {
+                code = static_cast<uint8_t>(code | (((index >> (depth - 1 - bit)) & 1) << bit));
+            }
+            // Word length code is followed by the pattern terminator code, which is zero
+            data.push_back(code);
+            data.append(word);
+        }
+        return SnapshotBody{std::move(data)};
+    }
+};
+
 //! Sample Bodies snapshot file: it contains body for block 1'500'013 on mainnet
 class SampleBodySnapshotFile : public TemporarySnapshotFile {
   public: